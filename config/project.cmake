@@ -273,6 +273,12 @@ elseif(FLECSI_RUNTIME_MODEL STREQUAL "mpi")
 
   set(_runtime_path ${PROJECT_SOURCE_DIR}/flecsi/execution/mpi)
 
+  option(ENABLE_MPI_TASK_PROFILER
+    "Report per-task timings and ghost communication at exit" OFF)
+  if(ENABLE_MPI_TASK_PROFILER)
+    add_definitions(-DENABLE_MPI_TASK_PROFILER)
+  endif()
+
   if(NOT APPLE)
     set(FLECSI_RUNTIME_LIBRARIES  -ldl ${MPI_LIBRARIES})
   else()
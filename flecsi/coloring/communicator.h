@@ -65,6 +65,21 @@ public:
     const std::set<size_t> & request_indices
   ) = 0;
 
+  //--------------------------------------------------------------------------//
+  //! Same as get_primary_info, but route each request only to the color
+  //! that the given block distribution of the indices assigns to it.
+  //!
+  //! @param distribution The index ranges for each color.
+  //--------------------------------------------------------------------------//
+
+  virtual
+  std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
+  get_primary_info(
+    const std::set<size_t> & primary,
+    const std::set<size_t> & request_indices,
+    const std::vector<size_t> & distribution
+  ) = 0;
+
   ///
   /// Get the 1-to-1 intersection between all colorings of the given set.
   ///
@@ -15,9 +15,13 @@
   #error ENABLE_MPI not defined! This file depends on MPI!
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <mpi.h>
 
 #include "flecsi/coloring/crs.h"
+#include "flecsi/coloring/mpi_utils.h"
 #include "flecsi/topology/closure_utils.h"
 #include "flecsi/topology/mesh_definition.h"
 
@@ -148,6 +152,9 @@ make_dcrs(
   // Set the first offset (always zero).
   dcrs.offsets.push_back(0);
 
+  // Scratch storage for the neighbor search, reused for every index
+  std::vector<size_t> candidates;
+
   // Add the graph adjacencies by getting the neighbors of each
   // cell index
   for(size_t i(0); i<init_indices; ++i) {
@@ -156,35 +163,306 @@ make_dcrs(
     // a matching criteria of "md.dimension()" vertices. The dimension
     // argument will pick neighbors that are adjacent across facets, e.g.,
     // across edges in two dimension, or across faces in three dimensions.
-    auto neighbors = topology::entity_neighbors<
+    // The neighbors are appended to the indices in increasing order.
+    topology::entity_neighbors<
       FROM_DIMENSION,
       TO_DIMENSION,
       THRU_DIMENSION
     >
     (
       md, 
-      dcrs.distribution[rank] + i
+      dcrs.distribution[rank] + i,
+      dcrs.indices,
+      candidates
     );
 
-#if 0
-      if(rank == 1) {
-        std::cout << "neighbors: ";
-        for(auto i: neighbors) {
-          std::cout << i << " ";
-        } // for
-        std::cout << std::endl;
+    dcrs.offsets.push_back(dcrs.indices.size());
+  } // for
+
+  return dcrs;
+} // make_dcrs
+
+namespace detail {
+
+//----------------------------------------------------------------------------//
+//! Exchange variable-length lists of indices with every rank. The entries
+//! received from each rank are concatenated in rank order.
+//!
+//! @param send      The list of indices to send to each rank.
+//! @param recv_cnts The number of indices received from each rank.
+//----------------------------------------------------------------------------//
+
+inline
+std::vector<size_t>
+alltoallv(
+  const std::vector<std::vector<size_t>> & send,
+  std::vector<int> & recv_cnts
+)
+{
+  const int size = send.size();
+
+  std::vector<int> send_cnts(size);
+  std::vector<int> send_disps(size+1, 0);
+
+  for(int r(0); r<size; ++r) {
+    send_cnts[r] = send[r].size();
+    send_disps[r+1] = send_disps[r] + send_cnts[r];
+  } // for
+
+  std::vector<size_t> send_buffer;
+  send_buffer.reserve(send_disps[size]);
+
+  for(auto & v: send) {
+    send_buffer.insert(send_buffer.end(), v.begin(), v.end());
+  } // for
+
+  recv_cnts.resize(size);
+  std::vector<int> recv_disps(size+1, 0);
+
+  MPI_Alltoall(send_cnts.data(), 1, MPI_INT, recv_cnts.data(), 1, MPI_INT,
+    MPI_COMM_WORLD);
+
+  for(int r(0); r<size; ++r) {
+    recv_disps[r+1] = recv_disps[r] + recv_cnts[r];
+  } // for
+
+  std::vector<size_t> recv_buffer(recv_disps[size]);
+
+  MPI_Alltoallv(send_buffer.data(), send_cnts.data(), send_disps.data(),
+    mpi_typetraits__<size_t>::type(), recv_buffer.data(), recv_cnts.data(),
+    recv_disps.data(), mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
+
+  return recv_buffer;
+} // alltoallv
+
+} // namespace detail
+
+//----------------------------------------------------------------------------//
+//! Create distributed CRS representation of the cell graph of a mesh whose
+//! cells are already distributed, e.g., by distributed_exodus_definition__.
+//! Cells are neighbors when they share more than THRU_DIMENSION vertices.
+//!
+//! Each vertex is assigned a home rank, which collects the cells that
+//! reference it, and each rank then fetches the cells of the vertices that
+//! its cells reference. No rank ever holds more than its own part of the
+//! mesh and the cells around it.
+//!
+//! @tparam DIMENSION      The topological dimension of the cells.
+//! @tparam THRU_DIMENSION The topological dimension through which the
+//!                        neighbor connection exists.
+//! @tparam DEFINITION     The distributed definition type. It must provide
+//!                        num_entities(0) (the global number of vertices),
+//!                        num_local_entities(DIMENSION), offset() (the
+//!                        global id of the first local cell) and
+//!                        entities_crs(DIMENSION, 0) (the global vertex ids
+//!                        of the local cells).
+//!
+//! @param md The distributed mesh definition.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+template< 
+  std::size_t DIMENSION,
+  std::size_t THRU_DIMENSION = DIMENSION-1,
+  typename DEFINITION
+>
+inline
+dcrs_t
+make_distributed_dcrs(
+  const DEFINITION & md
+)
+{
+	int size;
+	int rank;
+
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const auto & cells = md.entities_crs(DIMENSION, 0);
+  const size_t num_cells = md.num_local_entities(DIMENSION);
+  const size_t offset = md.offset();
+  const size_t num_vertices = md.num_entities(0);
+
+  //--------------------------------------------------------------------------//
+  // Gather the distribution of the cells.
+  //--------------------------------------------------------------------------//
+
+	dcrs_t dcrs;
+  std::vector<size_t> counts(size);
+
+  MPI_Allgather(&num_cells, 1, mpi_typetraits__<size_t>::type(),
+    counts.data(), 1, mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
+
+	dcrs.distribution.push_back(0);
+
+	for(size_t r(0); r<size; ++r) {
+		dcrs.distribution.push_back(dcrs.distribution[r] + counts[r]);
+	} // for
+
+  clog_assert(dcrs.distribution[rank] == offset,
+    "cells must be distributed in rank order");
+
+  // The home rank of a vertex. Vertex ids are distributed in blocks.
+  auto home = [&](size_t v) -> size_t {
+    return v * size / num_vertices;
+  };
+
+  // The sorted global ids of the vertices of the local cells
+  std::vector<size_t> vertices(cells.indices);
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+    vertices.end());
+
+  //--------------------------------------------------------------------------//
+  // Send each (vertex, cell) pair to the home of the vertex.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::vector<size_t>> send(size);
+
+  for(size_t c(0); c<num_cells; ++c) {
+    auto row = cells[c];
+
+    for(auto v = row.begin(); v != row.end(); ++v) {
+      if(std::find(row.begin(), v, *v) == v) {
+        send[home(*v)].push_back(*v);
+        send[home(*v)].push_back(offset + c);
       } // if
-#endif
+    } // for
+  } // for
+
+  std::vector<std::pair<size_t, size_t>> referencers;
+
+  std::vector<int> recv_cnts;
+
+  {
+  auto pairs = detail::alltoallv(send, recv_cnts);
+
+  referencers.reserve(pairs.size()/2);
+
+  for(size_t i(0); i<pairs.size(); i+=2) {
+    referencers.emplace_back(pairs[i], pairs[i+1]);
+  } // for
+
+  std::sort(referencers.begin(), referencers.end());
+  } // scope
+
+  //--------------------------------------------------------------------------//
+  // Request the cells that reference each local vertex from its home, and
+  // answer the requests of the other ranks with a count followed by the
+  // cells.
+  //--------------------------------------------------------------------------//
+
+  for(auto & s: send) {
+    s.clear();
+  } // for
+
+  for(auto v: vertices) {
+    send[home(v)].push_back(v);
+  } // for
+
+  {
+  auto requests = detail::alltoallv(send, recv_cnts);
+
+  size_t pos(0);
+
+  for(size_t r(0); r<size; ++r) {
+    send[r].clear();
+
+    for(int i(0); i<recv_cnts[r]; ++i, ++pos) {
+      auto range = std::equal_range(referencers.begin(), referencers.end(),
+        std::make_pair(requests[pos], size_t(0)),
+        [](const std::pair<size_t, size_t> & a,
+          const std::pair<size_t, size_t> & b) {
+          return a.first < b.first;
+        });
+
+      send[r].push_back(std::distance(range.first, range.second));
 
-    for(auto n: neighbors) {
-      dcrs.indices.push_back(n);
+      for(auto itr = range.first; itr != range.second; ++itr) {
+        send[r].push_back(itr->second);
+      } // for
     } // for
+  } // for
+  } // scope
+
+  referencers.clear();
+  referencers.shrink_to_fit();
+
+  // The home ranks are monotonic in the vertex id, so the answers arrive
+  // in the order of the sorted local vertices.
+  std::vector<size_t> vertex_offsets(1, 0);
+  std::vector<size_t> vertex_cells;
+
+  {
+  auto answers = detail::alltoallv(send, recv_cnts);
+
+  vertex_offsets.reserve(vertices.size()+1);
+  vertex_cells.reserve(answers.size() - vertices.size());
 
-    dcrs.offsets.push_back(dcrs.offsets[i] + neighbors.size());
+  for(size_t pos(0); pos<answers.size();) {
+    const size_t n = answers[pos++];
+    vertex_cells.insert(vertex_cells.end(), answers.begin() + pos,
+      answers.begin() + pos + n);
+    vertex_offsets.push_back(vertex_cells.size());
+    pos += n;
+  } // for
+
+  clog_assert(vertex_offsets.size() == vertices.size()+1,
+    "missing vertex referencers");
+  } // scope
+
+  //--------------------------------------------------------------------------//
+  // Create the cell-to-cell graph.
+  //--------------------------------------------------------------------------//
+
+  dcrs.offsets.push_back(0);
+
+  std::vector<size_t> candidates;
+
+  for(size_t c(0); c<num_cells; ++c) {
+    auto row = cells[c];
+    candidates.clear();
+
+    for(auto v = row.begin(); v != row.end(); ++v) {
+
+      // Count a vertex that is listed twice only once
+      if(std::find(row.begin(), v, *v) != v) {
+        continue;
+      } // if
+
+      const size_t i = std::distance(vertices.begin(),
+        std::lower_bound(vertices.begin(), vertices.end(), *v));
+
+      for(size_t j(vertex_offsets[i]); j<vertex_offsets[i+1]; ++j) {
+        if(vertex_cells[j] != offset + c) {
+          candidates.push_back(vertex_cells[j]);
+        } // if
+      } // for
+    } // for
+
+    std::sort(candidates.begin(), candidates.end());
+
+    // Add each cell that shares more than THRU_DIMENSION vertices
+    for(size_t i(0); i<candidates.size();) {
+      size_t j(i+1);
+
+      while(j<candidates.size() && candidates[j] == candidates[i]) {
+        ++j;
+      } // while
+
+      if(j-i > THRU_DIMENSION) {
+        dcrs.indices.push_back(candidates[i]);
+      } // if
+
+      i = j;
+    } // for
+
+    dcrs.offsets.push_back(dcrs.indices.size());
   } // for
 
   return dcrs;
-} // make_dcrs
+} // make_distributed_dcrs
 
 } // namespace coloring
 } // namespace flecsi
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flecsi/coloring/communicator.h"
+#include "flecsi/utils/flat_set.h"
 
 ///
 /// \file
@@ -28,6 +29,10 @@ struct index_coloring_t
 {
   using entity_info_t = flecsi::coloring::entity_info_t;
 
+  // Sorted, contiguous set of entity_info_t. The offset of an entity
+  // in the set is available in O(log n) through find.
+  using entity_set_t = utils::flat_set__<entity_info_t>;
+
   //------------------------------------------------------------------------//
   // Data members.
   //------------------------------------------------------------------------//
@@ -36,13 +41,13 @@ struct index_coloring_t
   std::set<size_t> primary;
 
   // Set of entity_info_t type of the exclusive coloring
-  std::set<entity_info_t > exclusive;
+  entity_set_t exclusive;
 
   // Set of entity_info_t type of the shared coloring
-  std::set<entity_info_t> shared;
+  entity_set_t shared;
 
   // Set of entity_info_t type of the ghost coloring
-  std::set<entity_info_t> ghost;
+  entity_set_t ghost;
 
   // Rank id to number of entities
   std::unordered_map<size_t, size_t> entities_per_rank;
@@ -68,6 +73,69 @@ struct index_coloring_t
 
 }; // struct index_coloring_t
 
+///
+/// Populate the exclusive, shared and ghost entities of an index coloring,
+/// and the matching aggregate coloring information, in bulk from the
+/// primary coloring and the result of communicator_t::get_primary_info
+/// for its nearest neighbors.
+///
+/// \param rank         The rank of the calling color.
+/// \param primary_info The result of communicator_t::get_primary_info.
+/// \param coloring     The index coloring. Its primary coloring must be
+///                     set.
+/// \param color_info   The coloring information to populate.
+///
+inline
+void
+build_index_coloring(
+  size_t rank,
+  const std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>> &
+    primary_info,
+  index_coloring_t & coloring,
+  coloring_info_t & color_info
+)
+{
+  std::vector<entity_info_t> exclusive;
+  std::vector<entity_info_t> shared;
+  std::vector<entity_info_t> ghost(primary_info.second.begin(),
+    primary_info.second.end());
+
+  std::vector<size_t> shared_users;
+  std::vector<size_t> ghost_owners;
+
+  size_t offset(0);
+  for(auto i: coloring.primary) {
+    const auto & users = primary_info.first[offset];
+
+    if(users.size()) {
+      shared.emplace_back(i, rank, offset, users);
+      shared_users.insert(shared_users.end(), users.begin(), users.end());
+    }
+    else {
+      exclusive.emplace_back(i, rank, offset);
+    } // if
+
+    ++offset;
+  } // for
+
+  for(auto & i: ghost) {
+    ghost_owners.push_back(i.rank);
+  } // for
+
+  coloring.exclusive = index_coloring_t::entity_set_t(std::move(exclusive));
+  coloring.shared = index_coloring_t::entity_set_t(std::move(shared));
+  coloring.ghost = index_coloring_t::entity_set_t(std::move(ghost));
+
+  color_info.shared_users =
+    utils::flat_set__<size_t>(std::move(shared_users));
+  color_info.ghost_owners =
+    utils::flat_set__<size_t>(std::move(ghost_owners));
+
+  color_info.exclusive = coloring.exclusive.size();
+  color_info.shared = coloring.shared.size();
+  color_info.ghost = coloring.ghost.size();
+} // build_index_coloring
+
 } // namespace coloring
 } // namespace flecsi
 
@@ -24,6 +24,10 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <unordered_map>
+
+#include "flecsi/utils/flat_set.h"
 #include "flecsi/utils/set_utils.h"
 
 clog_register_tag(mpi_communicator);
@@ -78,52 +82,59 @@ public:
   }
 
   //-------------------------------------------------------------------------//
-  //! Reduces info_indices from all MPI ranks
+  //! Gather the request indices of all MPI ranks
+  //!
+  //! @param request_indices  sorted set of shared, ghost etc
   //!
-  //! @param request_indices  std::set of shared, ghost etc
-  //! @param max_request_indices Maximum # of indices per rank 
-  //! @param colors Number of MPI ranks
-  //! 
-  //! @return std::vector vith the infirmation for the info_indices from all
-  //!         MPI ranks
+  //! @return std::vector with the request indices of each MPI rank, in
+  //!         rank order. Each request keeps its own size, i.e., nothing
+  //!         is padded to the largest request.
   //!
   //! @ingroup coloring
   //-------------------------------------------------------------------------//
 
-  std::vector<size_t>
+  template<typename SET>
+  std::vector<std::vector<size_t>>
   get_info_indices(
-    const std::set<size_t> & request_indices,
-    size_t max_request_indices,
-    int colors
+    const SET & request_indices
   )
   {
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(colors*max_request_indices,
-      std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors*max_request_indices);
+    const size_t colors = size();
 
-    for(size_t c(0); c<colors; ++c) {
-      size_t off(0);
-      const size_t coff = c*max_request_indices;
+    const auto mpi_size_t_type =
+      flecsi::coloring::mpi_typetraits__<size_t>::type();
 
-      for(auto s: request_indices) {
-        input_indices[coff + off++] = s;
-      } // for
+    std::vector<size_t> input_indices(request_indices.begin(),
+      request_indices.end());
+
+    // Gather the request sizes, so that every rank receives exactly the
+    // requests of the others.
+    int send_cnt = input_indices.size();
+    std::vector<int> recv_cnts(colors);
+
+    MPI_Allgather(&send_cnt, 1, MPI_INT, &recv_cnts[0], 1, MPI_INT,
+      MPI_COMM_WORLD);
+
+    std::vector<int> recv_disps(colors, 0);
+
+    for(size_t r(1); r<colors; ++r) {
+      recv_disps[r] = recv_disps[r-1] + recv_cnts[r-1];
     } // for
 
-    const auto mpi_size_t_type =
-      flecsi::coloring::mpi_typetraits__<size_t>::type();
+    std::vector<size_t> recv(recv_disps[colors-1] + recv_cnts[colors-1]);
 
     // Send the request indices to all other ranks.
-    int result = MPI_Alltoall(
-      &input_indices[0], max_request_indices, mpi_size_t_type,
-      &info_indices[0], max_request_indices, mpi_size_t_type,
+    MPI_Allgatherv(input_indices.data(), send_cnt, mpi_size_t_type,
+      recv.data(), &recv_cnts[0], &recv_disps[0], mpi_size_t_type,
       MPI_COMM_WORLD);
 
+    std::vector<std::vector<size_t>> info_indices(colors);
+
+    for(size_t r(0); r<colors; ++r) {
+      info_indices[r].assign(recv.begin() + recv_disps[r],
+        recv.begin() + recv_disps[r] + recv_cnts[r]);
+    } // for
+
     return info_indices;
   }//get_info_indices
 
@@ -153,39 +164,24 @@ public:
     std::vector<size_t> request_indices_vector(request_indices.begin(),
       request_indices.end());
 
-    const auto mpi_size_t_type =
-      flecsi::coloring::mpi_typetraits__<size_t>::type();
-
-    size_t max_request_indices =get_max_request_size(request_indices.size());
-
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(colors*max_request_indices,
-      std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors*max_request_indices);
-    info_indices=get_info_indices(request_indices, max_request_indices, colors);
-
-    // For now, we need two arrays for each all-to-all communication:
-    // One for rank ownership of the request indices, and one
-    // for the offsets. We could probably combine these. However,
-    // we would probably have to define a custom MPI type. It
-    // will only be worth the effort if this appraoch is slow.
-    // The input offsets do not need to be initialized because
-    // the information is available in the input_indices array.
-    std::vector<size_t> input_offsets(colors*max_request_indices);
-    std::vector<size_t> info_offsets(colors*max_request_indices);
-
-    // Reset input indices to use to send back information
-    std::fill(input_indices.begin(), input_indices.end(),
-      std::numeric_limits<size_t>::max());
+    // Every rank receives the requests of all other ranks. Each rank
+    // that receives a request will try to provide information about
+    // the indices that it owns.
+    auto info_indices = get_info_indices(request_indices);
 
     // For the primary coloring, provide rank and entity information
     // on indices that are shared with other processes.
     std::vector<std::set<size_t>> local(primary.size());
 
+    // A flat copy of the primary coloring finds a match by binary search
+    // and gives its offset by pointer difference.
+    const utils::flat_set__<size_t> primary_flat(primary);
+
+    // The answers to each rank hold a (rank, offset) pair per requested
+    // index, in the order of the request. Indices that we do not own
+    // are answered with size_t max.
+    std::vector<std::vector<size_t>> answers(colors);
+
     // See if we can fill any requests...
     for(size_t r(0); r<colors; ++r) {
 
@@ -194,39 +190,31 @@ public:
         continue;
       } // if
 
-      // These array slices are just for convenience.
-      size_t * info = &info_indices[r*max_request_indices];
-      size_t * offset = &input_offsets[r*max_request_indices];
-      size_t * input = &input_indices[r*max_request_indices];
+      const auto & info = info_indices[r];
+      auto & answer = answers[r];
+      answer.resize(2*info.size(), std::numeric_limits<size_t>::max());
 
       // See which requests we can fulfill.
-      for(size_t i(0); i<max_request_indices; ++i) {
+      for(size_t i(0); i<info.size(); ++i) {
 
-        auto match = primary.find(info[i]);
+        auto match = primary_flat.find(info[i]);
 
-        if(match != primary.end()) {
+        if(match != primary_flat.end()) {
           // This is a match, i.e., we own this entity, so we can
           // set the rank (ownership) and offset.
-          input[i] = color;
-          offset[i] = std::distance(primary.begin(), match);
+          const size_t offset = std::distance(primary_flat.begin(), match);
+          answer[2*i] = color;
+          answer[2*i+1] = offset;
 
           // We also need to register that this index is shared
           // with other ranks
-          local[offset[i]].insert(r);
+          local[offset].insert(r);
         } // if
       } // for
     } // for
 
-
-    // Send the indices information back to all ranks.
-    int result = MPI_Alltoall(&input_indices[0], max_request_indices,
-      mpi_size_t_type, &info_indices[0], max_request_indices,
-      mpi_size_t_type, MPI_COMM_WORLD);
-
-    // Send the offsets information back to all ranks.
-    result = MPI_Alltoall(&input_offsets[0], max_request_indices,
-      mpi_size_t_type, &info_offsets[0], max_request_indices,
-      mpi_size_t_type, MPI_COMM_WORLD);
+    // Send the answers back to the requesting ranks.
+    auto replies = alltoallv(answers);
 
     std::set<entity_info_t> remote;
 
@@ -237,17 +225,15 @@ public:
         continue;
       } // if
 
-      // Another slice for convenience.
-      size_t * ranks = &info_indices[r*max_request_indices];
-      size_t * offsets = &info_offsets[r*max_request_indices];
+      const auto & reply = replies[r];
 
-      for(size_t i(0); i<max_request_indices; ++i) {
+      for(size_t i(0); i<reply.size()/2; ++i) {
 
-        if(ranks[i] != std::numeric_limits<size_t>::max()) {
+        if(reply[2*i] != std::numeric_limits<size_t>::max()) {
           // If this is not size_t max, this rank answered our request
           // and we can set the information.
-          remote.insert(entity_info_t(request_indices_vector[i], ranks[i],
-            offsets[i], {}));
+          remote.insert(entity_info_t(request_indices_vector[i], reply[2*i],
+            reply[2*i+1], {}));
         } // if
       } // for
     } // for
@@ -255,6 +241,122 @@ public:
     return std::make_pair(local , remote);
   } // get_primary_info
 
+  //-------------------------------------------------------------------------//
+  //! Rerturn the same information as get_primary_info, using a rendezvous
+  //! directory instead of broadcasting every request to every rank.
+  //!
+  //! Each index has a directory rank, given by the block distribution of
+  //! the indices. Every rank registers the owner and offset of its
+  //! primary indices with their directory ranks, and sends each request
+  //! only to the directory rank of the requested index. The directory
+  //! ranks answer the requests and tell the owners which ranks use their
+  //! indices. Memory and communication volume are proportional to the
+  //! local number of primary and requested indices, instead of to the
+  //! number of ranks times the largest request.
+  //!
+  //! @param primary         The primary indices of the calling rank.
+  //! @param request_indices The indices for which to return information.
+  //! @param distribution    The index ranges of the block distribution,
+  //!                        e.g., dcrs_t::distribution. Indices beyond
+  //!                        the last range belong to the last rank.
+  //!
+  //! @ingroup coloring
+  //-------------------------------------------------------------------------//
+
+  std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
+  get_primary_info(
+    const std::set<size_t> & primary,
+    const std::set<size_t> & request_indices,
+    const std::vector<size_t> & distribution
+  )
+  override
+  {
+    const size_t colors = size();
+
+    auto directory = [&](size_t index) -> size_t {
+      const size_t d = std::distance(distribution.begin(),
+        std::upper_bound(distribution.begin(), distribution.end(), index));
+      return d == 0 ? 0 : std::min(d - 1, colors - 1);
+    };
+
+    std::vector<std::vector<size_t>> sbuffers(colors);
+
+    // Register (index, offset) pairs for our primary indices with the
+    // directory.
+    {
+    size_t offset(0);
+    for(auto i: primary) {
+      auto & sbuffer = sbuffers[directory(i)];
+      sbuffer.push_back(i);
+      sbuffer.push_back(offset++);
+    } // for
+    } // scope
+
+    auto rbuffers = alltoallv(sbuffers);
+
+    // The directory entries map an index to its (owner, offset) pair.
+    std::unordered_map<size_t, std::pair<size_t, size_t>> entries;
+    for(size_t r(0); r<colors; ++r) {
+      for(size_t i(0); i<rbuffers[r].size(); i+=2) {
+        entries[rbuffers[r][i]] = { r, rbuffers[r][i+1] };
+      } // for
+    } // for
+
+    // Send each request to the directory rank of the requested index.
+    for(auto & sbuffer: sbuffers) {
+      sbuffer.clear();
+    } // for
+
+    for(auto i: request_indices) {
+      sbuffers[directory(i)].push_back(i);
+    } // for
+
+    rbuffers = alltoallv(sbuffers);
+
+    // Answer the requests with (index, owner, offset) triples, and tell
+    // the owners which ranks use their indices with (offset, user) pairs.
+    std::vector<std::vector<size_t>> answers(colors);
+    std::vector<std::vector<size_t>> users(colors);
+
+    for(size_t r(0); r<colors; ++r) {
+      for(auto i: rbuffers[r]) {
+        auto match = entries.find(i);
+
+        // Requests for indices that a rank owns itself are ignored.
+        if(match == entries.end() || match->second.first == r) {
+          continue;
+        } // if
+
+        answers[r].push_back(i);
+        answers[r].push_back(match->second.first);
+        answers[r].push_back(match->second.second);
+
+        users[match->second.first].push_back(match->second.second);
+        users[match->second.first].push_back(r);
+      } // for
+    } // for
+
+    rbuffers = alltoallv(answers);
+    auto ubuffers = alltoallv(users);
+
+    std::vector<std::set<size_t>> local(primary.size());
+    for(auto & ubuffer: ubuffers) {
+      for(size_t i(0); i<ubuffer.size(); i+=2) {
+        local[ubuffer[i]].insert(ubuffer[i+1]);
+      } // for
+    } // for
+
+    std::set<entity_info_t> remote;
+    for(auto & rbuffer: rbuffers) {
+      for(size_t i(0); i<rbuffer.size(); i+=3) {
+        remote.insert(entity_info_t(rbuffer[i], rbuffer[i+1],
+          rbuffer[i+2], {}));
+      } // for
+    } // for
+
+    return std::make_pair(local, remote);
+  } // get_primary_info
+
   //-------------------------------------------------------------------------//
   //! Rerturn FIXME
   //!
@@ -274,34 +376,8 @@ public:
     auto colors = size();
     auto color = rank();
 
-    // Store the request in a vector for indexed access below.
-    std::vector<size_t> request_indices_vector(request_indices.begin(),
-      request_indices.end());
-
-    const auto mpi_size_t_type =
-      flecsi::coloring::mpi_typetraits__<size_t>::type();   
- 
-    size_t max_request_indices =
-         get_max_request_size(request_indices.size());
-
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(colors*max_request_indices,
-      std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors*max_request_indices);
-    info_indices=get_info_indices(request_indices, max_request_indices, colors); 
-  
-    // Reset input indices to use to send back information
-    std::fill(input_indices.begin(), input_indices.end(),
-      std::numeric_limits<size_t>::max());
-
-    {
-    clog_tag_guard(mpi_communicator);
-    clog_container_one(info, "input_indices", info_indices, clog::space);
-    }
+    // Every rank receives the requests of all other ranks.
+    auto info_indices = get_info_indices(request_indices);
 
     //
     std::unordered_map<size_t, std::set<size_t>> intersection_map;
@@ -313,16 +389,9 @@ public:
         continue;
       } // if
 
-      // Array slice for convenience.
-      size_t * info = &info_indices[r*max_request_indices];
-
       // Create a set of the off-color request indices.
-      std::set<size_t> intersection_set;
-      for(size_t i(0); i<max_request_indices; ++i) {
-        if(info[i] != std::numeric_limits<size_t>::max()) {
-          intersection_set.insert(info[i]);
-        } // if
-      } // for
+      std::set<size_t> intersection_set(info_indices[r].begin(),
+        info_indices[r].end());
 
       {
       clog_tag_guard(mpi_communicator);
@@ -369,28 +438,14 @@ public:
     auto colors = size();
     auto color = rank();
 
-    size_t max_request_indices =
-         get_max_request_size(local_indices.size());
-
-    auto info_indices =
-      get_info_indices(local_indices, max_request_indices, colors);
+    auto info_indices = get_info_indices(local_indices);
   
     std::unordered_map<size_t, std::set<size_t>> entity_reduction_map;
 
     for(size_t c(0); c<colors; ++c) {
 
-      // Array slice for convenience.
-      size_t * info = &info_indices[c*max_request_indices];
-
-      // Create a set of the off-color request indices.
-      std::set<size_t> reduction_set;
-      for(size_t i(0); i<max_request_indices; ++i) {
-        if(info[i] != std::numeric_limits<size_t>::max()) {
-          reduction_set.insert(info[i]);
-        } // if
-      } // for
-
-      entity_reduction_map[c] = reduction_set;
+      entity_reduction_map[c] = std::set<size_t>(info_indices[c].begin(),
+        info_indices[c].end());
     } // for
 
     return entity_reduction_map;
@@ -562,33 +617,18 @@ public:
   template<typename Lambda>
   void
   alltoall_coloring_info(
-    std::set<size_t> & request_indices,
+    const utils::flat_set__<size_t> & request_indices,
     Lambda&& function
   )
   {
     auto colors = size();
     auto color = rank();
 
-    size_t max_request_indices =
-         get_max_request_size(request_indices.size());
-
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> info_indices(colors*max_request_indices);
-    info_indices=get_info_indices(request_indices, max_request_indices, colors);
+    auto info_indices = get_info_indices(request_indices);
 
     for(size_t c(0); c<colors; ++c) {
-
-      size_t * info = &info_indices[c*max_request_indices];
-
-      for(size_t i(0); i<max_request_indices; ++i) {
-        if(info[i] != std::numeric_limits<size_t>::max()) {
-          const size_t value=info[i];
-         function(c,value);
-        } // if
+      for(auto value: info_indices[c]) {
+        function(c,value);
       } // for
     } // for
    
@@ -639,37 +679,65 @@ public:
     return coloring_info;
   } // gather_coloring_info
 
+private:
+
   //-------------------------------------------------------------------------//
-  //! Find maximum size for the "requested_indicies" - MPI reduction
+  //! Send a variable-sized buffer of size_t values to each rank, and
+  //! return the buffers received from each rank.
   //!
-  //! @param request_indices request_indices for local MPI rank
-  //!
-  //! @return max_request_indices Maximum size for the "requested_indicies"
+  //! @param sbuffers One buffer per rank to send.
   //!
   //! @ingroup coloring
-  //-------------------------------------------------------------------------// 
+  //-------------------------------------------------------------------------//
 
-  size_t
-  get_max_request_size(
-    size_t request_indices
+  std::vector<std::vector<size_t>>
+  alltoallv(
+    const std::vector<std::vector<size_t>> & sbuffers
   )
   {
-    size_t max_request_indices = 0;
+    const size_t colors = size();
 
-    // Get a valid MPI type for size_t.
     const auto mpi_size_t_type =
       flecsi::coloring::mpi_typetraits__<size_t>::type();
 
-    // This may be inefficient, but this call is doing a reduction
-    // to determine the maximum number of indices requested by any rank
-    // so that we can pad out the all-to-all communication below.
-    int result = MPI_Allreduce(&request_indices, &max_request_indices, 1,
-      mpi_size_t_type, MPI_MAX, MPI_COMM_WORLD);
+    std::vector<int> send_cnts(colors);
+    std::vector<int> recv_cnts(colors);
 
-    return max_request_indices;
-  } // get_max_request_size
+    for(size_t r(0); r<colors; ++r) {
+      send_cnts[r] = sbuffers[r].size();
+    } // for
 
-private:
+    MPI_Alltoall(&send_cnts[0], 1, MPI_INT, &recv_cnts[0], 1, MPI_INT,
+      MPI_COMM_WORLD);
+
+    std::vector<int> send_disps(colors, 0);
+    std::vector<int> recv_disps(colors, 0);
+
+    for(size_t r(1); r<colors; ++r) {
+      send_disps[r] = send_disps[r-1] + send_cnts[r-1];
+      recv_disps[r] = recv_disps[r-1] + recv_cnts[r-1];
+    } // for
+
+    std::vector<size_t> send(send_disps[colors-1] + send_cnts[colors-1]);
+    std::vector<size_t> recv(recv_disps[colors-1] + recv_cnts[colors-1]);
+
+    for(size_t r(0); r<colors; ++r) {
+      std::copy(sbuffers[r].begin(), sbuffers[r].end(),
+        send.begin() + send_disps[r]);
+    } // for
+
+    MPI_Alltoallv(send.data(), &send_cnts[0], &send_disps[0],
+      mpi_size_t_type, recv.data(), &recv_cnts[0], &recv_disps[0],
+      mpi_size_t_type, MPI_COMM_WORLD);
+
+    std::vector<std::vector<size_t>> rbuffers(colors);
+    for(size_t r(0); r<colors; ++r) {
+      rbuffers[r].assign(recv.begin() + recv_disps[r],
+        recv.begin() + recv_disps[r] + recv_cnts[r]);
+    } // for
+
+    return rbuffers;
+  } // alltoallv
 
 }; // class mpi_communicator_t
 
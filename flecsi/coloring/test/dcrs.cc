@@ -8,6 +8,8 @@
 
 #include "flecsi/io/simple_definition.h"
 #include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/mpi_communicator.h"
+#include "flecsi/utils/set_utils.h"
 
 const size_t output_rank(0);
 
@@ -59,6 +61,40 @@ TEST(dcrs, simple2d_16x16) {
 
 } // TEST
 
+TEST(dcrs, primary_info_directory) {
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Take the block of the next rank as the primary coloring, so that
+  // the owner of an index is never its directory rank.
+  const size_t block = (rank + 1) % size;
+  std::set<size_t> primary;
+  for(size_t i(dcrs.distribution[block]);
+    i<dcrs.distribution[block+1]; ++i) {
+    primary.insert(i);
+  } // for
+
+  auto closure = flecsi::topology::entity_neighbors<2,2,0>(sd, primary);
+  auto nearest_neighbors = flecsi::utils::set_difference(closure, primary);
+
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  auto broadcast = communicator.get_primary_info(primary, nearest_neighbors);
+  auto directory = communicator.get_primary_info(primary, nearest_neighbors,
+    dcrs.distribution);
+
+  CINCH_ASSERT(EQ, std::get<0>(broadcast), std::get<0>(directory));
+  CINCH_ASSERT(EQ, std::get<1>(broadcast), std::get<1>(directory));
+  CINCH_ASSERT(EQ, std::get<1>(directory).size(), nearest_neighbors.size());
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
@@ -0,0 +1,68 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include "flecsi/io/exodus_definition.h"
+#include "flecsi/coloring/dcrs_utils.h"
+
+// Check that the graph built from the part of the mesh that each rank
+// reads matches the graph built from the whole mesh.
+template<int D>
+void
+compare_dcrs(
+  const std::string & filename
+)
+{
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  flecsi::io::exodus_definition__<D, double> md(filename);
+  flecsi::io::distributed_exodus_definition__<D, double>
+    dmd(filename, rank, size);
+
+  CINCH_ASSERT(EQ, md.num_entities(0), dmd.num_entities(0));
+  CINCH_ASSERT(EQ, md.num_entities(D), dmd.num_entities(D));
+
+  auto dcrs = flecsi::coloring::make_dcrs(md);
+  auto ddcrs = flecsi::coloring::make_distributed_dcrs<D>(dmd);
+
+  CINCH_ASSERT(EQ, dcrs.distribution, ddcrs.distribution);
+  CINCH_ASSERT(EQ, dcrs.offsets, ddcrs.offsets);
+  CINCH_ASSERT(EQ, dcrs.indices, ddcrs.indices);
+
+  // The local cells and vertex coordinates match the whole mesh.
+  for(size_t c(0); c<dmd.num_local_entities(D); ++c) {
+    auto vs = dmd.entities_ref(D, 0, c);
+    auto compare = md.entities(D, 0, dmd.offset() + c);
+
+    CINCH_ASSERT(EQ, compare, std::vector<size_t>(vs.begin(), vs.end()));
+
+    for(auto v: vs) {
+      auto p = md.template vertex<flecsi::point__<double, D>>(v);
+      auto q = dmd.template vertex<flecsi::point__<double, D>>(v);
+
+      for(size_t d(0); d<D; ++d) {
+        CINCH_ASSERT(EQ, p[d], q[d]);
+      } // for
+    } // for
+  } // for
+} // compare_dcrs
+
+TEST(distributed_dcrs, exodus2d) {
+  compare_dcrs<2>("exodus2d-mixed.exo");
+} // TEST
+
+TEST(distributed_dcrs, exodus3d) {
+  compare_dcrs<3>("exodus3d-hex.exo");
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,162 @@
+/*~--------------------------------------------------------------------------~*
+ *  @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+ * /@@/////  /@@          @@////@@ @@////// /@@
+ * /@@       /@@  @@@@@  @@    // /@@       /@@
+ * /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+ * /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+ * /@@       /@@/@@//// //@@    @@       /@@/@@
+ * /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+ * //       ///  //////   //////  ////////  //
+ *
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_parallel_for_h
+#define flecsi_parallel_for_h
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+#include "flecsi/concurrency/thread_pool.h"
+
+/*!
+ * \file parallel_for.h
+ * \date Initial file creation: Oct 17, 2017
+ */
+
+namespace flecsi
+{
+
+  /*!
+    Return a reference to the number of threads used by parallel_for.
+    The default is the value of the FLECSI_NUM_THREADS environment
+    variable if it is set, and the number of hardware threads otherwise.
+    When several MPI ranks share a node, FLECSI_NUM_THREADS should be
+    set to avoid oversubscribing the cores.
+   */
+  inline
+  size_t &
+  parallel_for_threads()
+  {
+    static size_t num_threads = []() -> size_t {
+      const char * env = std::getenv("FLECSI_NUM_THREADS");
+
+      if(env != nullptr && std::atoi(env) > 0) {
+        return std::atoi(env);
+      } // if
+
+      return std::max(1u, std::thread::hardware_concurrency());
+    }();
+
+    return num_threads;
+  } // parallel_for_threads
+
+  /*!
+    Return the thread pool shared by parallel_for and the other parallel
+    helpers. It is started on first use with parallel_for_threads() - 1
+    workers, since the calling thread also executes tasks while it waits.
+    Changing parallel_for_threads() afterwards changes the number of
+    blocks, but not the number of workers.
+   */
+  inline
+  thread_pool &
+  parallel_for_pool()
+  {
+    static thread_pool pool;
+    static bool started = (pool.start(parallel_for_threads() - 1), true);
+    (void)started;
+
+    return pool;
+  } // parallel_for_pool
+
+  /*!
+    Split the range [begin, end) into contiguous blocks, one per thread,
+    and call f(first, last) on each block concurrently. The range is
+    processed by the calling thread if it holds fewer than grain indices
+    or if only one thread is available. Returns after all of the blocks
+    have been processed.
+
+    \param begin The start of the range.
+    \param end   The end of the range.
+    \param f     The function to call on each block.
+    \param grain The minimum number of indices per block.
+   */
+  template<typename FUNCTION>
+  void
+  parallel_for_blocks(
+    size_t begin,
+    size_t end,
+    FUNCTION && f,
+    size_t grain = 1024
+  )
+  {
+    if(end <= begin) {
+      return;
+    } // if
+
+    const size_t n = end - begin;
+    const size_t num_blocks = std::min(parallel_for_threads(),
+      std::max(size_t(1), n/std::max(grain, size_t(1))));
+
+    if(num_blocks == 1) {
+      f(begin, end);
+      return;
+    } // if
+
+    const size_t quot = n/num_blocks;
+    const size_t rem = n%num_blocks;
+
+    auto block_begin = [&](size_t b) {
+      return begin + b*quot + std::min(b, rem);
+    };
+
+    // The calling thread processes the first block, then helps with the
+    // others while it waits.
+    task_group group(parallel_for_pool());
+
+    for(size_t b = 1; b < num_blocks; ++b) {
+      group.run([&f, first = block_begin(b),
+        last = block_begin(b + 1)]() { f(first, last); });
+    } // for
+
+    f(block_begin(0), block_begin(1));
+
+    group.wait();
+  } // parallel_for_blocks
+
+  /*!
+    Call f(i) for every i in [begin, end), distributing the indices over
+    the threads in contiguous blocks.
+
+    \param begin The start of the range.
+    \param end   The end of the range.
+    \param f     The function to call on each index.
+    \param grain The minimum number of indices per block.
+   */
+  template<typename FUNCTION>
+  void
+  parallel_for(
+    size_t begin,
+    size_t end,
+    FUNCTION && f,
+    size_t grain = 1024
+  )
+  {
+    parallel_for_blocks(begin, end,
+      [&f](size_t first, size_t last) {
+        for(size_t i = first; i < last; ++i) {
+          f(i);
+        } // for
+      }, grain);
+  } // parallel_for
+
+} // namespace flecsi
+
+#endif // flecsi_parallel_for_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
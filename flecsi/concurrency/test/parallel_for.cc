@@ -0,0 +1,332 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Security, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+
+// includes: flecsi
+#include <flecsi.h>
+#include "flecsi/concurrency/parallel_for.h"
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+  #include "flecsi/execution/context.h"
+  #include "flecsi/topology/mesh_topology.h"
+#endif
+
+// includes: other
+#include <cinchtest.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using flecsi::parallel_for;
+using flecsi::parallel_for_blocks;
+using flecsi::parallel_for_threads;
+
+// The shared pool is started with the thread count in effect at its first
+// use, so every test sets it before calling parallel_for.
+const size_t num_threads = 4;
+
+// =============================================================================
+// Test flecsi::parallel_for_blocks range splitting
+// =============================================================================
+
+// TEST
+TEST(parallel_for, empty)
+{
+  parallel_for_threads() = num_threads;
+
+  size_t calls(0);
+
+  parallel_for_blocks(0, 0, [&](size_t, size_t) { ++calls; });
+  parallel_for_blocks(10, 5, [&](size_t, size_t) { ++calls; });
+  parallel_for(7, 7, [&](size_t) { ++calls; });
+
+  EXPECT_EQ(0, calls);
+} // TEST
+
+// TEST
+TEST(parallel_for, below_grain)
+{
+  parallel_for_threads() = num_threads;
+
+  // A range smaller than the grain is one block on the calling thread.
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::vector<std::thread::id> ids;
+
+  parallel_for_blocks(3, 100, [&](size_t first, size_t last) {
+    blocks.emplace_back(first, last);
+    ids.push_back(std::this_thread::get_id());
+  }, 1024);
+
+  ASSERT_EQ(1, blocks.size());
+  EXPECT_EQ(std::make_pair(size_t(3), size_t(100)), blocks[0]);
+  EXPECT_EQ(std::this_thread::get_id(), ids[0]);
+
+  // So is any range when only one thread is available.
+  parallel_for_threads() = 1;
+  blocks.clear();
+
+  parallel_for_blocks(0, 100000, [&](size_t first, size_t last) {
+    blocks.emplace_back(first, last);
+  }, 1);
+
+  parallel_for_threads() = num_threads;
+
+  ASSERT_EQ(1, blocks.size());
+  EXPECT_EQ(std::make_pair(size_t(0), size_t(100000)), blocks[0]);
+} // TEST
+
+// TEST
+TEST(parallel_for, uneven_blocks)
+{
+  parallel_for_threads() = num_threads;
+
+  // 4099 indices over 4 blocks split 1025, 1025, 1025, 1024.
+  const size_t begin = 5;
+  const size_t n = 4*1024 + 3;
+
+  std::vector<std::atomic<size_t>> visits(n);
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::mutex mutex;
+
+  parallel_for_blocks(begin, begin + n, [&](size_t first, size_t last) {
+    {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocks.emplace_back(first, last);
+    } // scope
+
+    for(size_t i(first); i < last; ++i) {
+      ++visits[i - begin];
+    } // for
+  }, 1024);
+
+  std::sort(blocks.begin(), blocks.end());
+
+  ASSERT_EQ(num_threads, blocks.size());
+  EXPECT_EQ(begin, blocks.front().first);
+  EXPECT_EQ(begin + n, blocks.back().second);
+
+  for(size_t b(0); b < blocks.size(); ++b) {
+    EXPECT_EQ(b < 3 ? 1025 : 1024, blocks[b].second - blocks[b].first);
+
+    if(b > 0) {
+      EXPECT_EQ(blocks[b-1].second, blocks[b].first);
+    } // if
+  } // for
+
+  // Every index is visited exactly once, also through parallel_for.
+  for(auto & v : visits) {
+    ASSERT_EQ(1, v.load());
+  } // for
+
+  parallel_for(begin, begin + n, [&](size_t i) { ++visits[i - begin]; },
+    16);
+
+  for(auto & v : visits) {
+    ASSERT_EQ(2, v.load());
+  } // for
+} // TEST
+
+// TEST
+TEST(parallel_for, nested)
+{
+  parallel_for_threads() = num_threads;
+
+  // Blocks that run parallel_for themselves wait by executing queued
+  // blocks, so nesting does not deadlock.
+  const size_t outer = 64;
+  const size_t inner = 4096;
+
+  std::vector<std::atomic<size_t>> sums(outer);
+
+  parallel_for(0, outer, [&](size_t o) {
+    parallel_for(0, inner, [&](size_t i) { sums[o] += i; }, 256);
+  }, 1);
+
+  for(auto & s : sums) {
+    EXPECT_EQ(inner*(inner - 1)/2, s.load());
+  } // for
+} // TEST
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+
+// =============================================================================
+// Test that the parallel transpose and intersect of mesh_topology_t give
+// the same connectivity as the serial ones.
+// =============================================================================
+
+using namespace flecsi::topology;
+
+using entity_id_t = flecsi::utils::id_t;
+
+class vertex_t : public mesh_entity_t<0, 1> {};
+
+class cell_t : public mesh_entity_t<2, 1>
+{
+public:
+
+  // Edges are not built by this test.
+  std::vector<size_t>
+  create_entities(entity_id_t, size_t, domain_connectivity<2> &,
+    entity_id_t *)
+  {
+    return {};
+  }
+}; // class cell_t
+
+class test_mesh_types_t
+{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell_t>,
+    std::tuple<index_space_<1>, domain_<0>, vertex_t>>;
+
+  // vertex -> cell is built by transpose, cell -> cell and
+  // vertex -> vertex by intersect.
+  using connectivities = std::tuple<
+    std::tuple<index_space_<2>, domain_<0>, cell_t, vertex_t>,
+    std::tuple<index_space_<3>, domain_<0>, vertex_t, cell_t>,
+    std::tuple<index_space_<4>, domain_<0>, cell_t, cell_t>,
+    std::tuple<index_space_<5>, domain_<0>, vertex_t, vertex_t>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base_t<num_domains> *
+  create_entity(mesh_topology_base_t<ST> *, size_t, const entity_id_t &)
+  {
+    return nullptr;
+  }
+}; // class test_mesh_types_t
+
+using test_mesh_t = mesh_topology_t<test_mesh_types_t>;
+
+// An n x n quad mesh and the buffers that back its storage.
+struct quad_mesh_t
+{
+  using offset_buffer_t = std::aligned_storage_t<
+    sizeof(flecsi::utils::offset_t), alignof(flecsi::utils::offset_t)>;
+
+  quad_mesh_t(size_t n)
+  : cells(n*n*sizeof(cell_t)), vertices((n+1)*(n+1)*sizeof(vertex_t)),
+    cell_ids(n*n), vertex_ids((n+1)*(n+1))
+  {
+    const size_t num_cells = n*n;
+    const size_t num_vertices = (n+1)*(n+1);
+    const size_t num_entities[] = { num_vertices, 0, num_cells };
+
+    storage.init_entities(0, 2,
+      reinterpret_cast<mesh_entity_base_ *>(cells.data()), cell_ids.data(),
+      sizeof(cell_t), num_cells, num_cells, 0, 0, false);
+    storage.init_entities(0, 0,
+      reinterpret_cast<mesh_entity_base_ *>(vertices.data()),
+      vertex_ids.data(), sizeof(vertex_t), num_vertices, num_vertices, 0, 0,
+      false);
+
+    // No entity has more than nine connections.
+    for(size_t from(0); from < 3; ++from) {
+      for(size_t to(0); to < 3; ++to) {
+        auto & o = offsets[from][to];
+        auto & i = indices[from][to];
+        o.resize(num_entities[from] + 1);
+        i.resize(9*num_entities[from] + 1);
+        storage.init_connectivity(0, 0, from, to,
+          reinterpret_cast<flecsi::utils::offset_t *>(o.data()), o.size(),
+          i.data(), i.size(), false);
+      } // for
+    } // for
+
+    mesh.reset(new test_mesh_t(&storage));
+
+    std::vector<vertex_t *> vs;
+    for(size_t v(0); v < num_vertices; ++v) {
+      vs.push_back(mesh->make<vertex_t>());
+    } // for
+
+    for(size_t row(0); row < n; ++row) {
+      for(size_t column(0); column < n; ++column) {
+        auto c = mesh->make<cell_t>();
+        mesh->init_cell<0>(c, {
+          vs[column     + (row    )*(n+1)],
+          vs[column + 1 + (row    )*(n+1)],
+          vs[column + 1 + (row + 1)*(n+1)],
+          vs[column     + (row + 1)*(n+1)] });
+      } // for
+    } // for
+
+    mesh->init<0>();
+  } // quad_mesh_t
+
+  std::vector<char> cells;
+  std::vector<char> vertices;
+  std::vector<entity_id_t> cell_ids;
+  std::vector<entity_id_t> vertex_ids;
+  std::vector<offset_buffer_t> offsets[3][3];
+  std::vector<entity_id_t> indices[3][3];
+  test_mesh_t::storage_t storage;
+  std::unique_ptr<test_mesh_t> mesh;
+}; // struct quad_mesh_t
+
+// TEST
+TEST(parallel_for, mesh_connectivity)
+{
+  // Large enough for the default grain to give several blocks.
+  const size_t n = 64;
+
+  // transpose() sorts by global id, so the cells and vertices need
+  // index maps. Local and global ids are the same here.
+  auto & context = flecsi::execution::context_t::instance();
+
+  std::map<size_t, size_t> identity;
+  for(size_t i(0); i < (n+1)*(n+1); ++i) {
+    identity[i] = i;
+  } // for
+
+  context.add_index_map(0, identity);
+  context.add_index_map(1, identity);
+
+  parallel_for_threads() = num_threads;
+  quad_mesh_t parallel(n);
+
+  parallel_for_threads() = 1;
+  quad_mesh_t serial(n);
+
+  parallel_for_threads() = num_threads;
+
+  const std::pair<size_t, size_t> computed[] = { {0, 2}, {2, 2}, {0, 0} };
+
+  for(auto dims : computed) {
+    const auto & pc =
+      parallel.mesh->get_connectivity(0, dims.first, dims.second);
+    const auto & sc =
+      serial.mesh->get_connectivity(0, dims.first, dims.second);
+
+    ASSERT_FALSE(sc.empty());
+    ASSERT_EQ(sc.from_size(), pc.from_size());
+    ASSERT_EQ(sc.to_size(), pc.to_size());
+
+    for(size_t i(0); i < sc.from_size(); ++i) {
+      auto s = sc.get_entity_vec(i);
+      auto p = pc.get_entity_vec(i);
+
+      ASSERT_EQ(std::vector<entity_id_t>(s.begin(), s.end()),
+        std::vector<entity_id_t>(p.begin(), p.end()));
+    } // for
+  } // for
+} // TEST
+
+#endif // FLECSI_RUNTIME_MODEL_mpi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
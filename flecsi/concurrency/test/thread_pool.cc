@@ -0,0 +1,248 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Security, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+
+// includes: flecsi
+#include "flecsi/concurrency/thread_pool.h"
+
+// includes: other
+#include <cinchtest.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using flecsi::pool_task_t;
+using flecsi::task_group;
+using flecsi::thread_pool;
+
+// =============================================================================
+// Recursively run a binary tree of tasks of the given depth in one group.
+// =============================================================================
+
+void
+spawn(
+  task_group & group,
+  std::atomic<size_t> & count,
+  size_t depth
+)
+{
+  ++count;
+
+  if(depth == 0) {
+    return;
+  } // if
+
+  for(size_t i(0); i < 2; ++i) {
+    group.run([&group, &count, depth]() {
+      spawn(group, count, depth - 1);
+    });
+  } // for
+} // spawn
+
+// =============================================================================
+// Sum a range by splitting it in nested groups, each waited on by the task
+// that created it.
+// =============================================================================
+
+size_t
+nested_sum(
+  thread_pool & pool,
+  std::atomic<size_t> & tasks,
+  size_t begin,
+  size_t end
+)
+{
+  ++tasks;
+
+  if(end - begin <= 16) {
+    size_t sum(0);
+    for(size_t i(begin); i < end; ++i) {
+      sum += i;
+    } // for
+    return sum;
+  } // if
+
+  const size_t mid = begin + (end - begin)/2;
+  size_t left(0);
+  size_t right(0);
+
+  task_group group(pool);
+  group.run([&]() { left = nested_sum(pool, tasks, begin, mid); });
+  group.run([&]() { right = nested_sum(pool, tasks, mid, end); });
+  group.wait();
+
+  return left + right;
+} // nested_sum
+
+// TEST
+TEST(thread_pool, task_group_recursion)
+{
+  thread_pool pool;
+  pool.start(3);
+
+  // Every task of the tree runs exactly once.
+  for(size_t depth : { 0, 1, 10, 14 }) {
+    std::atomic<size_t> count(0);
+
+    {
+    task_group group(pool);
+    group.run([&]() { spawn(group, count, depth); });
+    group.wait();
+    } // scope
+
+    EXPECT_EQ((size_t(1) << (depth + 1)) - 1, count.load());
+  } // for
+
+  // Tasks that wait on their own groups do not deadlock, even with more
+  // waiting tasks than workers. 4096 indices in leaves of 16 give a full
+  // binary tree of 511 tasks.
+  std::atomic<size_t> tasks(0);
+  EXPECT_EQ(4096*4095/2, nested_sum(pool, tasks, 0, 4096));
+  EXPECT_EQ(511, tasks.load());
+} // TEST
+
+// TEST
+TEST(thread_pool, queue_wait_all)
+{
+  thread_pool pool;
+  pool.start(3);
+
+  std::atomic<size_t> sum(0);
+
+  // Arguments are copied into the task.
+  for(size_t i(0); i < 1000; ++i) {
+    pool.queue([&sum](size_t a, size_t b) { sum += a*b; }, i, 2);
+  } // for
+
+  pool.wait_all();
+  EXPECT_EQ(999*1000, sum.load());
+
+  // wait_all() also waits on the tasks queued by tasks.
+  sum = 0;
+  for(size_t i(0); i < 100; ++i) {
+    pool.queue([&pool, &sum]() {
+      for(size_t j(0); j < 10; ++j) {
+        pool.queue([&sum]() { ++sum; });
+      } // for
+    });
+  } // for
+
+  pool.wait_all();
+  EXPECT_EQ(1000, sum.load());
+
+  // Without workers, the waiting thread runs every task.
+  thread_pool serial;
+  EXPECT_EQ(0, serial.num_threads());
+
+  sum = 0;
+  for(size_t i(0); i < 10; ++i) {
+    serial.queue([&sum]() { ++sum; });
+  } // for
+
+  serial.wait_all();
+  EXPECT_EQ(10, sum.load());
+} // TEST
+
+// TEST
+TEST(thread_pool, large_callable)
+{
+  // A capture larger than the inline storage falls back to the heap.
+  std::array<size_t, 2*pool_task_t::inline_size/sizeof(size_t)> values;
+  ASSERT_GT(sizeof(values), pool_task_t::inline_size);
+
+  for(size_t i(0); i < values.size(); ++i) {
+    values[i] = i;
+  } // for
+
+  const size_t expected = values.size()*(values.size() - 1)/2;
+
+  // The heap callable is moved, run and destroyed exactly once.
+  auto owner = std::make_shared<int>(0);
+
+  {
+  size_t result(0);
+  pool_task_t t([values, owner, &result]() {
+    for(auto v : values) {
+      result += v;
+    } // for
+  });
+  EXPECT_EQ(2, owner.use_count());
+
+  pool_task_t moved(std::move(t));
+  EXPECT_FALSE(bool(t));
+  EXPECT_TRUE(bool(moved));
+  EXPECT_EQ(2, owner.use_count());
+
+  moved();
+  EXPECT_EQ(expected, result);
+
+  moved.reset();
+  EXPECT_FALSE(bool(moved));
+  EXPECT_EQ(1, owner.use_count());
+  } // scope
+
+  // The same through the pool.
+  thread_pool pool;
+  pool.start(2);
+
+  std::atomic<size_t> sum(0);
+
+  for(size_t i(0); i < 64; ++i) {
+    pool.queue([values, owner, &sum]() {
+      for(auto v : values) {
+        sum += v;
+      } // for
+    });
+  } // for
+
+  pool.wait_all();
+  EXPECT_EQ(64*expected, sum.load());
+  EXPECT_EQ(1, owner.use_count());
+} // TEST
+
+// TEST
+TEST(thread_pool, join_drains)
+{
+  std::atomic<size_t> count(0);
+
+  {
+  thread_pool pool;
+  pool.start(2);
+
+  for(size_t i(0); i < 200; ++i) {
+    pool.queue([&count]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      ++count;
+    });
+  } // for
+
+  // join() completes the queued tasks before stopping the workers.
+  pool.join();
+  EXPECT_EQ(200, count.load());
+
+  // A second join(), e.g., from the destructor, is a no-op.
+  pool.join();
+  } // scope
+
+  // The destructor joins as well.
+  count = 0;
+
+  {
+  thread_pool pool;
+  pool.start(2);
+
+  for(size_t i(0); i < 200; ++i) {
+    pool.queue([&count]() { ++count; });
+  } // for
+  } // scope
+
+  EXPECT_EQ(200, count.load());
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
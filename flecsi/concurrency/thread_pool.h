@@ -15,18 +15,18 @@
 #ifndef flecsi_thread_pool_h
 #define flecsi_thread_pool_h
 
-#include <iostream>
-#include <vector>
-#include <deque>
 #include <algorithm>
-#include <functional>
-#include <thread>
-#include <mutex>
 #include <atomic>
+#include <cassert>
 #include <condition_variable>
-#include <queue>
-
-#include "flecsi/concurrency/virtual_semaphore.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /*!
  * \file thread_pool.h
@@ -37,64 +37,300 @@
 namespace flecsi
 {
 
-  class thread_pool{
+  /*!
+    A move-only, type-erased void() callable. Callables of up to
+    inline_size bytes, e.g., lambdas capturing a handful of references,
+    are stored in place, so submitting them to a thread_pool does not
+    allocate. Larger callables fall back to the heap.
+   */
+  class pool_task_t{
   public:
-    using function_t = std::function<void(void)>;
+    static constexpr size_t inline_size = 128;
 
-    thread_pool(){
-      done_ = false;
+    pool_task_t(){}
+
+    template<
+      typename F,
+      typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, pool_task_t>::value
+      >::type
+    >
+    pool_task_t(F&& f){
+      using callable_t = typename std::decay<F>::type;
+      using ops_t = ops__<callable_t,
+        (sizeof(callable_t) <= inline_size &&
+         alignof(callable_t) <= alignof(std::max_align_t))>;
+
+      ops_t::construct(storage_, std::forward<F>(f));
+      invoke_ = &ops_t::invoke;
+      move_ = &ops_t::move;
+      destroy_ = &ops_t::destroy;
     }
 
-    ~thread_pool(){
-      join();
+    pool_task_t(pool_task_t&& t){
+      move_from_(t);
     }
 
-    void run_(){
-      for(;;){
-        sem_.acquire();
+    pool_task_t& operator=(pool_task_t&& t){
+      if(this != &t){
+        reset();
+        move_from_(t);
+      }
+      return *this;
+    }
 
-        mutex_.lock();
+    pool_task_t(const pool_task_t&) = delete;
+    pool_task_t& operator=(const pool_task_t&) = delete;
 
-        if(done_){
-          mutex_.unlock();
-          return;
+    ~pool_task_t(){
+      reset();
+    }
+
+    void operator()(){
+      invoke_(storage_);
+    }
+
+    explicit operator bool() const{
+      return invoke_ != nullptr;
+    }
+
+    void reset(){
+      if(destroy_){
+        destroy_(storage_);
+      }
+
+      invoke_ = nullptr;
+      move_ = nullptr;
+      destroy_ = nullptr;
+    }
+
+  private:
+
+    template<
+      typename F,
+      bool INLINE
+    >
+    struct ops__{
+      template<typename G>
+      static void construct(void* s, G&& g){
+        new (s) F(std::forward<G>(g));
+      }
+
+      static F* get(void* s){
+        return static_cast<F*>(s);
+      }
+
+      static void invoke(void* s){
+        (*get(s))();
+      }
+
+      static void move(void* d, void* s){
+        new (d) F(std::move(*get(s)));
+        get(s)->~F();
+      }
+
+      static void destroy(void* s){
+        get(s)->~F();
+      }
+    }; // struct ops__
+
+    template<
+      typename F
+    >
+    struct ops__<F, false>{
+      template<typename G>
+      static void construct(void* s, G&& g){
+        *static_cast<F**>(s) = new F(std::forward<G>(g));
+      }
+
+      static F* get(void* s){
+        return *static_cast<F**>(s);
+      }
+
+      static void invoke(void* s){
+        (*get(s))();
+      }
+
+      static void move(void* d, void* s){
+        *static_cast<F**>(d) = get(s);
+      }
+
+      static void destroy(void* s){
+        delete get(s);
+      }
+    }; // struct ops__
+
+    void move_from_(pool_task_t& t){
+      if(t.invoke_){
+        t.move_(storage_, t.storage_);
+        invoke_ = t.invoke_;
+        move_ = t.move_;
+        destroy_ = t.destroy_;
+
+        t.invoke_ = nullptr;
+        t.move_ = nullptr;
+        t.destroy_ = nullptr;
+      }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[inline_size];
+    void (*invoke_)(void*) = nullptr;
+    void (*move_)(void*, void*) = nullptr;
+    void (*destroy_)(void*) = nullptr;
+  }; // class pool_task_t
+
+  /*!
+    A double-ended task queue stored in a growable ring buffer. The owning
+    thread pushes and pops at the back (LIFO, for locality), while other
+    threads steal from the front (FIFO, taking the oldest and typically
+    largest pieces of work). Each deque has its own lock, so threads only
+    contend when stealing from the same victim.
+   */
+  class work_deque_t{
+  public:
+
+    work_deque_t()
+    : ring_(64){}
+
+    void push(pool_task_t&& t){
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if(size_ == ring_.size()){
+        std::vector<pool_task_t> ring(ring_.size() * 2);
+
+        for(size_t i = 0; i < size_; ++i){
+          ring[i] = std::move(ring_[(head_ + i) & (ring_.size() - 1)]);
         }
 
-        auto f = queue_.front();
-        queue_.pop();
-        mutex_.unlock();
-        f();
+        ring_.swap(ring);
+        head_ = 0;
+      }
+
+      ring_[(head_ + size_) & (ring_.size() - 1)] = std::move(t);
+      ++size_;
+      count_.store(size_, std::memory_order_relaxed);
+    }
+
+    bool pop(pool_task_t& t){
+      if(count_.load(std::memory_order_relaxed) == 0){
+        return false;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if(size_ == 0){
+        return false;
+      }
+
+      --size_;
+      t = std::move(ring_[(head_ + size_) & (ring_.size() - 1)]);
+      count_.store(size_, std::memory_order_relaxed);
+      return true;
+    }
+
+    bool steal(pool_task_t& t){
+      if(count_.load(std::memory_order_relaxed) == 0){
+        return false;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if(size_ == 0){
+        return false;
       }
+
+      t = std::move(ring_[head_]);
+      head_ = (head_ + 1) & (ring_.size() - 1);
+      --size_;
+      count_.store(size_, std::memory_order_relaxed);
+      return true;
     }
 
+  private:
+    std::mutex mutex_;
+    std::vector<pool_task_t> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    std::atomic<size_t> count_{0};
+  }; // class work_deque_t
+
+  /*!
+    A work-stealing thread pool. Every worker owns a deque of tasks: tasks
+    queued from a worker go to the back of its own deque, and idle workers
+    steal from the front of the other deques. Tasks queued from outside of
+    the pool go to a shared injection deque. Threads that wait on the pool,
+    through wait_all() or task_group::wait(), execute queued tasks instead
+    of blocking, so tasks may queue and wait on further tasks.
+   */
+  class thread_pool{
+  public:
+
+    thread_pool(){
+      deques_.emplace_back(new work_deque_t);
+    }
+
+    ~thread_pool(){
+      join();
+    }
+
+    /*!
+      Queue the callable f, to be called with copies of args.
+     */
     template <typename FT, typename... ARGS>
     void queue(FT f, ARGS... args){
-      mutex_.lock();
-      queue_.emplace(std::bind(f, std::forward<ARGS>(args)...));
-      mutex_.unlock();
-      sem_.release();
+      submit_([f, args...]() mutable { f(args...); });
     }
 
+    /*!
+      Start num_threads worker threads. This must be called at most once,
+      before tasks are queued from more than one thread.
+     */
     void start(size_t num_threads){
       assert(threads_.empty() && "thread pool already started");
 
       for(size_t i = 0; i < num_threads; ++i){
-        auto t = new std::thread(&thread_pool::run_, this);
-        threads_.push_back(t);
+        deques_.emplace_back(new work_deque_t);
+      }
+
+      threads_.reserve(num_threads);
+
+      for(size_t i = 0; i < num_threads; ++i){
+        threads_.emplace_back(&thread_pool::run_, this, i + 1);
+      }
+    }
+
+    /*!
+      Wait until every queued task, including the tasks that those tasks
+      queue, has completed. The calling thread executes tasks while it
+      waits.
+     */
+    void wait_all(){
+      while(outstanding_.load(std::memory_order_acquire) > 0){
+        if(!try_run_one()){
+          std::this_thread::yield();
+        }
       }
     }
 
+    /*!
+      Complete all of the queued tasks and stop the worker threads.
+     */
     void join(){
       if(done_){
         return;
       }
 
-      done_ = true;
-      sem_.interrupt();
+      wait_all();
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+      }
+
+      cv_.notify_all();
 
-      for(auto t : threads_){
-        t->join();
-        delete t;
+      for(auto& t : threads_){
+        t.join();
       }
     }
 
@@ -102,14 +338,163 @@ namespace flecsi
       return threads_.size();
     }
 
+    /*!
+      Execute one queued task on the calling thread, if one is available.
+      Returns true if a task was executed.
+     */
+    bool try_run_one(){
+      pool_task_t t;
+
+      if(!take_(t)){
+        return false;
+      }
+
+      t();
+      t.reset();
+      outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+
+      return true;
+    }
+
   private:
+
+    friend class task_group;
+
+    struct worker_t{
+      thread_pool* pool = nullptr;
+      size_t index = 0;
+    }; // struct worker_t
+
+    static worker_t& this_worker_(){
+      static thread_local worker_t worker;
+      return worker;
+    }
+
+    // Index of the deque owned by the calling thread, or 0 (the injection
+    // deque) if the calling thread is not a worker of this pool.
+    size_t own_deque_() const{
+      const worker_t& w = this_worker_();
+      return w.pool == this ? w.index : 0;
+    }
+
+    void submit_(pool_task_t&& t){
+      outstanding_.fetch_add(1, std::memory_order_relaxed);
+      deques_[own_deque_()]->push(std::move(t));
+      pending_.fetch_add(1, std::memory_order_seq_cst);
+
+      if(sleeping_.load(std::memory_order_seq_cst) > 0){
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+      }
+    }
+
+    bool take_(pool_task_t& t){
+      const size_t n = deques_.size();
+      const size_t own = own_deque_();
+
+      if(deques_[own]->pop(t)){
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      for(size_t i = 1; i < n; ++i){
+        if(deques_[(own + i) % n]->steal(t)){
+          pending_.fetch_sub(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void run_(size_t index){
+      this_worker_().pool = this;
+      this_worker_().index = index;
+
+      constexpr size_t spins = 64;
+
+      for(;;){
+        bool found = false;
+
+        for(size_t i = 0; i < spins && !found; ++i){
+          found = try_run_one();
+
+          if(!found){
+            std::this_thread::yield();
+          }
+        }
+
+        if(found){
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+
+        cv_.wait(lock, [this]{
+          return done_ || pending_.load(std::memory_order_seq_cst) > 0;
+        });
+
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+
+        if(done_){
+          return;
+        }
+      }
+    }
+
+    std::vector<std::unique_ptr<work_deque_t>> deques_;
+    std::vector<std::thread> threads_;
     std::mutex mutex_;
-    std::queue<function_t> queue_;
-    std::vector<std::thread*> threads_;
-    virtual_semaphore sem_;
-    std::atomic_bool done_;
+    std::condition_variable cv_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> outstanding_{0};
+    std::atomic<size_t> sleeping_{0};
+    bool done_ = false;
   };
 
+  /*!
+    A set of tasks that can be waited on as a whole. Tasks run by a group
+    may run further tasks in the same group, e.g., for a recursive
+    traversal. wait() returns once all of them have completed, and the
+    waiting thread executes queued tasks in the meantime.
+   */
+  class task_group{
+  public:
+
+    explicit task_group(thread_pool& pool)
+    : pool_(pool){}
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    ~task_group(){
+      wait();
+    }
+
+    template<typename F>
+    void run(F&& f){
+      count_.fetch_add(1, std::memory_order_relaxed);
+
+      pool_.submit_([this, f = std::forward<F>(f)]() mutable {
+        f();
+        count_.fetch_sub(1, std::memory_order_release);
+      });
+    }
+
+    void wait(){
+      while(count_.load(std::memory_order_acquire) > 0){
+        if(!pool_.try_run_one()){
+          std::this_thread::yield();
+        }
+      }
+    }
+
+  private:
+    thread_pool& pool_;
+    std::atomic<size_t> count_{0};
+  }; // class task_group
+
 } // namespace flecsi
 
 #endif // flecsi_thread_pool_h
@@ -37,6 +37,13 @@ class mesh_topology_t;
 template<size_t, size_t>
 class mesh_entity_t;
 
+//----------------------------------------------------------------------------//
+// Forward declaration
+//----------------------------------------------------------------------------//
+
+template<typename>
+class structured_mesh_topology_t;
+
 } // namespace topology
 
 namespace data {
@@ -389,6 +396,42 @@ struct data_client_policy_handler__<topology::mesh_topology_t<POLICY_TYPE>>
 
 }; // struct data_client_policy_handler__
 
+//----------------------------------------------------------------------------//
+//! Structured topologies compute their entities and connectivity from
+//! their box of cells, so their handles only carry the client hashes and
+//! the local box of the mesh type.
+//----------------------------------------------------------------------------//
+
+template<typename MESH_TYPE>
+struct data_client_policy_handler__<
+  topology::structured_mesh_topology_t<MESH_TYPE>>
+{
+
+  template<
+    typename DATA_CLIENT_TYPE,
+    size_t NAMESPACE_HASH,
+    size_t NAME_HASH
+  >
+  static
+  data_client_handle__<DATA_CLIENT_TYPE, 0>
+  get_client_handle()
+  {
+    data_client_handle__<DATA_CLIENT_TYPE, 0> h;
+
+    h.client_hash = 
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code();
+    h.namespace_hash = NAMESPACE_HASH;
+    h.name_hash = NAME_HASH;
+    h.num_handle_entities = 0;
+    h.num_handle_adjacencies = 0;
+
+    h.initialize(DATA_CLIENT_TYPE::local_box());
+
+    return h;
+  } // get_client_handle
+
+}; // struct data_client_policy_handler__
+
 
 template<
   typename DATA_POLICY
@@ -14,12 +14,14 @@
 #include <cinchlog.h>
 #include <string>
 #include <tuple>
+#include <typeinfo>
 
 #include "flecsi/execution/context.h"
 #include "flecsi/data/data_constants.h"
 #include "flecsi/data/storage.h"
 #include "flecsi/runtime/types.h"
 #include "flecsi/topology/mesh_topology.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 #include "flecsi/utils/hash.h"
 #include "flecsi/utils/tuple_walker.h"
 #include "flecsi/utils/common.h"
@@ -63,6 +65,7 @@ struct field_registration_wrapper__
 
     fi.storage_type = STORAGE_TYPE;
     fi.size = sizeof(DATA_TYPE);
+    fi.type_hash = typeid(DATA_TYPE).hash_code();
     fi.namespace_hash = NAMESPACE_HASH;
     fi.name_hash = NAME_HASH;
     fi.versions = VERSIONS;
@@ -374,6 +377,32 @@ struct client_registration_wrapper__<
 
 }; // class client_registration_wrapper__
 
+//----------------------------------------------------------------------------//
+//! Structured topologies have no internal fields: their entities and
+//! connectivity are computed from their box of cells.
+//----------------------------------------------------------------------------//
+
+template<
+  typename MESH_TYPE,
+  size_t NAMESPACE_HASH,
+  size_t NAME_HASH
+>
+struct client_registration_wrapper__<
+  flecsi::topology::structured_mesh_topology_t<MESH_TYPE>,
+  NAMESPACE_HASH,
+  NAME_HASH
+>
+{
+  static
+  void
+  register_callback(
+    field_id_t
+  )
+  {
+  } // register_callback
+
+}; // class client_registration_wrapper__
+
 } // namespace data
 } // namespace flecsi
 
@@ -158,6 +158,8 @@ struct field_data__
   //! @tparam NAMESPACE_HASH The namespace key. Namespaces allow separation
   //!                        of attribute names to avoid collisions.
   //! @tparam PREDICATE      The data version.
+  //! @tparam DATA_CLIENT_TYPE The data client type, which selects the
+  //!                        registered fields.
   //!
   //! @param client    The data client instance.
   //! @param version   The data version to return.
@@ -172,22 +174,24 @@ struct field_data__
     size_t STORAGE_TYPE,
     typename DATA_TYPE,
     size_t NAMESPACE_HASH,
-    typename PREDICATE
+    typename PREDICATE,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & client,
+    const DATA_CLIENT_TYPE & client,
     size_t version,
     PREDICATE && predicate,
     bool sorted = true
   )
   {
-    return DATA_POLICY::template get_handles<
-      STORAGE_TYPE,
+    using storage_type_t =
+      typename DATA_POLICY::template storage_type__<STORAGE_TYPE>;
+
+    return storage_type_t::template get_handles<
       DATA_TYPE,
-      NAMESPACE_HASH,
-      PREDICATE
+      NAMESPACE_HASH
     >
     (client, version, std::forward<PREDICATE>(predicate), sorted);
   } // get_handles
@@ -200,6 +204,8 @@ struct field_data__
   //! @tparam DATA_TYPE    The data type, e.g., double. This may be P.O.D.
   //!                      or a user-defined type that is trivially-copyable.
   //! @tparam PREDICATE    The data version.
+  //! @tparam DATA_CLIENT_TYPE The data client type, which selects the
+  //!                      registered fields.
   //!
   //! @param client    The data client instance.
   //! @param version   The data version to return.
@@ -213,21 +219,23 @@ struct field_data__
   template<
     size_t STORAGE_TYPE,
     typename DATA_TYPE,
-    typename PREDICATE
+    typename PREDICATE,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & client,
+    const DATA_CLIENT_TYPE & client,
     size_t version,
     PREDICATE && predicate,
     bool sorted = true
   )
   {
-    return DATA_POLICY::template get_handles<
-      STORAGE_TYPE,
-      DATA_TYPE,
-      PREDICATE
+    using storage_type_t =
+      typename DATA_POLICY::template storage_type__<STORAGE_TYPE>;
+
+    return storage_type_t::template get_handles<
+      DATA_TYPE
     >
     (client, version, std::forward<PREDICATE>(predicate), sorted);
   } // get_handles
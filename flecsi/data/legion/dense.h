@@ -102,9 +102,11 @@ struct dense_handle_t :
     Legion::Context& context = base_t::context;
 
     // Unmap physical regions and copy back out ex/sh/gh regions if we
-    // have write permissions 
+    // have write permissions. Nothing is copied when the handle is bound
+    // directly to the region data, e.g., with mapper compaction.
 
-    if(base_t::exclusive_data){
+    if(base_t::exclusive_data &&
+      base_t::exclusive_data != base_t::exclusive_buf){
       if(base_t::exclusive_priv > privilege_t::ro){
         std::memcpy(base_t::exclusive_buf, base_t::exclusive_data,
                     base_t::exclusive_size * sizeof(T));
@@ -112,7 +114,7 @@ struct dense_handle_t :
 
     }
 
-    if(base_t::shared_data){
+    if(base_t::shared_data && base_t::shared_data != base_t::shared_buf){
       if(base_t::shared_priv > privilege_t::ro){
         std::memcpy(base_t::shared_buf, base_t::shared_data,
                     base_t::shared_size * sizeof(T));
@@ -123,7 +125,8 @@ struct dense_handle_t :
     // ghost is never mapped with write permissions
 
 #ifndef MAPPER_COMPACTION
-    if(base_t::master && base_t::combined_data){
+    if(base_t::master && base_t::combined_data &&
+      base_t::combined_data != base_t::exclusive_buf){
       delete[] base_t::combined_data;
     }
 #ifdef COMPACTED_STORAGE_SORT
@@ -432,69 +435,101 @@ struct storage_type__<dense>
   //--------------------------------------------------------------------------//
 
   ///
-  //
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client that satisfy a predicate. The fields are looked up in
+  /// the typed field index of the context, and are returned in
+  /// (namespace hash, name hash) order, which is the same on every rank.
+  /// The \e sorted flag is accepted for interface compatibility.
   ///
   template<
     typename T,
     size_t NAMESPACE,
-    typename Predicate
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & data_client,
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     Predicate && predicate,
     bool sorted
   )
   {
+    auto fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code(), NAMESPACE);
 
-  }
+    return get_handles_<T>(fields.first, fields.second, version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
 
+  ///
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client that satisfy a predicate.
+  ///
   template<
     typename T,
-    typename Predicate
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & data_client,
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     Predicate && predicate,
     bool sorted
   )
   {
-    
-  }
+    auto & fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code());
 
+    return get_handles_<T>(fields.begin(), fields.end(), version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
+
+  ///
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client.
+  ///
   template<
     typename T,
-    size_t NAMESPACE
+    size_t NAMESPACE,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & data_client,
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     bool sorted
   )
   {
-    
-  }
+    return get_handles<T, NAMESPACE>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
 
+  ///
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client.
+  ///
   template<
-    typename T
+    typename T,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
   get_handles(
-    const data_client_t & data_client,
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     bool sorted
   )
   {
-
-  }
+    return get_handles<T>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
 
   ///
   //
@@ -516,15 +551,32 @@ struct storage_type__<dense>
     static_assert(VERSION < utils::hash::field_max_versions,
       "max field version exceeded");
 
-    handle_t<DATA_TYPE, 0, 0, 0> h;
-
-    auto& context = execution::context_t::instance();
-    
     auto& field_info = 
-      context.get_field_info(
+      execution::context_t::instance().get_field_info(
         typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
       utils::hash::field_hash<NAMESPACE, NAME>(VERSION));
 
+    return make_handle<DATA_TYPE>(field_info);
+  } // get_handle
+
+private:
+
+  ///
+  /// Build the handle of a registered field.
+  ///
+  template<
+    typename DATA_TYPE
+  >
+  static
+  handle_t<DATA_TYPE, 0, 0, 0>
+  make_handle(
+    const execution::context_t::field_info_t & field_info
+  )
+  {
+    handle_t<DATA_TYPE, 0, 0, 0> h;
+
+    auto& context = execution::context_t::instance();
+
     size_t index_space = field_info.index_space;
     auto& ism = context.index_space_data_map();
 
@@ -558,7 +610,42 @@ struct storage_type__<dense>
     h.state = context.execution_state();
 
     return h;
-  } // get_handle
+  } // make_handle
+
+  ///
+  /// Build the handles of the fields in [first, last) that have the given
+  /// version and satisfy a predicate.
+  ///
+  template<
+    typename T,
+    typename ITERATOR,
+    typename Predicate
+  >
+  static
+  std::vector<handle_t<T, 0, 0, 0>>
+  get_handles_(
+    ITERATOR first,
+    ITERATOR last,
+    size_t version,
+    Predicate && predicate
+  )
+  {
+    std::vector<handle_t<T, 0, 0, 0>> handles;
+
+    for(; first != last; ++first) {
+      if(utils::hash::field_hash_version((*first)->key) != version) {
+        continue;
+      } // if
+
+      auto h = make_handle<T>(**first);
+
+      if(predicate(h)) {
+        handles.emplace_back(std::move(h));
+      } // if
+    } // for
+
+    return handles;
+  } // get_handles_
 
 }; // struct storage_type__
 
@@ -30,10 +30,12 @@
 #include "flecsi/data/data_handle.h"
 #include "flecsi/execution/context.h"
 #include "flecsi/utils/const_string.h"
+#include "flecsi/utils/hash.h"
 #include "flecsi/utils/index_space.h"
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 ///
 /// \file
@@ -466,6 +468,107 @@ struct storage_type__<dense>
   >
   using handle_t = dense_handle_t<T, EP, SP, GP>;
 
+  //--------------------------------------------------------------------------//
+  // Data handles.
+  //--------------------------------------------------------------------------//
+
+  ///
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client that satisfy a predicate. The fields are looked up in
+  /// the typed field index of the context, and are returned in
+  /// (namespace hash, name hash) order, which is the same on every rank.
+  /// The \e sorted flag is accepted for interface compatibility.
+  ///
+  template<
+    typename T,
+    size_t NAMESPACE,
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
+  >
+  static
+  decltype(auto)
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
+    size_t version,
+    Predicate && predicate,
+    bool sorted
+  )
+  {
+    auto fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code(), NAMESPACE);
+
+    return get_handles_<T>(fields.first, fields.second, version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
+
+  ///
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client that satisfy a predicate.
+  ///
+  template<
+    typename T,
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
+  >
+  static
+  decltype(auto)
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
+    size_t version,
+    Predicate && predicate,
+    bool sorted
+  )
+  {
+    auto & fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code());
+
+    return get_handles_<T>(fields.begin(), fields.end(), version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
+
+  ///
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client.
+  ///
+  template<
+    typename T,
+    size_t NAMESPACE,
+    typename DATA_CLIENT_TYPE
+  >
+  static
+  decltype(auto)
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
+    size_t version,
+    bool sorted
+  )
+  {
+    return get_handles<T, NAMESPACE>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
+
+  ///
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client.
+  ///
+  template<
+    typename T,
+    typename DATA_CLIENT_TYPE
+  >
+  static
+  decltype(auto)
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
+    size_t version,
+    bool sorted
+  )
+  {
+    return get_handles<T>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
+
   template<
     typename DATA_CLIENT_TYPE,
     typename DATA_TYPE,
@@ -479,18 +582,33 @@ struct storage_type__<dense>
     const data_client_t & data_client
   )
   {
-    handle_t<DATA_TYPE, 0, 0, 0> h;
-
-    auto& context = execution::context_t::instance();
-  
-    using client_type = typename DATA_CLIENT_TYPE::type_identifier_t;
-
     // get field_info for this data handle
     auto& field_info =
-      context.get_field_info(
+      execution::context_t::instance().get_field_info(
         typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
       utils::hash::field_hash<NAMESPACE, NAME>(VERSION));
 
+    return make_handle<DATA_TYPE>(field_info);
+  } // get_handle
+
+private:
+
+  ///
+  /// Build the handle of a registered field.
+  ///
+  template<
+    typename DATA_TYPE
+  >
+  static
+  handle_t<DATA_TYPE, 0, 0, 0>
+  make_handle(
+    const execution::context_t::field_info_t & field_info
+  )
+  {
+    handle_t<DATA_TYPE, 0, 0, 0> h;
+
+    auto& context = execution::context_t::instance();
+
     // get color_info for this field.
     auto& color_info = (context.coloring_info(field_info.index_space)).at(context.color());
     auto &index_coloring = context.coloring(field_info.index_space);
@@ -505,7 +623,7 @@ struct storage_type__<dense>
       context.register_field_data(field_info.fid,
                                   size);
       context.register_field_metadata<DATA_TYPE>(field_info.fid,
-                                                 color_info,
+                                                 field_info.index_space,
                                                  index_coloring);
     }
 
@@ -531,7 +649,42 @@ struct storage_type__<dense>
     hb.combined_size += color_info.ghost;
 
     return h;
-  }
+  } // make_handle
+
+  ///
+  /// Build the handles of the fields in [first, last) that have the given
+  /// version and satisfy a predicate.
+  ///
+  template<
+    typename T,
+    typename ITERATOR,
+    typename Predicate
+  >
+  static
+  std::vector<handle_t<T, 0, 0, 0>>
+  get_handles_(
+    ITERATOR first,
+    ITERATOR last,
+    size_t version,
+    Predicate && predicate
+  )
+  {
+    std::vector<handle_t<T, 0, 0, 0>> handles;
+
+    for(; first != last; ++first) {
+      if(utils::hash::field_hash_version((*first)->key) != version) {
+        continue;
+      } // if
+
+      auto h = make_handle<T>(**first);
+
+      if(predicate(h)) {
+        handles.emplace_back(std::move(h));
+      } // if
+    } // for
+
+    return handles;
+  } // get_handles_
 
 }; // struct storage_type_t
 
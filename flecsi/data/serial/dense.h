@@ -27,11 +27,14 @@
 #include "flecsi/data/common/data_types.h"
 #include "flecsi/data/data_client.h"
 #include "flecsi/data/data_handle.h"
+#include "flecsi/execution/context.h"
 #include "flecsi/utils/const_string.h"
+#include "flecsi/utils/hash.h"
 #include "flecsi/utils/index_space.h"
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 ///
 /// \file
@@ -546,319 +549,196 @@ struct storage_type__<dense>
     return get_accessor<T,NS>(data_store, hash, version);
   } // get_accessor
 
+  //--------------------------------------------------------------------------//
+  // Data handles.
+  //--------------------------------------------------------------------------//
 
-  /// \brief Return a list of all denst_handle_t's filtered by a predicate.
   ///
-  /// \param [in] data_client The data client to restrict our search to.
-  /// \param [in] data_store The data store to search.
-  /// \param [in] version The version to select.
-  /// \param [in] predicate If \e predicate(a) returns true, add the accessor
-  ///                       to the list.
-  /// \param [in] sorted If true, sort the results by label lexographically.
   ///
-  /// \remark This version is confined to search within a single namespace.
+  ///
   template<
     typename T,
     size_t NS,
-    typename Predicate
+    size_t PS
   >
   static
-  decltype(auto)
-  get_accessors(
+  handle_t<T, PS>
+  get_handle(
     const data_client_t & data_client,
     data_store_t & data_store,
-    size_t version,
-    Predicate && predicate,
-    bool sorted
+    const utils::const_string_t & key,
+    size_t version
   )
   {
+    auto hash = key.hash() ^ data_client.runtime_id();
+    auto& m = data_store[NS];
+    auto search = m.find(hash);
+    assert(search != m.end() && "invalid hash");
+    auto& md = search->second;
 
-    std::vector< accessor_t<T> > as;
-
-    // the runtime id
-    auto runtime_id = data_client.runtime_id();
-
-    // loop over each key pair
-    for (auto & entry_pair : data_store[NS]) {
-      // get the meta data key and label
-      const auto & meta_data_key = entry_pair.first;
-      auto & meta_data = entry_pair.second;
-      // now build the hash for this label
-      const auto & label = meta_data.label;
-      auto key_hash = 
-        utils::hash<utils::const_string_t::hash_type_t>(label, label.size());
-      auto hash = key_hash ^ runtime_id;
-      // filter out the accessors for different data_clients
-      if ( meta_data_key != hash ) continue;
-      // if the reconstructed hash matches the meta data key,
-      // then we may want this one
-      auto a = get_accessor<T>( meta_data, version );
-      if ( a )
-        if (meta_data.rtti->type_info == typeid(T) && predicate(a))
-          as.emplace_back( std::move(a) );
-    } // for
+    assert(version < md.versions && "version out of range");
 
-    // if sorting is requested
-    if (sorted) 
-      std::sort( 
-        as.begin(), as.end(), 
-        [](const auto & a, const auto &b) { return a.label()<b.label(); } 
-      );
+    handle_t<T, PS> h;
+    h.data = &md.data[version][0];
+    h.size = md.size;
 
-    return as;
-  
-  } // get_accessor
+    return h;
+  } // get_handle
+#endif
 
+  template<
+    typename DATA_CLIENT_TYPE,
+    typename DATA_TYPE,
+    size_t NAMESPACE,
+    size_t NAME,
+    size_t VERSION
+  >
+  static
+  handle_t<DATA_TYPE, 0, 0, 0>
+  get_handle(
+    const data_client_t & data_client
+  )
+  {
+    handle_t<DATA_TYPE, 0, 0, 0> h;
+
+
+    return h;
+  }
 
-  /// \brief Return a list of all denst_handle_t's filtered by a predicate.
   ///
-  /// \param [in] data_client  The data client to restrict our search to.
-  /// \param [in] data_store   The data store to search.
-  /// \param [in] version   The version to select.
-  /// \param [in] predicate   If \e predicate(a) returns true, add the accessor
-  ///                         to the list.
-  /// \param [in] sorted  If true, sort the results by label lexographically.
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client that satisfy a predicate. The fields are looked up in
+  /// the typed field index of the context, and are returned in
+  /// (namespace hash, name hash) order. The \e sorted flag is accepted for
+  /// interface compatibility.
   ///
-  /// \remark This version searches all namespaces.
   template<
     typename T,
-    typename Predicate
+    size_t NAMESPACE,
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
-  get_accessors(
-    const data_client_t & data_client,
-    data_store_t & data_store,
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     Predicate && predicate,
     bool sorted
   )
   {
+    auto fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code(), NAMESPACE);
 
-    std::vector< accessor_t<T> > as;
-
-    // the runtime id
-    auto runtime_id = data_client.runtime_id();
-
-    // check each namespace
-    for (auto & namespace_map : data_store) {
-
-      // the namespace data
-      auto & namespace_key = namespace_map.first;
-      auto & namespace_data = namespace_map.second;
-      
-      // loop over each key pair
-      for (auto & entry_pair : namespace_data) {
-        // get the meta data key and label
-        const auto & meta_data_key = entry_pair.first;
-        auto & meta_data = entry_pair.second;
-        // now build the hash for this label
-        const auto & label = meta_data.label;
-        auto key_hash = 
-          utils::hash<utils::const_string_t::hash_type_t>(label, label.size());
-        auto hash = key_hash ^ runtime_id;
-        // filter out the accessors for different data_clients
-        if ( meta_data_key != hash ) continue;
-        // if the reconstructed hash matches the meta data key,
-        // then we may want this one
-        auto a = get_accessor<T>( meta_data, version );
-        if ( a )
-          if (meta_data.rtti->type_info == typeid(T) && predicate(a))
-            as.emplace_back( std::move(a) );
-      } // for each key pair
-    } // for each namespace
-
-    // if sorting is requested
-    if (sorted) 
-      std::sort( 
-        as.begin(), as.end(), 
-        [](const auto & a, const auto &b) { return a.label()<b.label(); } 
-      );
-
-    return as;
-  
-  } // get_accessor
+    return get_handles_<T>(fields.first, fields.second, version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
 
-  /// \brief Return a list of all denst_handle_t's.
   ///
-  /// \param [in] data_client  The data client to restrict our search to.
-  /// \param [in] data_store   The data store to search.
-  /// \param [in] version   The version to select.
-  /// \param [in] sorted  If true, sort the results by label lexographically.
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client that satisfy a predicate.
   ///
-  /// \remark This version is confined to search within a single namespace
   template<
     typename T,
-    size_t NS
+    typename Predicate,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
-  get_accessors(
-    const data_client_t & data_client,
-    data_store_t & data_store,
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
+    Predicate && predicate,
     bool sorted
   )
   {
+    auto & fields = execution::context_t::instance().fields_of_type(
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
+      dense, typeid(T).hash_code());
 
-    std::vector< accessor_t<T> > as;
-
-    // the runtime id
-    auto runtime_id = data_client.runtime_id();
-
-    // loop over each key pair
-    for (auto & entry_pair : data_store[NS]) {
-      // get the meta data key and label
-      const auto & meta_data_key = entry_pair.first;
-      auto & meta_data = entry_pair.second;
-      // now build the hash for this label
-      const auto & label = meta_data.label;
-      auto key_hash = 
-        utils::hash<utils::const_string_t::hash_type_t>(label, label.size());
-      auto hash = key_hash ^ runtime_id;
-      // filter out the accessors for different data_clients
-      if ( meta_data_key != hash ) continue;
-      // if the reconstructed hash matches the meta data key,
-      // then we may want this one
-      auto a = get_accessor<T>( meta_data, version );
-      if ( a )
-        if (meta_data.rtti->type_info == typeid(T))
-          as.emplace_back( std::move(a) );
-    } // for
-
-    // if sorting is requested
-    if (sorted) 
-      std::sort( 
-        as.begin(), as.end(), 
-        [](const auto & a, const auto &b) { return a.label()<b.label(); } 
-      );
+    return get_handles_<T>(fields.begin(), fields.end(), version,
+      std::forward<Predicate>(predicate));
+  } // get_handles
 
-    return as;
-  
-  } // get_accessor
-
-
-  /// \brief Return a list of all denst_handle_t's.
   ///
-  /// \param [in] data_client  The data client to restrict our search to.
-  /// \param [in] data_store   The data store to search.
-  /// \param [in] version   The version to select.
-  /// \param [in] sorted  If true, sort the results by label lexographically.
+  /// Return the handles of the dense fields of type T in a namespace of a
+  /// data client.
   ///
-  /// \remark This version searches all namespaces.
   template<
-    typename T
+    typename T,
+    size_t NAMESPACE,
+    typename DATA_CLIENT_TYPE
   >
   static
   decltype(auto)
-  get_accessors(
-    const data_client_t & data_client,
-    data_store_t & data_store,
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
     size_t version,
     bool sorted
   )
   {
+    return get_handles<T, NAMESPACE>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
 
-    std::vector< accessor_t<T> > as;
-
-    // the runtime id
-    auto runtime_id = data_client.runtime_id();
-
-    // check each namespace
-    for (auto & namespace_map : data_store) {
-
-      // the namespace data
-      auto & namespace_key = namespace_map.first;
-      auto & namespace_data = namespace_map.second;
-      
-      // loop over each key pair
-      for (auto & entry_pair : namespace_data) {
-        // get the meta data key and label
-        const auto & meta_data_key = entry_pair.first;
-        auto & meta_data = entry_pair.second;
-        // now build the hash for this label
-        const auto & label = meta_data.label;
-        auto key_hash = 
-          utils::hash<utils::const_string_t::hash_type_t>(label, label.size());
-        auto hash = key_hash ^ runtime_id;
-        // filter out the accessors for different data_clients
-        if ( meta_data_key != hash ) continue;
-        // if the reconstructed hash matches the meta data key,
-        // then we may want this one
-        auto a = get_accessor<T>( meta_data, version );
-        if ( a )
-          if (meta_data.rtti->type_info == typeid(T))
-            as.emplace_back( std::move(a) );
-      } // for each key pair
-    } // for each namespace
-
-    // if sorting is requested
-    if (sorted) 
-      std::sort( 
-        as.begin(), as.end(), 
-        [](const auto & a, const auto &b) { return a.label()<b.label(); } 
-      );
-
-    return as;
-  
-  } // get_accessor
-
-
-  //--------------------------------------------------------------------------//
-  // Data handles.
-  //--------------------------------------------------------------------------//
-
-  ///
   ///
+  /// Return the handles of the dense fields of type T in all namespaces
+  /// of a data client.
   ///
   template<
     typename T,
-    size_t NS,
-    size_t PS
+    typename DATA_CLIENT_TYPE
   >
   static
-  handle_t<T, PS>
-  get_handle(
-    const data_client_t & data_client,
-    data_store_t & data_store,
-    const utils::const_string_t & key,
-    size_t version
+  decltype(auto)
+  get_handles(
+    const DATA_CLIENT_TYPE & data_client,
+    size_t version,
+    bool sorted
   )
   {
-    auto hash = key.hash() ^ data_client.runtime_id();
-    auto& m = data_store[NS];
-    auto search = m.find(hash);
-    assert(search != m.end() && "invalid hash");
-    auto& md = search->second;
-
-    assert(version < md.versions && "version out of range");
-
-    handle_t<T, PS> h;
-    h.data = &md.data[version][0];
-    h.size = md.size;
+    return get_handles<T>(data_client, version,
+      [](const auto &) { return true; }, sorted);
+  } // get_handles
 
-    return h;
-  } // get_handle
-#endif
+private:
 
+  ///
+  /// Build the handles of the fields in [first, last) that have the given
+  /// version and satisfy a predicate. Like get_handle, this does not yet
+  /// attach field data, which the serial runtime does not store.
+  ///
   template<
-    typename DATA_CLIENT_TYPE,
-    typename DATA_TYPE,
-    size_t NAMESPACE,
-    size_t NAME,
-    size_t VERSION
+    typename T,
+    typename ITERATOR,
+    typename Predicate
   >
   static
-  handle_t<DATA_TYPE, 0, 0, 0>
-  get_handle(
-    const data_client_t & data_client
+  std::vector<handle_t<T, 0, 0, 0>>
+  get_handles_(
+    ITERATOR first,
+    ITERATOR last,
+    size_t version,
+    Predicate && predicate
   )
   {
-    handle_t<DATA_TYPE, 0, 0, 0> h;
+    std::vector<handle_t<T, 0, 0, 0>> handles;
 
+    for(; first != last; ++first) {
+      if(utils::hash::field_hash_version((*first)->key) != version) {
+        continue;
+      } // if
 
-    return h;
-  }
+      handle_t<T, 0, 0, 0> h;
+
+      if(predicate(h)) {
+        handles.emplace_back(std::move(h));
+      } // if
+    } // for
+
+    return handles;
+  } // get_handles_
 
 }; // struct storage_type__
 
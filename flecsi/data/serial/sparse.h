@@ -17,6 +17,7 @@
 
 #include <map>
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <set>
 #include <unordered_set>
@@ -30,6 +31,7 @@
 #undef POLICY_NAMESPACE
 //----------------------------------------------------------------------------//
 
+#include "flecsi/data/common/data_types.h"
 #include "flecsi/utils/const_string.h"
 #include "flecsi/topology/index_space.h"
 
@@ -95,7 +97,6 @@ struct sparse_accessor_t
   // Type definitions.
   //--------------------------------------------------------------------------//
 
-  using iterator_t = utils::index_space_t::iterator_t;
   using meta_data_t = MD;
   using user_meta_data_t = typename meta_data_t::user_meta_data_t;
 
@@ -303,7 +304,6 @@ struct sparse_mutator_t {
   // Type definitions.
   //--------------------------------------------------------------------------//
 
-  using iterator_t = utils::index_space_t::iterator_t;
   using meta_data_t = MD;
   using user_meta_data_t = typename meta_data_t::user_meta_data_t;
 
@@ -418,6 +418,14 @@ struct sparse_mutator_t {
     return nullptr;
   } // data
 
+  ///
+  /// Merge the old rows, the slot buffers, the overflow map and the
+  /// erasures into freshly sized storage in a single pass over the
+  /// indices. When an entry is set more than once, overflow values take
+  /// precedence over slot values, which take precedence over the
+  /// committed values. Erasures are applied last and ignore entries
+  /// that do not exist.
+  ///
   void
   commit()
   {
@@ -442,119 +450,138 @@ struct sparse_mutator_t {
 
     constexpr size_t ev_bytes = sizeof(entry_value_t);
 
-    size_t s = raw_entries.size();
-    size_t c = raw_entries.capacity();
-    size_t d = (num_indices_ * num_slots_ + spare_map_.size()) * ev_bytes;
+    auto cmp = [](const auto & k1, const auto & k2) -> bool {
+      return k1.entry < k2.entry;
+    };
 
-    if(c - s < d) {
-      //raw_entries.reserve(c * ev_bytes + d);
-      raw_entries.resize(c * ev_bytes + d);
-    } // if
+    // Upper bound on the committed size: nothing is deduplicated yet.
+    size_t num_slot_entries = 0;
 
-    entry_value_t * entries =
-      reinterpret_cast<entry_value_t *>(&raw_entries[0]);
+    for(size_t i = 0; i < num_indices_; ++i) {
+      num_slot_entries += indices_[i];
+    } // for
 
-    entry_value_t * entries_end = entries + s / ev_bytes;
+    size_t max_entries = indices[num_indices_] + num_slot_entries +
+      spare_map_.size();
 
-    for(size_t i = 0; i < num_indices_; ++i) {
-      size_t n = indices_[i];
+    std::vector<uint8_t> merged(max_entries * ev_bytes);
 
-      size_t pos = indices[i];
+    const entry_value_t * entries =
+      reinterpret_cast<const entry_value_t *>(raw_entries.data());
 
-      if(n == 0) {
-        indices[i + 1] = pos;
-        continue;
-      } // if
+    entry_value_t * out =
+      reinterpret_cast<entry_value_t *>(merged.data());
+
+    // Overflow entries for the current index, sorted by entry with the
+    // most recent assignment kept.
+    std::vector<entry_value_t> spare;
+
+    auto sitr = spare_map_.begin();
 
-      auto p = spare_map_.equal_range(i);
+    typename erase_set_t::const_iterator eitr, eend;
 
-      size_t m = distance(p.first, p.second);
+    if(erase_set_) {
+      eitr = erase_set_->begin();
+      eend = erase_set_->end();
+    } // if
+
+    constexpr size_t none = std::numeric_limits<size_t>::max();
 
-      entry_value_t * start = entries_ + i * num_slots_;
-      entry_value_t * end = start + n;
+    size_t old_start = indices[0];
+    size_t pos = 0;
 
-      auto iitr = entries + pos;
+    for(size_t i = 0; i < num_indices_; ++i) {
+      const entry_value_t * oitr = entries + old_start;
+      const entry_value_t * oend = entries + indices[i + 1];
+      old_start = indices[i + 1];
 
-      std::copy(iitr, entries_end, iitr + n + m);
-      std::copy(start, end, iitr);
-      entries_end += n + m;
+      const entry_value_t * bitr = entries_ + i * num_slots_;
+      const entry_value_t * bend = bitr + indices_[i];
 
-      auto cmp = [](const auto & k1, const auto & k2) -> bool {
-        return k1.entry < k2.entry;
-      };
+      spare.clear();
+
+      for(; sitr != spare_map_.end() && sitr->first == i; ++sitr) {
+        spare.push_back(sitr->second);
+      } // for
 
-      auto nitr = iitr + indices[i + 1];
+      if(spare.size() > 1) {
+        std::stable_sort(spare.begin(), spare.end(), cmp);
 
-      std::inplace_merge(iitr, nitr, nitr + n, cmp);
+        auto last = spare.begin();
 
-      if(m == 0) {
-        indices[i + 1] = pos + n;
-        continue;
+        for(auto itr = spare.begin() + 1; itr != spare.end(); ++itr) {
+          if(itr->entry == last->entry) {
+            *last = *itr;
+          }
+          else {
+            *(++last) = *itr;
+          } // if
+        } // for
+
+        spare.erase(last + 1, spare.end());
       } // if
 
-      indices[i + 1] = pos + n + m;
+      const entry_value_t * citr = spare.data();
+      const entry_value_t * cend = citr + spare.size();
 
-      auto vitr = nitr + n;
+      indices[i] = pos;
 
-      for(auto itr = p.first; itr != p.second; ++itr) {
-        vitr->entry = itr->second.entry;
-        vitr->value = itr->second.value;
-        ++vitr;
-      } // for
+      while(oitr != oend || bitr != bend || citr != cend) {
+        size_t entry = none;
 
-      std::inplace_merge(iitr, nitr + n, nitr + n + m, cmp);
-    } // for
+        if(oitr != oend) {
+          entry = oitr->entry;
+        } // if
 
-    delete[] indices_;
-    indices_ = nullptr;
+        if(bitr != bend) {
+          entry = std::min(entry, bitr->entry);
+        } // if
 
-    delete[] entries_;
-    entries_ = nullptr;
+        if(citr != cend) {
+          entry = std::min(entry, citr->entry);
+        } // if
 
-    if(!erase_set_){
-      return;
-    }
+        const entry_value_t * value = nullptr;
 
-    constexpr size_t erased_marker = std::numeric_limits<size_t>::max();
+        if(oitr != oend && oitr->entry == entry) {
+          value = oitr++;
+        } // if
 
-    entry_value_t * start;
-    entry_value_t * end;
+        if(bitr != bend && bitr->entry == entry) {
+          value = bitr++;
+        } // if
 
-    size_t last = std::numeric_limits<size_t>::max();
+        if(citr != cend && citr->entry == entry) {
+          value = citr++;
+        } // if
 
-    size_t num_erased = 0;
+        if(erase_set_) {
+          while(eitr != eend && (eitr->first < i ||
+            (eitr->first == i && eitr->second < entry))) {
+            ++eitr;
+          } // while
 
-    for(auto p : *erase_set_){
-      if(p.first != last){
-        start = entries + indices[p.first];
-        end = entries + indices[p.first + 1];
-        last = p.first;
-        indices[p.first] -= num_erased;
-      }
+          if(eitr != eend && eitr->first == i && eitr->second == entry) {
+            continue;
+          } // if
+        } // if
 
-      entry_value_t * m =
-        std::lower_bound(start, end, entry_value_t(p.second),
-          [](const auto & k1, const auto & k2) -> bool {
-            return k1.entry < k2.entry;
-        });
+        out[pos++] = *value;
+      } // while
+    } // for
 
-      m->entry = erased_marker;
-      start = m + 1;
-      ++num_erased;
-    }
+    indices[num_indices_] = pos;
 
-    while(last < num_indices_){
-      indices[++last] -= num_erased;
-    }
+    merged.resize(pos * ev_bytes);
+    raw_entries.swap(merged);
 
-    std::remove_if(entries, entries_end,
-      [](const auto & k) -> bool {
-        return k.entry == erased_marker;
-    });
+    delete[] indices_;
+    indices_ = nullptr;
+
+    delete[] entries_;
+    entries_ = nullptr;
 
-    s = raw_entries.size();
-    s -= num_erased * ev_bytes;
-    raw_entries.resize(s);
+    spare_map_.clear();
 
     delete erase_set_;
     erase_set_ = nullptr;
@@ -591,6 +618,7 @@ struct sparse_handle_t {
 // Main type definition.
 //+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=//
 
+#if 0
 ///
 // FIXME: Sparse storage type.
 ///
@@ -748,6 +776,7 @@ struct storage_type_t<sparse, DS, MD> {
   } // get_handle
 
 }; // struct storage_type_t
+#endif
 
 } // namespace serial
 } // namespace data
@@ -0,0 +1,192 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 17, 2017
+///
+
+#include <cinchtest.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "flecsi/data/serial/sparse.h"
+
+using namespace flecsi::data::serial;
+
+//----------------------------------------------------------------------------//
+// Minimal meta data with the members used by the mutator.
+//----------------------------------------------------------------------------//
+
+struct test_meta_data_t {
+  using user_meta_data_t = int;
+
+  size_t size;
+  size_t num_entries;
+  std::map<size_t, std::vector<uint8_t>> data;
+}; // struct test_meta_data_t
+
+using mutator_t = sparse_mutator_t<double, test_meta_data_t>;
+using row_t = std::vector<std::pair<size_t, double>>;
+
+const size_t num_indices = 4;
+const size_t num_entries = 10;
+
+test_meta_data_t
+make_meta_data() {
+  test_meta_data_t md;
+
+  md.size = num_indices;
+  md.num_entries = num_entries;
+  md.data[INDICES_FLAG].resize((num_indices + 1) * sizeof(size_t));
+  md.data[ENTRIES_FLAG];
+
+  return md;
+} // make_meta_data
+
+mutator_t
+make_mutator(test_meta_data_t & md, size_t slots) {
+  return { slots, "test", 0, md, 0 };
+} // make_mutator
+
+//----------------------------------------------------------------------------//
+// Return the committed (entry, value) pairs of an index.
+//----------------------------------------------------------------------------//
+
+row_t
+row(const test_meta_data_t & md, size_t index) {
+  auto indices =
+    reinterpret_cast<const size_t *>(md.data.at(INDICES_FLAG).data());
+  auto entries = reinterpret_cast<const entry_value__<double> *>(
+    md.data.at(ENTRIES_FLAG).data());
+
+  row_t r;
+
+  for(size_t i(indices[index]); i < indices[index + 1]; ++i) {
+    r.emplace_back(entries[i].entry, entries[i].value);
+  } // for
+
+  return r;
+} // row
+
+TEST(sparse_mutator, insert) {
+  auto md = make_meta_data();
+
+  {
+  auto m = make_mutator(md, 2);
+
+  m(0, 3) = 1.0;
+  m(0, 1) = 2.0;
+  m(2, 5) = 3.0;
+
+  // Overflow past the slots of index 3.
+  m(3, 4) = 4.0;
+  m(3, 2) = 5.0;
+  m(3, 6) = 6.0;
+  m(3, 0) = 7.0;
+  } // scope
+
+  ASSERT_EQ(row_t({{1, 2.0}, {3, 1.0}}), row(md, 0));
+  ASSERT_TRUE(row(md, 1).empty());
+  ASSERT_EQ(row_t({{5, 3.0}}), row(md, 2));
+  ASSERT_EQ(row_t({{0, 7.0}, {2, 5.0}, {4, 4.0}, {6, 6.0}}), row(md, 3));
+} // TEST
+
+TEST(sparse_mutator, overwrite) {
+  auto md = make_meta_data();
+
+  {
+  auto m = make_mutator(md, 2);
+  m(0, 1) = 1.0;
+  m(0, 3) = 2.0;
+  m(1, 2) = 3.0;
+  m.commit();
+  } // scope
+
+  // Slot values replace committed values.
+  {
+  auto m = make_mutator(md, 2);
+  m(0, 3) = 20.0;
+  m(1, 2) = 30.0;
+  m(1, 4) = 40.0;
+  } // scope
+
+  ASSERT_EQ(row_t({{1, 1.0}, {3, 20.0}}), row(md, 0));
+  ASSERT_EQ(row_t({{2, 30.0}, {4, 40.0}}), row(md, 1));
+
+  // Overflow values replace committed values.
+  {
+  auto m = make_mutator(md, 0);
+  m(0, 1) = 10.0;
+  } // scope
+
+  ASSERT_EQ(row_t({{1, 10.0}, {3, 20.0}}), row(md, 0));
+  ASSERT_EQ(row_t({{2, 30.0}, {4, 40.0}}), row(md, 1));
+} // TEST
+
+TEST(sparse_mutator, duplicates) {
+  auto md = make_meta_data();
+
+  {
+  auto m = make_mutator(md, 1);
+
+  // A repeated entry in the slots is overwritten in place.
+  m(0, 5) = 1.0;
+  m(0, 5) = 2.0;
+
+  // Once the slots are full, a repeat goes to the overflow, which wins.
+  m(1, 7) = 1.0;
+  m(1, 7) = 2.0;
+
+  // Repeats within the overflow keep the most recent value.
+  m(2, 1) = 1.0;
+  m(2, 8) = 2.0;
+  m(2, 8) = 3.0;
+  m(2, 8) = 4.0;
+  } // scope
+
+  ASSERT_EQ(row_t({{5, 2.0}}), row(md, 0));
+  ASSERT_EQ(row_t({{7, 2.0}}), row(md, 1));
+  ASSERT_EQ(row_t({{1, 1.0}, {8, 4.0}}), row(md, 2));
+} // TEST
+
+TEST(sparse_mutator, erase) {
+  auto md = make_meta_data();
+
+  {
+  auto m = make_mutator(md, 2);
+  m(0, 1) = 1.0;
+  m(0, 3) = 2.0;
+  m(1, 2) = 3.0;
+  } // scope
+
+  {
+  auto m = make_mutator(md, 2);
+
+  // Erase a committed entry.
+  m.erase(0, 1);
+
+  // Erasing entries that do not exist is a no-op.
+  m.erase(1, 9);
+  m.erase(3, 0);
+
+  // Erasures are applied after the new values.
+  m(2, 4) = 4.0;
+  m(2, 6) = 5.0;
+  m.erase(2, 4);
+  } // scope
+
+  ASSERT_EQ(row_t({{3, 2.0}}), row(md, 0));
+  ASSERT_EQ(row_t({{2, 3.0}}), row(md, 1));
+  ASSERT_EQ(row_t({{6, 5.0}}), row(md, 2));
+  ASSERT_TRUE(row(md, 3).empty());
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -22,7 +22,9 @@
 #include <algorithm>
 #include <cstddef>
 #include <map>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "cinchlog.h"
 #include "flecsi/execution/common/execution_state.h"
@@ -74,6 +76,7 @@ struct context__ : public CONTEXT_POLICY
     size_t data_client_hash;
     size_t storage_type;
     size_t size;
+    size_t type_hash;
     size_t namespace_hash;
     size_t name_hash;
     size_t versions;
@@ -90,6 +93,15 @@ struct context__ : public CONTEXT_POLICY
   using field_info_map_t =
     std::map<std::pair<size_t, size_t>, std::map<field_id_t, field_info_t>>;
 
+  //--------------------------------------------------------------------------//
+  // Secondary field index, key = (data client hash, storage type, type hash),
+  // value = fields sorted by (namespace hash, name hash)
+  //--------------------------------------------------------------------------//
+
+  using field_type_index_t =
+    std::map<std::tuple<size_t, size_t, size_t>,
+      std::vector<const field_info_t *>>;
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
@@ -529,10 +541,27 @@ struct context__ : public CONTEXT_POLICY
     size_t data_client_hash = field_info.data_client_hash;
     field_id_t fid = field_info.fid;
 
-    field_info_map_[{data_client_hash, index_space}].emplace(fid, field_info);
+    auto ret =
+      field_info_map_[{data_client_hash, index_space}].emplace(fid, field_info);
 
     field_map_.insert({{field_info.data_client_hash, field_info.key},
                        {index_space, fid}});
+
+    if(!ret.second) {
+      return;
+    } // if
+
+    // Keep the typed index sorted so that lookups never have to sort.
+    auto & fields = field_type_index_[std::make_tuple(data_client_hash,
+      field_info.storage_type, field_info.type_hash)];
+
+    const field_info_t * fi = &ret.first->second;
+
+    fields.insert(std::upper_bound(fields.begin(), fields.end(), fi,
+      [](const field_info_t * a, const field_info_t * b) {
+        return std::make_pair(a->namespace_hash, a->name_hash) <
+          std::make_pair(b->namespace_hash, b->name_hash);
+      }), fi);
   } // put_field_info
 
   //--------------------------------------------------------------------------//
@@ -546,6 +575,69 @@ struct context__ : public CONTEXT_POLICY
     return field_info_map_;
   } // field_info_map
 
+  //--------------------------------------------------------------------------//
+  //! Return the fields of a data client that have the given storage type
+  //! and data type. The list is maintained by put_field_info, so this
+  //! costs a single lookup, and it is sorted by (namespace hash, name
+  //! hash).
+  //!
+  //! @param data_client_hash data client type hash
+  //! @param storage_type     storage type, e.g., dense
+  //! @param type_hash        typeid(DATA_TYPE).hash_code()
+  //--------------------------------------------------------------------------//
+
+  const std::vector<const field_info_t *> &
+  fields_of_type(
+    size_t data_client_hash,
+    size_t storage_type,
+    size_t type_hash
+  )
+  const
+  {
+    static const std::vector<const field_info_t *> empty;
+
+    auto itr = field_type_index_.find(
+      std::make_tuple(data_client_hash, storage_type, type_hash));
+
+    return itr == field_type_index_.end() ? empty : itr->second;
+  } // fields_of_type
+
+  //--------------------------------------------------------------------------//
+  //! Return the fields of a data client in a single namespace that have
+  //! the given storage type and data type.
+  //!
+  //! @param data_client_hash data client type hash
+  //! @param storage_type     storage type, e.g., dense
+  //! @param type_hash        typeid(DATA_TYPE).hash_code()
+  //! @param namespace_hash   namespace hash
+  //--------------------------------------------------------------------------//
+
+  std::pair<
+    typename field_type_index_t::mapped_type::const_iterator,
+    typename field_type_index_t::mapped_type::const_iterator
+  >
+  fields_of_type(
+    size_t data_client_hash,
+    size_t storage_type,
+    size_t type_hash,
+    size_t namespace_hash
+  )
+  const
+  {
+    auto & fields =
+      fields_of_type(data_client_hash, storage_type, type_hash);
+
+    struct compare_t {
+      bool operator () (const field_info_t * a, size_t b) const
+        { return a->namespace_hash < b; }
+      bool operator () (size_t a, const field_info_t * b) const
+        { return a < b->namespace_hash; }
+    }; // struct compare_t
+
+    return std::equal_range(fields.begin(), fields.end(), namespace_hash,
+      compare_t());
+  } // fields_of_type
+
   //--------------------------------------------------------------------------//
   //! Get field map for read access.
   //--------------------------------------------------------------------------//
@@ -642,6 +734,12 @@ private:
 
   field_info_map_t field_info_map_;
 
+  //--------------------------------------------------------------------------//
+  // Typed field index, built alongside field_info_map_
+  //--------------------------------------------------------------------------//
+
+  field_type_index_t field_type_index_;
+
   //--------------------------------------------------------------------------//
   // Map of adjacency triples. key: adjacency index space
   //--------------------------------------------------------------------------//
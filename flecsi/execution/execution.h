@@ -148,6 +148,27 @@ clog_register_tag(execution);
                                                                                \
   flecsi_execute_task(task, index, ## __VA_ARGS__)
 
+//----------------------------------------------------------------------------//
+//! @def flecsi_trace
+//!
+//! This macro traces the task launches issued from its point of use to
+//! the end of the enclosing scope, e.g., the body of a time step loop.
+//! On backends that support it, the runtime analysis of the launches is
+//! recorded the first time and replayed afterwards. Each instance of the
+//! trace must issue the same tasks with the same arguments, and MPI tasks
+//! cannot be executed inside a trace.
+//!
+//! @param id The trace id.
+//!
+//! @ingroup execution
+//----------------------------------------------------------------------------//
+
+#define flecsi_trace(id)                                                       \
+/* MACRO IMPLEMENTATION */                                                     \
+                                                                               \
+  flecsi::execution::trace_guard_t __flecsi_trace_guard(id,                    \
+    flecsi::utils::const_string_t{__func__}.hash())
+
 //----------------------------------------------------------------------------//
 // Function Interface
 //----------------------------------------------------------------------------//
@@ -22,8 +22,11 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <tuple>
 #include <unordered_map>
 #include <stack>
+#include <vector>
 
 #include <cinchlog.h>
 #include <legion.h>
@@ -596,6 +599,71 @@ struct legion_context_policy_t
     return index_space_data_map_;
   }
 
+  //--------------------------------------------------------------------------//
+  //! A contiguous block of ghost entities that is filled from a contiguous
+  //! block of an owner's shared entities. Offsets are in entities.
+  //--------------------------------------------------------------------------//
+
+  struct ghost_copy_run_t{
+    size_t src;
+    size_t dst;
+    size_t length;
+  };
+
+  using ghost_copy_plan_t = std::vector<ghost_copy_run_t>;
+
+  //--------------------------------------------------------------------------//
+  //! Return the cached ghost copy plan for the given data client, index
+  //! space and owner, or nullptr if it has not been compiled yet.
+  //!
+  //! @param data_client_hash The data client hash.
+  //! @param index_space      FleCSI index space, e.g. cells key
+  //! @param owner            The local id of the owner color.
+  //--------------------------------------------------------------------------//
+
+  const ghost_copy_plan_t *
+  ghost_copy_plan(
+    size_t data_client_hash,
+    size_t index_space,
+    size_t owner
+  )
+  {
+    std::lock_guard<std::mutex> lock(ghost_copy_plans_mutex_);
+
+    auto itr = ghost_copy_plans_.find(
+      std::make_tuple(data_client_hash, index_space, owner));
+
+    return itr == ghost_copy_plans_.end() ? nullptr : &itr->second;
+  } // ghost_copy_plan
+
+  //--------------------------------------------------------------------------//
+  //! Cache a ghost copy plan. The ghost owner positions do not change
+  //! once the coloring has been set up, so the plan is reused by every
+  //! subsequent ghost copy.
+  //!
+  //! @param data_client_hash The data client hash.
+  //! @param index_space      FleCSI index space, e.g. cells key
+  //! @param owner            The local id of the owner color.
+  //! @param plan             The compiled copy runs.
+  //--------------------------------------------------------------------------//
+
+  const ghost_copy_plan_t *
+  add_ghost_copy_plan(
+    size_t data_client_hash,
+    size_t index_space,
+    size_t owner,
+    ghost_copy_plan_t && plan
+  )
+  {
+    std::lock_guard<std::mutex> lock(ghost_copy_plans_mutex_);
+
+    auto itr = ghost_copy_plans_.emplace(
+      std::make_tuple(data_client_hash, index_space, owner),
+      std::move(plan)).first;
+
+    return &itr->second;
+  } // add_ghost_copy_plan
+
   //--------------------------------------------------------------------------//
   //! Set DynamicCollective for <double> max reduction
   //!
@@ -701,6 +769,31 @@ struct legion_context_policy_t
     return global_min_;
   }
 
+  //--------------------------------------------------------------------------//
+  //! Return true if the driver is inside a Legion trace.
+  //--------------------------------------------------------------------------//
+
+  bool
+  tracing()
+  const
+  {
+    return tracing_;
+  } // tracing
+
+  //--------------------------------------------------------------------------//
+  //! Mark the start or the end of a Legion trace.
+  //!
+  //! @param tracing True at the start of the trace.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_tracing(
+    bool tracing
+  )
+  {
+    tracing_ = tracing;
+  } // set_tracing
+
   //--------------------------------------------------------------------------//
   //! Compute internal field id for from/to index space pair for connectivity.
   //! @param from_index_space from index space
@@ -764,9 +857,14 @@ private:
   //--------------------------------------------------------------------------//
 
   std::map<size_t, index_space_data_t> index_space_data_map_;
+  std::map<std::tuple<size_t, size_t, size_t>, ghost_copy_plan_t>
+    ghost_copy_plans_;
+  std::mutex ghost_copy_plans_mutex_;
   Legion::DynamicCollective max_reduction_;
   Legion::DynamicCollective min_reduction_;
 
+  bool tracing_ = false;
+
 }; // class legion_context_policy_t
 
 } // namespace execution
@@ -242,6 +242,9 @@ struct legion_execution_policy_t
 
     // Handle MPI and Legion invocations separately.
     if(processor_type == processor_type_t::mpi) {
+      clog_assert(!context_.tracing(),
+        "MPI tasks cannot be executed inside a trace");
+
       {
       clog_tag_guard(execution);
       clog(info) << "Executing MPI task: " << KEY << std::endl;
@@ -354,6 +357,67 @@ struct legion_execution_policy_t
     } // if
   } // execute_task
 
+  //--------------------------------------------------------------------------//
+  //! Legion backend trace start. For documentation on this method, please
+  //! see task__::begin_trace.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  begin_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+    context_t & context_ = context_t::instance();
+
+    clog_assert(!context_.tracing(), "Legion traces cannot be nested");
+
+#if defined(ENABLE_LEGION_TLS)
+    auto legion_runtime = Legion::Runtime::get_runtime();
+    auto legion_context = Legion::Runtime::get_context();
+#else
+    auto legion_runtime = context_.runtime(parent);
+    auto legion_context = context_.context(parent);
+#endif
+
+    {
+    clog_tag_guard(execution);
+    clog(info) << "Beginning trace: " << id << std::endl;
+    }
+
+    legion_runtime->begin_trace(legion_context, id);
+    context_.set_tracing(true);
+  } // begin_trace
+
+  //--------------------------------------------------------------------------//
+  //! Legion backend trace end. For documentation on this method, please
+  //! see task__::end_trace.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  end_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+    context_t & context_ = context_t::instance();
+
+    clog_assert(context_.tracing(), "no active trace to end");
+
+#if defined(ENABLE_LEGION_TLS)
+    auto legion_runtime = Legion::Runtime::get_runtime();
+    auto legion_context = Legion::Runtime::get_context();
+#else
+    auto legion_runtime = context_.runtime(parent);
+    auto legion_context = context_.context(parent);
+#endif
+
+    legion_runtime->end_trace(legion_context, id);
+    context_.set_tracing(false);
+  } // end_trace
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
@@ -49,7 +49,8 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
     typename T,
     size_t PERMISSIONS
   >
-  void
+  std::enable_if_t<!topology::is_structured_mesh_topology__<
+    typename T::type_identifier_t>::value>
   handle(
     data_client_handle__<T, PERMISSIONS> & h
   )
@@ -57,6 +58,22 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
     h.delete_storage();
   } // handle
 
+  //--------------------------------------------------------------------------//
+  //! Structured topologies do not allocate storage.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T,
+    size_t PERMISSIONS
+  >
+  std::enable_if_t<topology::is_structured_mesh_topology__<
+    typename T::type_identifier_t>::value>
+  handle(
+    data_client_handle__<T, PERMISSIONS> &
+  )
+  {
+  } // handle
+
   //-----------------------------------------------------------------------//
   // If this is not a data handle, then simply skip it.
   //-----------------------------------------------------------------------//
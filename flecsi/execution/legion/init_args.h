@@ -27,6 +27,7 @@
 #include "flecsi/execution/common/execution_state.h"
 #include "flecsi/data/common/privilege.h"
 #include "flecsi/data/data_client_handle.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 
 namespace flecsi {
 namespace execution {
@@ -156,7 +157,22 @@ namespace execution {
       typename T,
       size_t PERMISSIONS
     >
-    void
+    std::enable_if_t<topology::is_structured_mesh_topology__<
+      typename T::type_identifier_t>::value>
+    handle(
+      data_client_handle__<T, PERMISSIONS> &
+    )
+    {
+      // Structured topologies compute their entities from their box, so
+      // they do not need any regions.
+    } // handle
+
+    template<
+      typename T,
+      size_t PERMISSIONS
+    >
+    std::enable_if_t<!topology::is_structured_mesh_topology__<
+      typename T::type_identifier_t>::value>
     handle(
       data_client_handle__<T, PERMISSIONS> & h
     )
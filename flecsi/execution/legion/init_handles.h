@@ -30,6 +30,7 @@
 #include "flecsi/utils/tuple_walker.h"
 #include "flecsi/data/data_client_handle.h"
 #include "flecsi/topology/mesh_types.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 
 namespace flecsi {
 namespace execution {
@@ -146,8 +147,18 @@ struct init_handles_t : public utils::tuple_walker__<init_handles_t>
 
   if (!h.global && !h.color){
 #ifndef MAPPER_COMPACTION
-  // Create the concatenated buffer E+S+G
-  h.combined_data = new T[h.combined_size];
+  // The regions may already be adjacent in memory, e.g., when the mapper
+  // places them in a single instance. In that case, bind the handle to
+  // them directly instead of copying them into a new buffer.
+  bool contiguous = sizes[0] > 0;
+
+  for(size_t r{1}, pos{sizes[0]}; contiguous && r<num_regions; ++r) {
+    contiguous = sizes[r] == 0 || data[r] == data[0] + pos;
+    pos += sizes[r];
+  } // for
+
+  // Otherwise, create the concatenated buffer E+S+G
+  h.combined_data = contiguous ? data[0] : new T[h.combined_size];
 
   // Set additional fields needed by the data handle/accessor
   // and copy into the combined buffer. Note that exclusive_data, etc.
@@ -184,7 +195,10 @@ struct init_handles_t : public utils::tuple_walker__<init_handles_t>
         clog_fatal("invalid permissions case");
     } // switch
 
-    std::memcpy(h.combined_data + pos, data[r], sizes[r] * sizeof(T));
+    if(!contiguous) {
+      std::memcpy(h.combined_data + pos, data[r], sizes[r] * sizeof(T));
+    } // if
+
     pos += sizes[r];
   } // for
 #ifdef COMPACTED_STORAGE_SORT
@@ -274,7 +288,22 @@ struct init_handles_t : public utils::tuple_walker__<init_handles_t>
     typename T,
     size_t PERMISSIONS
   >
-  void
+  std::enable_if_t<topology::is_structured_mesh_topology__<
+    typename T::type_identifier_t>::value>
+  handle(
+    data_client_handle__<T, PERMISSIONS> &
+  )
+  {
+    // Structured topologies compute their entities from their box, so
+    // there is no storage to initialize.
+  } // handle
+
+  template<
+    typename T,
+    size_t PERMISSIONS
+  >
+  std::enable_if_t<!topology::is_structured_mesh_topology__<
+    typename T::type_identifier_t>::value>
   handle(
     data_client_handle__<T, PERMISSIONS> & h
   )
@@ -327,23 +327,9 @@ __flecsi_internal_legion_task(ghost_copy_task, void) {
    task->regions[0].privilege_fields.size()) == 1,
    "ghost region additionally requires ghost_owner_pos_fid");
 
-  legion_map owner_map = task->futures[0].get_result<legion_map>();
-
-  for(auto itr = owner_map.begin(); itr != owner_map.end(); itr++)
-      {
-      clog_tag_guard(legion_tasks);
-      clog(trace) << "my_color= " << my_color << " gid " << itr->first <<
-        " maps to lid " << itr->second << " current owner lid is " <<
-        args.owner << std::endl;
-      }
-
   auto ghost_owner_pos_fid = 
     LegionRuntime::HighLevel::FieldID(internal_field::ghost_owner_pos);
 
-  auto position_ref_acc =
-    regions[1].get_field_accessor(ghost_owner_pos_fid).typeify<
-    LegionRuntime::Arrays::Point<2>>();
-
   Legion::Domain owner_domain = runtime->get_index_space_domain(ctx,
           regions[0].get_logical_region().get_index_space());
   Legion::Domain ghost_domain = runtime->get_index_space_domain(ctx,
@@ -355,20 +341,89 @@ __flecsi_internal_legion_task(ghost_copy_task, void) {
   LegionRuntime::Arrays::Rect<2> ghost_sub_rect;
   LegionRuntime::Accessor::ByteOffset byte_offset[2];
 
-  LegionRuntime::Arrays::Point<2>* position_ref_data =
-    reinterpret_cast<LegionRuntime::Arrays::Point<2>*>(position_ref_acc.template raw_rect_ptr<2>(
-      ghost_rect, ghost_sub_rect, byte_offset));
-  size_t position_max = ghost_rect.hi[1] - ghost_rect.lo[1] + 1;
+  // The ghost owner positions are fixed once the coloring is set up, so
+  // the (src, dst, length) runs for this owner are compiled on the first
+  // copy and reused afterwards.
+  using ghost_copy_plan_t = context_t::ghost_copy_plan_t;
+
+  const ghost_copy_plan_t * plan =
+    context.ghost_copy_plan(args.data_client_hash, args.index_space,
+    args.owner);
+
+  if(plan == nullptr) {
+    legion_map owner_map = task->futures[0].get_result<legion_map>();
+
+    for(auto itr = owner_map.begin(); itr != owner_map.end(); itr++)
+        {
+        clog_tag_guard(legion_tasks);
+        clog(trace) << "my_color= " << my_color << " gid " << itr->first <<
+          " maps to lid " << itr->second << " current owner lid is " <<
+          args.owner << std::endl;
+        }
+
+    auto position_ref_acc =
+      regions[1].get_field_accessor(ghost_owner_pos_fid).typeify<
+      LegionRuntime::Arrays::Point<2>>();
+
+    LegionRuntime::Arrays::Point<2>* position_ref_data =
+      reinterpret_cast<LegionRuntime::Arrays::Point<2>*>(
+        position_ref_acc.template raw_rect_ptr<2>(
+        ghost_rect, ghost_sub_rect, byte_offset));
+    size_t position_max = ghost_rect.hi[1] - ghost_rect.lo[1] + 1;
+
+    ghost_copy_plan_t runs;
+
+    for(size_t ghost_pt = 0; ghost_pt < position_max; ghost_pt++) {
+      LegionRuntime::Arrays::Point<2> ghost_ref = position_ref_data[ghost_pt];
+
+      {
+      clog_tag_guard(legion_tasks);
+      clog(trace) << my_color << " copy from position " << ghost_ref.x[0] <<
+              "," << ghost_ref.x[1] << std::endl;
+      }
+
+      auto oitr = owner_map.find(ghost_ref.x[0]);
+
+      if(oitr == owner_map.end() ||
+        size_t(oitr->second) != args.owner) {
+        continue;
+      } // if
+
+      // Owner positions stay absolute; the subrect offset of each field
+      // is applied when copying.
+      size_t owner_offset = ghost_ref.x[1];
+
+      if(!runs.empty() &&
+        runs.back().src + runs.back().length == owner_offset &&
+        runs.back().dst + runs.back().length == ghost_pt) {
+        ++runs.back().length;
+      }
+      else {
+        runs.push_back({owner_offset, ghost_pt, 1});
+      } // if
+    } // for ghost_pt
+
+    {
+    clog_tag_guard(legion_tasks);
+    clog(trace) << "my_color = " << my_color << " owner lid = " <<
+      args.owner << " compiled " << runs.size() << " ghost copy runs" <<
+      std::endl;
+    }
+
+    plan = context.add_ghost_copy_plan(args.data_client_hash,
+      args.index_space, args.owner, std::move(runs));
+  } // if
+
+  // Look up field info in context
+  auto iitr = 
+    context.field_info_map().find({args.data_client_hash, args.index_space});
+  clog_assert(iitr != context.field_info_map().end(), "invalid index space");
 
   // For each field, copy data from shared to ghost
   for(auto fid : task->regions[0].privilege_fields){
-    // Look up field info in context
-    auto iitr = 
-      context.field_info_map().find({args.data_client_hash, args.index_space});
-    clog_assert(iitr != context.field_info_map().end(), "invalid index space");
     auto fitr = iitr->second.find(fid);
     clog_assert(fitr != iitr->second.end(), "invalid fid");
-    const context_t::field_info_t& field_info = fitr->second;
+    const size_t size = fitr->second.size;
 
     auto acc_shared = regions[0].get_field_accessor(fid);
     auto acc_ghost = regions[1].get_field_accessor(fid);
@@ -389,25 +444,11 @@ __flecsi_internal_legion_task(ghost_copy_task, void) {
       reinterpret_cast<uint8_t *>(acc_ghost.template raw_rect_ptr<2>(
         ghost_rect, ghost_sub_rect, byte_offset));
 
-    for(size_t ghost_pt = 0; ghost_pt < position_max; ghost_pt++) {
-      LegionRuntime::Arrays::Point<2> ghost_ref = position_ref_data[ghost_pt];
-
-      {
-      clog_tag_guard(legion_tasks);
-      clog(trace) << my_color << " copy from position " << ghost_ref.x[0] <<
-              "," << ghost_ref.x[1] << std::endl;
-      }
-
-      if(owner_map[ghost_ref.x[0]] == args.owner) {
-        size_t owner_offset = ghost_ref.x[1]-owner_sub_rect.lo[1];
-        uint8_t * owner_copy_ptr =
-          data_shared + owner_offset * field_info.size;
-        size_t ghost_offset = ghost_pt;
-        uint8_t * ghost_copy_ptr =
-          ghost_data + ghost_offset * field_info.size;
-        std::memcpy(ghost_copy_ptr, owner_copy_ptr, field_info.size);
-      } // if
-    } // for ghost_pt
+    for(const auto & run : *plan) {
+      std::memcpy(ghost_data + run.dst * size,
+        data_shared + (run.src - owner_sub_rect.lo[1]) * size,
+        run.length * size);
+    } // for run
   } // for fid
 } // ghost_copy_task
 
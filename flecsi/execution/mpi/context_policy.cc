@@ -9,6 +9,9 @@
 //----------------------------------------------------------------------------//
 
 #include "flecsi/execution/mpi/context_policy.h"
+#include "flecsi/execution/mpi/task_profiler.h"
+
+#include <limits>
 
 namespace flecsi {
 namespace execution {
@@ -30,6 +33,251 @@ mpi_context_policy_t::initialize(
   return 0;
 } // mpi_context_policy_t::initialize
 
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::ghost_layout.
+//----------------------------------------------------------------------------//
+
+const mpi_context_policy_t::ghost_layout_t &
+mpi_context_policy_t::ghost_layout(
+  size_t index_space,
+  const index_coloring_t & index_coloring
+)
+{
+  auto itr = ghost_layouts_.find(index_space);
+
+  if(itr != ghost_layouts_.end()) {
+    return itr->second;
+  } // if
+
+  // Append a displacement, extending the last run when it is contiguous.
+  auto append = [](ghost_runs_t & runs, int disp) {
+    if(!runs.lengths.empty() &&
+      runs.displacements.back() + runs.lengths.back() == disp) {
+      ++runs.lengths.back();
+    }
+    else {
+      runs.lengths.push_back(1);
+      runs.displacements.push_back(disp);
+    } // if
+  };
+
+  ghost_layout_t & layout = ghost_layouts_[index_space];
+
+  // The ghost owners send their shared entities in the order that we
+  // store the corresponding ghosts, so we tell each owner the offsets
+  // into its shared indices of the entities that we ghost.
+  std::map<int, std::vector<int>> ghost_offsets;
+
+  int ghost_index = 0;
+  for(auto & ghost: index_coloring.ghost) {
+    append(layout.ghost[ghost.rank], ghost_index++);
+    ghost_offsets[ghost.rank].push_back(ghost.offset);
+  } // for
+
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<int> send_counts(size, 0);
+  std::vector<int> recv_counts(size);
+
+  for(auto & offsets: ghost_offsets) {
+    send_counts[offsets.first] = offsets.second.size();
+  } // for
+
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1,
+    MPI_INT, MPI_COMM_WORLD);
+
+  std::map<int, std::vector<int>> shared_disps;
+  std::vector<MPI_Request> requests;
+
+  for(int r = 0; r < size; ++r) {
+    if(recv_counts[r] == 0) {
+      continue;
+    } // if
+
+    auto & disps = shared_disps[r];
+    disps.resize(recv_counts[r]);
+    requests.emplace_back();
+    MPI_Irecv(disps.data(), disps.size(), MPI_INT, r, 0, MPI_COMM_WORLD,
+      &requests.back());
+  } // for
+
+  for(auto & offsets: ghost_offsets) {
+    requests.emplace_back();
+    MPI_Isend(offsets.second.data(), offsets.second.size(), MPI_INT,
+      offsets.first, 0, MPI_COMM_WORLD, &requests.back());
+  } // for
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  for(auto & disps: shared_disps) {
+    auto & runs = layout.shared[disps.first];
+
+    for(auto disp: disps.second) {
+      append(runs, disp);
+    } // for
+  } // for
+
+  return layout;
+} // mpi_context_policy_t::ghost_layout
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::ghost_plan.
+//----------------------------------------------------------------------------//
+
+const mpi_context_policy_t::ghost_plan_t &
+mpi_context_policy_t::ghost_plan(
+  size_t index_space,
+  size_t element_size,
+  const index_coloring_t & index_coloring
+)
+{
+  auto key = std::make_pair(index_space, element_size);
+  auto itr = ghost_plans_.find(key);
+
+  if(itr != ghost_plans_.end()) {
+    return itr->second;
+  } // if
+
+  auto & layout = ghost_layout(index_space, index_coloring);
+
+  // Ghost data is copied verbatim, so the datatypes are expressed in
+  // bytes and can be shared by all fields with the same element size.
+  // Byte counts are computed in size_t/MPI_Aint so that large runs do not
+  // overflow int; only the block lengths are narrowed for MPI.
+  auto make_type = [element_size](const ghost_runs_t & runs) {
+    std::vector<int> lengths(runs.lengths.size());
+    std::vector<MPI_Aint> disps(runs.displacements.size());
+
+    for(size_t i = 0; i < lengths.size(); ++i) {
+      const size_t bytes = size_t(runs.lengths[i]) * element_size;
+
+      clog_assert(bytes <= size_t(std::numeric_limits<int>::max()),
+        "ghost run of " << bytes << " bytes exceeds the MPI count limit");
+
+      lengths[i] = static_cast<int>(bytes);
+      disps[i] = MPI_Aint(runs.displacements[i]) * MPI_Aint(element_size);
+    } // for
+
+    MPI_Datatype type;
+    MPI_Type_create_hindexed(lengths.size(), lengths.data(), disps.data(),
+      MPI_BYTE, &type);
+    MPI_Type_commit(&type);
+    return type;
+  };
+
+  ghost_plan_t & plan = ghost_plans_[key];
+
+  for(auto & runs: layout.shared) {
+    plan.shared_types.insert({runs.first, make_type(runs.second)});
+  } // for
+
+  for(auto & runs: layout.ghost) {
+    plan.ghost_types.insert({runs.first, make_type(runs.second)});
+  } // for
+
+  return plan;
+} // mpi_context_policy_t::ghost_plan
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::exchange_ghosts.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::exchange_ghosts(
+  const std::vector<ghost_field_t> & fields
+)
+{
+  // Tag reserved for ghost exchange messages. Matching relies on the
+  // MPI non-overtaking rule, since every rank starts its exchanges in
+  // the same order.
+  constexpr int ghost_exchange_tag = 101;
+
+  // Collect, for every peer, the per-field datatypes and the absolute
+  // addresses of the field regions they describe.
+  std::map<int, std::vector<MPI_Datatype>> send_types;
+  std::map<int, std::vector<MPI_Aint>> send_addrs;
+  std::map<int, std::vector<MPI_Datatype>> recv_types;
+  std::map<int, std::vector<MPI_Aint>> recv_addrs;
+
+  std::set<field_id_t> fids;
+
+  for(auto & field: fields) {
+    if(!fids.insert(field.fid).second) {
+      continue;
+    } // if
+
+    auto & metadata = field_metadata.at(field.fid);
+    MPI_Aint address;
+
+    MPI_Get_address(field.shared_data, &address);
+    for(auto & type: metadata.plan->shared_types) {
+      send_types[type.first].push_back(type.second);
+      send_addrs[type.first].push_back(address);
+    } // for
+
+    MPI_Get_address(field.ghost_data, &address);
+    for(auto & type: metadata.plan->ghost_types) {
+      recv_types[type.first].push_back(type.second);
+      recv_addrs[type.first].push_back(address);
+    } // for
+
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    size_t bytes_sent = 0;
+    size_t bytes_received = 0;
+    int type_size;
+
+    for(auto & type: metadata.plan->shared_types) {
+      MPI_Type_size(type.second, &type_size);
+      bytes_sent += type_size;
+    } // for
+
+    for(auto & type: metadata.plan->ghost_types) {
+      MPI_Type_size(type.second, &type_size);
+      bytes_received += type_size;
+    } // for
+
+    mpi_task_profiler_t::instance().record_ghost_exchange(field.fid,
+      bytes_sent, bytes_received);
+#endif
+  } // for
+
+  // Create one struct datatype per peer spanning all of the fields, so
+  // that the exchange costs one message per peer.
+  auto make_struct_type = [](std::vector<MPI_Datatype> & types,
+    std::vector<MPI_Aint> & addrs)
+  {
+    std::vector<int> lens(types.size(), 1);
+    MPI_Datatype type;
+    MPI_Type_create_struct(types.size(), lens.data(), addrs.data(),
+      types.data(), &type);
+    MPI_Type_commit(&type);
+    return type;
+  };
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(recv_types.size() + send_types.size());
+
+  for(auto & peer: recv_types) {
+    auto type = make_struct_type(peer.second, recv_addrs[peer.first]);
+    requests.emplace_back();
+    MPI_Irecv(MPI_BOTTOM, 1, type, peer.first, ghost_exchange_tag,
+      MPI_COMM_WORLD, &requests.back());
+    // Freeing a datatype does not affect pending operations that use it.
+    MPI_Type_free(&type);
+  } // for
+
+  for(auto & peer: send_types) {
+    auto type = make_struct_type(peer.second, send_addrs[peer.first]);
+    requests.emplace_back();
+    MPI_Isend(MPI_BOTTOM, 1, type, peer.first, ghost_exchange_tag,
+      MPI_COMM_WORLD, &requests.back());
+    MPI_Type_free(&type);
+  } // for
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+} // mpi_context_policy_t::exchange_ghosts
+
 } // namespace execution 
 } // namespace flecsi
 
@@ -22,6 +22,9 @@
 
 #include <unordered_map>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
 #include <functional>
 #include <cinchlog.h>
 
@@ -36,6 +39,7 @@
 #include "flecsi/execution/common/processor.h"
 #include "flecsi/execution/mpi/runtime_driver.h"
 #include "flecsi/execution/mpi/future.h"
+#include "flecsi/execution/mpi/reduction.h"
 #include "flecsi/runtime/types.h"
 #include "flecsi/utils/common.h"
 #include "flecsi/utils/const_string.h"
@@ -146,205 +150,109 @@ struct mpi_context_policy_t
 
   using coloring_info_t = flecsi::coloring::coloring_info_t;
   using index_coloring_t = flecsi::coloring::index_coloring_t;
+
+  //--------------------------------------------------------------------------//
+  //! The ghost_plan_t type stores the ghost communication plan of an
+  //! index space for one element size: one indexed datatype over the
+  //! shared region per peer that uses our shared entities, and one
+  //! indexed datatype over the ghost region per peer that owns our ghost
+  //! entities. Plans are built once and shared by every field of the
+  //! index space with the same element size.
+  //--------------------------------------------------------------------------//
+
+  struct ghost_plan_t {
+
+    std::map<int, MPI_Datatype> shared_types;
+    std::map<int, MPI_Datatype> ghost_types;
+
+  }; // struct ghost_plan_t
+
+  //--------------------------------------------------------------------------//
+  //! The field_metadata_t type stores the ghost state of a registered
+  //! field. The dirty flag is set when a task writes the shared indices of
+  //! the field and cleared when its ghosts are refreshed.
+  //--------------------------------------------------------------------------//
+
   struct field_metadata_t {
 
-    MPI_Group shared_users_grp;
-    MPI_Group ghost_owners_grp;
+    const ghost_plan_t * plan = nullptr;
 
-    std::map<int, MPI_Datatype> origin_types;
-    std::map<int, MPI_Datatype> target_types;
+    bool dirty = false;
 
-    MPI_Win win;
-  };
+  }; // struct field_metadata_t
 
-  template <typename T>
-  void register_field_metadata(const field_id_t fid,
-                               const coloring_info_t& coloring_info,
-                               const index_coloring_t& index_coloring) {
-
-    // The group for MPI_Win_post are the "origin" processes, i.e.
-    // the peer processes calling MPI_Get to get our shared cells. Thus
-    // granting access of local window to these processes. This is the set
-    // coloring_info_t::shared_users
-    // On the other hand, the group for MPI_Win_start are the 'target'
-    // processes, i.e. the peer processes this rank is going to get ghost
-    // cells from. This is the set coloring_info_t::ghost_owners.
-    // Since both shared_users and ghost_owners are std::set, we have copy
-    // them to std::vector be passed to MPI.
-    std::vector<int> shared_users(coloring_info.shared_users.begin(),
-                                  coloring_info.shared_users.end());
-    std::vector<int> ghost_owners(coloring_info.ghost_owners.begin(),
-                                  coloring_info.ghost_owners.end());
-
-    MPI_Group comm_grp;
-    MPI_Comm_group(MPI_COMM_WORLD, &comm_grp);
+  //--------------------------------------------------------------------------//
+  //! Register the ghost metadata of a field. This is collective the first
+  //! time that an index space is used.
+  //!
+  //! @tparam T The field data type.
+  //!
+  //! @param fid            The field id.
+  //! @param index_space    The index space of the field.
+  //! @param index_coloring The coloring of the index space.
+  //--------------------------------------------------------------------------//
 
+  template<typename T>
+  void
+  register_field_metadata(
+    field_id_t fid,
+    size_t index_space,
+    const index_coloring_t & index_coloring
+  )
+  {
     field_metadata_t metadata;
-
-    MPI_Group_incl(comm_grp, shared_users.size(),
-                   shared_users.data(), &metadata.shared_users_grp);
-    MPI_Group_incl(comm_grp, ghost_owners.size(),
-                   ghost_owners.data(), &metadata.ghost_owners_grp);
-
-    std::map<int, std::vector<int>> origin_lens;
-    std::map<int, std::vector<int>> origin_disps;
-    std::map<int, std::vector<int>> target_lens;
-    std::map<int, std::vector<int>> target_disps;
-
-    for (auto ghost_owner : ghost_owners) {
-      origin_lens.insert({ghost_owner, {}});
-      origin_disps.insert({ghost_owner, {}});
-      target_lens.insert({ghost_owner, {}});
-      target_disps.insert({ghost_owner, {}});
-    }
-
-    int origin_index = 0;
-    for (const auto& ghost : index_coloring.ghost) {
-      origin_lens[ghost.rank].push_back(1);
-      origin_disps[ghost.rank].push_back(origin_index++);
-      target_lens[ghost.rank].push_back(1);
-      target_disps[ghost.rank].push_back(ghost.offset);
-    }
-
-//      if (my_color == 0) {
-//        for (auto ghost_owner : ghost_owners) {
-//          std::cout << "ghost owner: " << ghost_owner << std::endl;
-//          std::cout << "\torigin length: ";
-//          for (auto len : origin_lens[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//          std::cout << "\torigin disp: ";
-//          for (auto len : origin_disps[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//          std::cout << "\ttarget length: ";
-//          for (auto len : target_lens[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//
-//          std::cout << "\ttarget disp: ";
-//          for (auto len : target_disps[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//
-//        }
-//      }
-
-    std::map<int, std::vector<int>> compact_origin_lengs;
-    std::map<int, std::vector<int>> compact_origin_disps;
-
-    for (auto ghost_owner : ghost_owners) {
-      if (origin_disps.size() == 0)
-        break;
-
-      int count = 0;
-      compact_origin_lengs[ghost_owner].push_back(1);
-      compact_origin_disps[ghost_owner].push_back(
-        origin_disps[ghost_owner][0]);
-
-      for (int i = 1; i < origin_disps[ghost_owner].size(); i++) {
-        if (origin_disps[ghost_owner][i] - origin_disps[ghost_owner][i - 1] ==
-            1) {
-          compact_origin_lengs[ghost_owner].back() = compact_origin_lengs[ghost_owner].back() + 1;
-        } else {
-          compact_origin_lengs[ghost_owner].push_back(1);
-          compact_origin_disps[ghost_owner].push_back(origin_disps[ghost_owner][i]);
-        }
-      }
-    }
-
-//      if (my_color == 0) {
-//        for (auto ghost_owner : ghost_owners) {
-//          std::cout << "ghost owner: " << ghost_owner << std::endl;
-//          std::cout << "source compacted length: ";
-//          for (auto len : compact_origin_lengs[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//          std::cout << "source compacted disps: ";
-//          for (auto disp : compact_origin_disps[ghost_owner]) {
-//            std::cout << disp << " ";
-//          }
-//          std::cout << std::endl;
-//        }
-//      }
-
-    std::map<int, std::vector<int>> compact_target_lengs;
-    std::map<int, std::vector<int>> compact_target_disps;
-
-    for (auto ghost_owner : ghost_owners) {
-      if (target_disps.size() == 0)
-        break;
-
-      int count = 0;
-      compact_target_lengs[ghost_owner].push_back(1);
-      compact_target_disps[ghost_owner].push_back(target_disps[ghost_owner][0]);
-
-      for (int i = 1; i < target_disps[ghost_owner].size(); i++) {
-        if (target_disps[ghost_owner][i] - target_disps[ghost_owner][i - 1] == 1) {
-          compact_target_lengs[ghost_owner].back() = compact_target_lengs[ghost_owner].back() + 1;
-        } else {
-          compact_target_lengs[ghost_owner].push_back(1);
-          compact_target_disps[ghost_owner].push_back(target_disps[ghost_owner][i]);
-        }
-      }
-    }
-
-//      if (my_color == 0) {
-//        for (auto ghost_owner : ghost_owners) {
-//          std::cout << "ghost owner: " << ghost_owner << std::endl;
-//
-//          std::cout << "compacted target length: ";
-//          for (auto len : compact_target_lengs[ghost_owner]) {
-//            std::cout << len << " ";
-//          }
-//          std::cout << std::endl;
-//          std::cout << "compacted target disps: ";
-//          for (auto disp : compact_target_disps[ghost_owner]) {
-//            std::cout << disp << " ";
-//          }
-//          std::cout << std::endl;
-//        }
-//      }
-
-    for (auto ghost_owner : ghost_owners) {
-      MPI_Datatype origin_type;
-      MPI_Datatype target_type;
-
-      MPI_Type_indexed(compact_origin_lengs[ghost_owner].size(),
-                       compact_origin_lengs[ghost_owner].data(),
-                       compact_origin_disps[ghost_owner].data(),
-                       flecsi::coloring::mpi_typetraits__<T>::type(),
-                       &origin_type);
-      MPI_Type_commit(&origin_type);
-      metadata.origin_types.insert({ghost_owner, origin_type});
-
-      MPI_Type_indexed(compact_target_lengs[ghost_owner].size(),
-                       compact_target_lengs[ghost_owner].data(),
-                       compact_target_disps[ghost_owner].data(),
-                       flecsi::coloring::mpi_typetraits__<T>::type(),
-                       &target_type);
-      MPI_Type_commit(&target_type);
-      metadata.target_types.insert({ghost_owner, target_type});
-    }
-
-    auto data = field_data[fid].data();
-    auto shared_data = data + coloring_info.exclusive * sizeof(T);
-    MPI_Win_create(shared_data, coloring_info.shared * sizeof(T),
-                   sizeof(T), MPI_INFO_NULL, MPI_COMM_WORLD,
-                   &metadata.win);
+    metadata.plan = &ghost_plan(index_space, sizeof(T), index_coloring);
     field_metadata.insert({fid, metadata});
-  }
+  } // register_field_metadata
+
+  //--------------------------------------------------------------------------//
+  //! Return the ghost plan of an index space for an element size, building
+  //! it on first use.
+  //!
+  //! @param index_space    The index space.
+  //! @param element_size   The size in bytes of one field element.
+  //! @param index_coloring The coloring of the index space.
+  //--------------------------------------------------------------------------//
+
+  const ghost_plan_t &
+  ghost_plan(
+    size_t index_space,
+    size_t element_size,
+    const index_coloring_t & index_coloring
+  );
 
   std::map<field_id_t, field_metadata_t>&
   registered_field_metadata() {
     return field_metadata;
   };
 
+  //--------------------------------------------------------------------------//
+  //! The ghost_field_t type identifies the storage of one field that
+  //! takes part in a ghost exchange.
+  //--------------------------------------------------------------------------//
+
+  struct ghost_field_t {
+    field_id_t fid;
+    void * shared_data;
+    void * ghost_data;
+  }; // struct ghost_field_t
+
+  //--------------------------------------------------------------------------//
+  //! Refresh the ghosts of a set of fields. All fields that involve the
+  //! same peer are packed into a single message, so a task that reads the
+  //! ghosts of several fields pays one message per neighbor instead of one
+  //! synchronization epoch per field. The call returns once the ghost
+  //! data are valid.
+  //!
+  //! @param fields The fields to exchange. The order must be the same
+  //!               on every rank.
+  //--------------------------------------------------------------------------//
+
+  void
+  exchange_ghosts(
+    const std::vector<ghost_field_t> & fields
+  );
+
   void register_field_data(field_id_t fid,
                            size_t size) {
     // TODO: VERSIONS
@@ -440,6 +348,30 @@ struct mpi_context_policy_t
   }
 
 
+  //--------------------------------------------------------------------------//
+  //! Start a non-blocking global reduction of a single value. The returned
+  //! future only blocks in get() or wait(). Use mpi_reduction_batch_t to
+  //! fuse several reductions into one collective.
+  //!
+  //! @tparam OP The reduction operator, e.g., reduction::max_t.
+  //!
+  //! @param local The local contribution of this rank, either a value or
+  //!              a future.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename OP,
+    typename T
+  >
+  auto
+  reduce_async(const T & local)
+  {
+    mpi_reduction_batch_t batch;
+    auto future = batch.template add<OP>(local);
+    batch.start();
+    return future;
+  } // reduce_async
+
   int rank;
 
 private:
@@ -460,8 +392,37 @@ private:
 //    task_info_t
 //  > task_registry_;
 
+  //--------------------------------------------------------------------------//
+  //! The ghost_runs_t type stores element displacements compacted into
+  //! runs of consecutive elements.
+  //--------------------------------------------------------------------------//
+
+  struct ghost_runs_t {
+    std::vector<int> lengths;
+    std::vector<int> displacements;
+  }; // struct ghost_runs_t
+
+  //--------------------------------------------------------------------------//
+  //! The ghost_layout_t type stores, per peer, the runs of shared entities
+  //! that the peer ghosts and the runs of ghost entities that it owns. The
+  //! layout only depends on the index space.
+  //--------------------------------------------------------------------------//
+
+  struct ghost_layout_t {
+    std::map<int, ghost_runs_t> shared;
+    std::map<int, ghost_runs_t> ghost;
+  }; // struct ghost_layout_t
+
+  const ghost_layout_t &
+  ghost_layout(
+    size_t index_space,
+    const index_coloring_t & index_coloring
+  );
+
   std::map<field_id_t, std::vector<uint8_t>> field_data;
   std::map<field_id_t, field_metadata_t> field_metadata;
+  std::map<size_t, ghost_layout_t> ghost_layouts_;
+  std::map<std::pair<size_t, size_t>, ghost_plan_t> ghost_plans_;
 
   std::map<size_t, index_space_data_t> index_space_data_map_;
 
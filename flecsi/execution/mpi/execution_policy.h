@@ -20,6 +20,7 @@
 //! @date Initial file creation: Nov 15, 2015
 //----------------------------------------------------------------------------//
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -33,6 +34,7 @@
 #include "flecsi/execution/mpi/task_epilog.h"
 #include "flecsi/execution/mpi/finalize_handles.h"
 #include "flecsi/execution/mpi/future.h"
+#include "flecsi/execution/mpi/task_profiler.h"
 
 namespace flecsi {
 namespace execution {
@@ -164,6 +166,10 @@ struct mpi_execution_policy_t
      std::string name
   )
   {
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    mpi_task_profiler_t::instance().register_task(KEY, name);
+#endif
+
     return context_t::instance().template register_function<
       RETURN, ARG_TUPLE, DELEGATE, KEY>();
   } // register_task
@@ -191,29 +197,36 @@ struct mpi_execution_policy_t
     // Make a tuple from the task arguments.
     ARG_TUPLE task_args = std::make_tuple(args ...);
 
-    auto begin = std::chrono::high_resolution_clock::now();
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    using clock_t = std::chrono::high_resolution_clock;
+
+    auto begin = clock_t::now();
+#endif
+
     // run task_prolog to copy ghost cells.
     task_prolog_t task_prolog;
     task_prolog.walk(task_args);
-    auto end = std::chrono::high_resolution_clock::now();
-//    clog_rank(warn, 0) << "task_prolog:  "
-//              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
-//              << "us" << std::endl;
-
-    begin = std::chrono::high_resolution_clock::now();
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    auto ghost_begin = clock_t::now();
+#endif
+    task_prolog.launch_copies();
+
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    auto kernel_begin = clock_t::now();
+#endif
     auto fut = executor__<RETURN, ARG_TUPLE>::execute(fun, std::forward<ARG_TUPLE>(task_args));
-    end = std::chrono::high_resolution_clock::now();
-//    clog_rank(warn, 0) << "task_execute: "
-//              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
-//              << "us" << std::endl;
 
-    begin = std::chrono::high_resolution_clock::now();
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    auto epilog_begin = clock_t::now();
+#endif
     task_epilog_t task_epilog;
     task_epilog.walk(task_args);
-    end = std::chrono::high_resolution_clock::now();
-//    clog_rank(warn, 0)<< "task_epilog:  "
-//              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
-//              << "us" << std::endl;
+
+#if defined(ENABLE_MPI_TASK_PROFILER)
+    auto end = clock_t::now();
+    mpi_task_profiler_t::instance().record_task(KEY, begin, ghost_begin,
+      kernel_begin, epilog_begin, end);
+#endif
 
     finalize_handles_t finalize_handles;
     finalize_handles.walk(task_args);
@@ -221,6 +234,29 @@ struct mpi_execution_policy_t
     return fut;
   } // execute_task
 
+  //--------------------------------------------------------------------------//
+  //! MPI backend trace start and end. Tasks execute immediately in the MPI
+  //! backend, so there is no dependence analysis to memoize.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  begin_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+  } // begin_trace
+
+  static
+  void
+  end_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+  } // end_trace
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
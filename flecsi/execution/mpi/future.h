@@ -20,20 +20,99 @@
 //! \date Initial file creation: Nov 15, 2015
 //----------------------------------------------------------------------------//
 
+#include <cassert>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <vector>
+
+#include <mpi.h>
 
 namespace flecsi {
 namespace execution {
 
+//----------------------------------------------------------------------------//
+//! Outstanding non-blocking collective whose result is shared by one or
+//! more futures. The send and receive buffers must outlive the request,
+//! so the state completes the request before it is destroyed.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct mpi_request_state_t
+{
+  mpi_request_state_t() = default;
+  mpi_request_state_t(const mpi_request_state_t &) = delete;
+  mpi_request_state_t & operator = (const mpi_request_state_t &) = delete;
+
+  ~mpi_request_state_t()
+  {
+    wait();
+  } // ~mpi_request_state_t
+
+  ///
+  /// Block until the collective has completed.
+  ///
+  void
+  wait()
+  {
+    if(request != MPI_REQUEST_NULL) {
+      MPI_Wait(&request, MPI_STATUS_IGNORE);
+      complete();
+    } // if
+  } // wait
+
+  ///
+  /// Return true if the collective has completed, without blocking.
+  ///
+  bool
+  test()
+  {
+    if(request != MPI_REQUEST_NULL) {
+      int flag;
+      MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+
+      if(!flag) {
+        return false;
+      } // if
+
+      complete();
+    } // if
+
+    return true;
+  } // test
+
+  MPI_Request request = MPI_REQUEST_NULL;
+  std::vector<char> send;
+  std::vector<char> recv;
+
+  // Release resources that were only needed while the request was active.
+  std::function<void()> on_complete;
+
+private:
+
+  void
+  complete()
+  {
+    if(on_complete) {
+      on_complete();
+      on_complete = nullptr;
+    } // if
+  } // complete
+
+}; // struct mpi_request_state_t
+
 //----------------------------------------------------------------------------//
 // Future concept.
 //----------------------------------------------------------------------------//
 
 //----------------------------------------------------------------------------//
-//! Abstract interface type for MPI futures.
+//! Abstract interface type for MPI futures. A future either holds a value
+//! that was set directly, e.g., the return value of a task, or refers to a
+//! slot of a pending non-blocking collective. In the latter case, get()
+//! and wait() only block until that collective has completed.
 //!
-//! @ingroup legion-execution
+//! @ingroup mpi-execution
 //----------------------------------------------------------------------------//
 template<
   typename R
@@ -42,24 +121,69 @@ struct mpi_future__
 {
   using result_t = R;
 
+  mpi_future__() = default;
+
+  ///
+  /// Construct a future for the value at byte \e offset of the receive
+  /// buffer of a pending collective.
+  ///
+  mpi_future__(
+    std::shared_ptr<mpi_request_state_t> state,
+    size_t offset
+  )
+  : state_(std::move(state)),
+  offset_(offset)
+  {}
+
   ///
   /// wait() method
   ///
-  void wait() {}
+  void
+  wait() const
+  {
+    if(state_) {
+      state_->wait();
+      assert(state_->recv.size() >= offset_ + sizeof(result_t) &&
+        "collective was never started");
+      std::memcpy(&result_, &state_->recv[offset_], sizeof(result_t));
+      state_.reset();
+    } // if
+  } // wait
+
+  ///
+  /// Return true if get() will not block.
+  ///
+  bool
+  ready() const
+  {
+    return !state_ || state_->test();
+  } // ready
 
   ///
   /// get() mothod
   ///
-  const result_t & get(size_t index = 0) const { return result_; }
+  const result_t &
+  get(size_t index = 0) const
+  {
+    wait();
+    return result_;
+  } // get
 
 //private:
 
   ///
   /// set method
   ///
-  void set(const result_t & result) { result_ = result; }
-
-  result_t result_;
+  void
+  set(const result_t & result)
+  {
+    state_.reset();
+    result_ = result;
+  } // set
+
+  mutable result_t result_;
+  mutable std::shared_ptr<mpi_request_state_t> state_;
+  size_t offset_ = 0;
 
 }; // struct mpi_future__
 
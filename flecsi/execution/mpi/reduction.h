@@ -0,0 +1,292 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_reduction_h
+#define flecsi_execution_mpi_reduction_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 17, 2017
+//----------------------------------------------------------------------------//
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <cinchlog.h>
+#include <mpi.h>
+
+#include "flecsi/execution/mpi/future.h"
+
+namespace flecsi {
+namespace execution {
+namespace reduction {
+
+//----------------------------------------------------------------------------//
+// Reduction operators. An operator is a type with a static
+// apply(T & inout, const T & in) method that folds \e in into \e inout.
+// Custom operators only need to follow the same convention and must be
+// associative and commutative.
+//----------------------------------------------------------------------------//
+
+struct sum_t {
+  template<typename T>
+  static void apply(T & inout, const T & in) { inout += in; }
+}; // struct sum_t
+
+struct min_t {
+  template<typename T>
+  static void apply(T & inout, const T & in) { if(in < inout) inout = in; }
+}; // struct min_t
+
+struct max_t {
+  template<typename T>
+  static void apply(T & inout, const T & in) { if(inout < in) inout = in; }
+}; // struct max_t
+
+//----------------------------------------------------------------------------//
+//! Apply an operator to a value, element-wise for std::array values, so
+//! that small arrays, e.g., per-component bounds, reduce with the
+//! built-in operators.
+//----------------------------------------------------------------------------//
+
+template<typename OP, typename T>
+struct reducer__
+{
+  static void apply(T & inout, const T & in) { OP::apply(inout, in); }
+}; // struct reducer__
+
+template<typename OP, typename T, size_t N>
+struct reducer__<OP, std::array<T, N>>
+{
+  static
+  void
+  apply(
+    std::array<T, N> & inout,
+    const std::array<T, N> & in
+  )
+  {
+    for(size_t i = 0; i < N; ++i) {
+      reducer__<OP, T>::apply(inout[i], in[i]);
+    } // for
+  } // apply
+}; // struct reducer__
+
+} // namespace reduction
+
+//----------------------------------------------------------------------------//
+//! The mpi_reduction_batch_t type fuses several global reductions, which
+//! may have different operators and value types, into one
+//! MPI_Iallreduce. Values are packed into a byte buffer. The collective
+//! uses a single user-defined operator that folds each segment with its
+//! own operator. The layout reaches the operator through an attribute
+//! of the packed datatype.
+//!
+//! @code
+//! mpi_reduction_batch_t batch;
+//! auto dt = batch.add<reduction::min_t>(local_dt);
+//! auto mass = batch.add<reduction::sum_t>(local_mass);
+//! batch.start();
+//! // ... independent work ...
+//! double global_dt = dt.get();
+//! @endcode
+//!
+//! Every rank must add the same sequence of operators and types.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct mpi_reduction_batch_t
+{
+  mpi_reduction_batch_t()
+  : state_(std::make_shared<mpi_request_state_t>()),
+  layout_(std::make_shared<layout_t>())
+  {}
+
+  //--------------------------------------------------------------------------//
+  //! Add a value to the batch.
+  //!
+  //! @tparam OP The reduction operator, e.g., reduction::sum_t.
+  //! @tparam T  A trivially copyable value type.
+  //!
+  //! @param value The local contribution of this rank.
+  //!
+  //! @return A future for the global value, which becomes ready after
+  //!         start() has been called and the collective has completed.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename OP,
+    typename T
+  >
+  mpi_future__<T>
+  add(
+    const T & value
+  )
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+      "reduction values must be trivially copyable");
+    clog_assert(state_->request == MPI_REQUEST_NULL,
+      "cannot add to a batch that has been started");
+
+    const size_t offset = state_->send.size();
+
+    state_->send.resize(offset + sizeof(T));
+    std::memcpy(&state_->send[offset], &value, sizeof(T));
+
+    layout_->segments.push_back({offset, &apply__<OP, T>});
+
+    return { state_, offset };
+  } // add
+
+  //--------------------------------------------------------------------------//
+  //! Add the value of a future, e.g., the return value of a task.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename OP,
+    typename T
+  >
+  mpi_future__<T>
+  add(
+    const mpi_future__<T> & future
+  )
+  {
+    return add<OP>(future.get());
+  } // add
+
+  //--------------------------------------------------------------------------//
+  //! Start the fused, non-blocking reduction.
+  //--------------------------------------------------------------------------//
+
+  void
+  start()
+  {
+    clog_assert(state_->request == MPI_REQUEST_NULL,
+      "batch has already been started");
+
+    if(layout_->segments.empty()) {
+      return;
+    } // if
+
+    state_->recv.resize(state_->send.size());
+
+    MPI_Datatype type;
+    MPI_Type_contiguous(state_->send.size(), MPI_BYTE, &type);
+    MPI_Type_set_attr(type, keyval(), layout_.get());
+    MPI_Type_commit(&type);
+
+    MPI_Iallreduce(state_->send.data(), state_->recv.data(), 1, type, op(),
+      MPI_COMM_WORLD, &state_->request);
+
+    // The layout must stay alive while the operator may still be invoked.
+    auto layout = layout_;
+    state_->on_complete = [type, layout]() mutable {
+      MPI_Type_free(&type);
+    };
+  } // start
+
+private:
+
+  using apply_t = void (*)(char *, const char *);
+
+  struct segment_t {
+    size_t offset;
+    apply_t apply;
+  }; // struct segment_t
+
+  struct layout_t {
+    std::vector<segment_t> segments;
+  }; // struct layout_t
+
+  // The buffers handed to the operator are only byte aligned, so the
+  // values are copied out and back.
+  template<typename OP, typename T>
+  static
+  void
+  apply__(
+    char * inout,
+    const char * in
+  )
+  {
+    T a, b;
+    std::memcpy(&a, inout, sizeof(T));
+    std::memcpy(&b, in, sizeof(T));
+    reduction::reducer__<OP, T>::apply(a, b);
+    std::memcpy(inout, &a, sizeof(T));
+  } // apply__
+
+  static
+  void
+  reduce_segments(
+    void * in,
+    void * inout,
+    int * len,
+    MPI_Datatype * type
+  )
+  {
+    void * attr;
+    int flag;
+    MPI_Type_get_attr(*type, keyval(), &attr, &flag);
+    clog_assert(flag, "missing reduction layout");
+
+    const layout_t & layout = *static_cast<layout_t *>(attr);
+
+    MPI_Aint lb, extent;
+    MPI_Type_get_extent(*type, &lb, &extent);
+
+    for(int i = 0; i < *len; ++i) {
+      char * io = static_cast<char *>(inout) + i * extent;
+      const char * ii = static_cast<const char *>(in) + i * extent;
+
+      for(auto & s: layout.segments) {
+        s.apply(io + s.offset, ii + s.offset);
+      } // for
+    } // for
+  } // reduce_segments
+
+  static
+  int
+  keyval()
+  {
+    static int keyval = MPI_KEYVAL_INVALID;
+
+    if(keyval == MPI_KEYVAL_INVALID) {
+      MPI_Type_create_keyval(MPI_TYPE_NULL_COPY_FN, MPI_TYPE_NULL_DELETE_FN,
+        &keyval, nullptr);
+    } // if
+
+    return keyval;
+  } // keyval
+
+  static
+  MPI_Op
+  op()
+  {
+    static MPI_Op op = MPI_OP_NULL;
+
+    if(op == MPI_OP_NULL) {
+      MPI_Op_create(&reduce_segments, 1, &op);
+    } // if
+
+    return op;
+  } // op
+
+  std::shared_ptr<mpi_request_state_t> state_;
+  std::shared_ptr<layout_t> layout_;
+
+}; // struct mpi_reduction_batch_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_reduction_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -53,7 +53,8 @@ remap_shared_entities()
     std::vector<size_t> ghost_index(index_coloring.ghost.size());
 
     MPI_Status status;
-    std::set<flecsi::coloring::entity_info_t> new_ghost;
+    flecsi::coloring::index_coloring_t::entity_set_t new_ghost;
+    new_ghost.reserve(index_coloring.ghost.size());
 
     for (auto ghost : index_coloring.ghost) {
       MPI_Recv(&index, 1, MPI_UNSIGNED_LONG_LONG,
@@ -21,8 +21,15 @@
   #include <mpi.h>
 #endif
 
+#include <cstdlib>
+#include <iostream>
+
 #include <flecsi/execution/context.h>
 
+#if defined(ENABLE_MPI_TASK_PROFILER)
+  #include <flecsi/execution/mpi/task_profiler.h>
+#endif
+
 // Boost command-line options
 #if defined(ENABLE_BOOST_PROGRAM_OPTIONS)
   #include <boost/program_options.hpp>
@@ -111,6 +118,14 @@ int main(int argc, char ** argv) {
   // Execute the flecsi runtime.
   auto retval = flecsi::execution::context_t::instance().initialize(argc, argv);
 
+#if defined(ENABLE_MPI_TASK_PROFILER)
+  // Report the task profile. The trace file name can be overridden with
+  // FLECSI_TRACE_FILE; an empty value disables the trace.
+  const char * trace_file = std::getenv("FLECSI_TRACE_FILE");
+  flecsi::execution::mpi_task_profiler_t::instance().finalize(std::cout,
+    trace_file ? trace_file : "flecsi_trace.json");
+#endif
+
   // Shutdown the MPI runtime
   MPI_Finalize();
 
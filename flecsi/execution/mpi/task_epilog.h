@@ -49,7 +49,10 @@ namespace execution {
     task_epilog_t() = default;
 
     //------------------------------------------------------------------------//
-    //! FIXME: Need a description.
+    //! Walk the data handles for a flecsi task and mark the fields whose
+    //! shared indices were written as dirty. The ghost copies are not
+    //! refreshed here, but by the task_prolog_t of the first task that
+    //! reads the ghosts of a dirty field.
     //!
     //! @tparam T                     The data type referenced by the handle.
     //! @tparam EXCLUSIVE_PERMISSIONS The permissions required on the exclusive
@@ -77,30 +80,13 @@ namespace execution {
       > & h
     )
     {
-      // Skip Read Only handles
-      if (EXCLUSIVE_PERMISSIONS == ro && SHARED_PERMISSIONS == ro)
+      // Ghost indices mirror the shared indices of their owners, so only
+      // a write to the shared indices makes them stale.
+      if (SHARED_PERMISSIONS != wo && SHARED_PERMISSIONS != rw)
         return;
 
       auto& context = context_t::instance();
-      const int my_color = context.color();
-      auto& my_coloring_info =
-        context.coloring_info(h.index_space).at(my_color);
-
-      auto& field_metadata = context.registered_field_metadata().at(h.fid);
-
-      MPI_Win win = field_metadata.win;
-
-      MPI_Win_post(field_metadata.shared_users_grp, 0, win);
-      MPI_Win_start(field_metadata.ghost_owners_grp, 0, win);
-
-      for (auto ghost_owner : my_coloring_info.ghost_owners) {
-        MPI_Get(h.ghost_data, 1, field_metadata.origin_types[ghost_owner],
-                ghost_owner, 0, 1, field_metadata.target_types[ghost_owner],
-                win);
-      }
-
-      MPI_Win_complete(win);
-      MPI_Win_wait(win);
+      context.registered_field_metadata().at(h.fid).dirty = true;
     } // handle
 
     //------------------------------------------------------------------------//
@@ -0,0 +1,337 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 17, 2017
+//----------------------------------------------------------------------------//
+
+#include "flecsi/execution/mpi/task_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <mpi.h>
+
+namespace flecsi {
+namespace execution {
+
+namespace {
+
+//----------------------------------------------------------------------------//
+// Gather the union of the keys of every rank, in sorted order.
+//----------------------------------------------------------------------------//
+
+template<typename K, typename V>
+std::vector<unsigned long long>
+global_keys(
+  const std::map<K, V> & local
+)
+{
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<unsigned long long> keys;
+  for(auto & entry: local) {
+    keys.push_back(entry.first);
+  } // for
+
+  int count = keys.size();
+  std::vector<int> counts(size);
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+    MPI_COMM_WORLD);
+
+  std::vector<int> displs(size + 1, 0);
+  for(int r = 0; r < size; ++r) {
+    displs[r + 1] = displs[r] + counts[r];
+  } // for
+
+  std::vector<unsigned long long> all(displs[size]);
+  MPI_Allgatherv(keys.data(), count, MPI_UNSIGNED_LONG_LONG, all.data(),
+    counts.data(), displs.data(), MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD);
+
+  std::sort(all.begin(), all.end());
+  all.erase(std::unique(all.begin(), all.end()), all.end());
+
+  return all;
+} // global_keys
+
+//----------------------------------------------------------------------------//
+// Reduce a set of per-key values to their minimum, maximum and sum on
+// rank 0.
+//----------------------------------------------------------------------------//
+
+struct reduced_t {
+  std::vector<double> min;
+  std::vector<double> max;
+  std::vector<double> sum;
+}; // struct reduced_t
+
+reduced_t
+reduce(
+  std::vector<double> & values
+)
+{
+  reduced_t r;
+  r.min.resize(values.size());
+  r.max.resize(values.size());
+  r.sum.resize(values.size());
+
+  MPI_Reduce(values.data(), r.min.data(), values.size(), MPI_DOUBLE,
+    MPI_MIN, 0, MPI_COMM_WORLD);
+  MPI_Reduce(values.data(), r.max.data(), values.size(), MPI_DOUBLE,
+    MPI_MAX, 0, MPI_COMM_WORLD);
+  MPI_Reduce(values.data(), r.sum.data(), values.size(), MPI_DOUBLE,
+    MPI_SUM, 0, MPI_COMM_WORLD);
+
+  return r;
+} // reduce
+
+} // namespace
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_task_profiler_t::record_task.
+//----------------------------------------------------------------------------//
+
+void
+mpi_task_profiler_t::record_task(
+  size_t key,
+  time_point_t begin,
+  time_point_t ghost_begin,
+  time_point_t kernel_begin,
+  time_point_t epilog_begin,
+  time_point_t end
+)
+{
+  using seconds_t = std::chrono::duration<double>;
+
+  auto & stats = tasks_[key];
+  ++stats.calls;
+  stats.prolog += seconds_t(kernel_begin - begin).count();
+  stats.ghost += seconds_t(kernel_begin - ghost_begin).count();
+  stats.kernel += seconds_t(epilog_begin - kernel_begin).count();
+  stats.epilog += seconds_t(end - epilog_begin).count();
+
+  if(ghost_begin != kernel_begin) {
+    add_event(key, "ghost", ghost_begin, kernel_begin);
+  } // if
+
+  add_event(key, "kernel", kernel_begin, epilog_begin);
+} // mpi_task_profiler_t::record_task
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_task_profiler_t::add_event.
+//----------------------------------------------------------------------------//
+
+void
+mpi_task_profiler_t::add_event(
+  size_t key,
+  const char * phase,
+  time_point_t begin,
+  time_point_t end
+)
+{
+  if(events_.size() >= max_trace_events) {
+    return;
+  } // if
+
+  using microseconds_t = std::chrono::duration<double, std::micro>;
+
+  events_.push_back({key, phase, microseconds_t(begin - start_).count(),
+    microseconds_t(end - begin).count()});
+} // mpi_task_profiler_t::add_event
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_task_profiler_t::name.
+//----------------------------------------------------------------------------//
+
+std::string
+mpi_task_profiler_t::name(
+  size_t key
+)
+const
+{
+  auto itr = names_.find(key);
+
+  if(itr != names_.end()) {
+    return itr->second;
+  } // if
+
+  std::stringstream ss;
+  ss << std::hex << key;
+  return ss.str();
+} // mpi_task_profiler_t::name
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_task_profiler_t::finalize.
+//----------------------------------------------------------------------------//
+
+void
+mpi_task_profiler_t::finalize(
+  std::ostream & stream,
+  const std::string & trace_file
+)
+{
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  //--------------------------------------------------------------------------//
+  // Task table.
+  //--------------------------------------------------------------------------//
+
+  auto task_keys = global_keys(tasks_);
+  const size_t nt = task_keys.size();
+
+  // calls, kernel, ghost, prolog, epilog per key
+  std::vector<double> task_values(5 * nt, 0.0);
+
+  for(size_t i = 0; i < nt; ++i) {
+    auto itr = tasks_.find(task_keys[i]);
+
+    if(itr == tasks_.end()) {
+      continue;
+    } // if
+
+    task_values[i] = itr->second.calls;
+    task_values[nt + i] = itr->second.kernel;
+    task_values[2 * nt + i] = itr->second.ghost;
+    task_values[3 * nt + i] = itr->second.prolog - itr->second.ghost;
+    task_values[4 * nt + i] = itr->second.epilog;
+  } // for
+
+  auto tr = reduce(task_values);
+
+  //--------------------------------------------------------------------------//
+  // Field table.
+  //--------------------------------------------------------------------------//
+
+  auto field_keys = global_keys(fields_);
+  const size_t nf = field_keys.size();
+
+  // exchanges, bytes sent, bytes received per fid
+  std::vector<double> field_values(3 * nf, 0.0);
+
+  for(size_t i = 0; i < nf; ++i) {
+    auto itr = fields_.find(field_keys[i]);
+
+    if(itr == fields_.end()) {
+      continue;
+    } // if
+
+    field_values[i] = itr->second.exchanges;
+    field_values[nf + i] = itr->second.bytes_sent;
+    field_values[2 * nf + i] = itr->second.bytes_received;
+  } // for
+
+  auto fr = reduce(field_values);
+
+  if(rank == 0 && nt > 0) {
+    // Names are registered identically on every rank.
+    stream << "FleCSI MPI task profile (" << size << " ranks, times in "
+      "seconds, min/mean/max across ranks)" << std::endl;
+
+    stream << std::left << std::setw(32) << "task" << std::right <<
+      std::setw(10) << "calls" <<
+      std::setw(36) << "kernel" <<
+      std::setw(36) << "ghost" <<
+      std::setw(14) << "prolog max" <<
+      std::setw(14) << "epilog max" << std::endl;
+
+    auto triple = [&](const reduced_t & r, size_t i) {
+      std::stringstream ss;
+      ss << std::scientific << std::setprecision(3) << r.min[i] << "/" <<
+        r.sum[i] / size << "/" << r.max[i];
+      return ss.str();
+    };
+
+    for(size_t i = 0; i < nt; ++i) {
+      stream << std::left << std::setw(32) << name(task_keys[i]) <<
+        std::right <<
+        std::setw(10) << size_t(tr.max[i]) <<
+        std::setw(36) << triple(tr, nt + i) <<
+        std::setw(36) << triple(tr, 2 * nt + i) <<
+        std::setw(14) << std::scientific << std::setprecision(3) <<
+          tr.max[3 * nt + i] <<
+        std::setw(14) << tr.max[4 * nt + i] << std::endl;
+    } // for
+
+    stream.unsetf(std::ios::floatfield);
+  } // if
+
+  if(rank == 0 && nf > 0) {
+    stream << std::left << std::setw(12) << "field" << std::right <<
+      std::setw(12) << "exchanges" <<
+      std::setw(20) << "bytes sent" <<
+      std::setw(20) << "bytes received" <<
+      std::setw(20) << "max rank bytes" << std::endl;
+
+    for(size_t i = 0; i < nf; ++i) {
+      stream << std::left << std::setw(12) << field_keys[i] << std::right <<
+        std::setw(12) << size_t(fr.max[i]) <<
+        std::setw(20) << size_t(fr.sum[nf + i]) <<
+        std::setw(20) << size_t(fr.sum[2 * nf + i]) <<
+        std::setw(20) << size_t(fr.max[nf + i]) << std::endl;
+    } // for
+  } // if
+
+  //--------------------------------------------------------------------------//
+  // Chrome trace, one process per rank.
+  //--------------------------------------------------------------------------//
+
+  if(trace_file.empty()) {
+    return;
+  } // if
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+
+  for(auto & e: events_) {
+    ss << "{\"name\":\"" << name(e.key) << "\",\"cat\":\"" << e.phase <<
+      "\",\"ph\":\"X\",\"pid\":" << rank << ",\"tid\":0,\"ts\":" <<
+      e.begin << ",\"dur\":" << e.duration << "},\n";
+  } // for
+
+  std::string local = ss.str();
+  int count = local.size();
+
+  std::vector<int> counts(size);
+  MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0,
+    MPI_COMM_WORLD);
+
+  std::vector<int> displs(size + 1, 0);
+  for(int r = 0; r < size; ++r) {
+    displs[r + 1] = displs[r] + counts[r];
+  } // for
+
+  std::vector<char> all(rank == 0 ? displs[size] : 0);
+  MPI_Gatherv(&local[0], count, MPI_CHAR, all.data(), counts.data(),
+    displs.data(), MPI_CHAR, 0, MPI_COMM_WORLD);
+
+  if(rank == 0) {
+    std::ofstream trace(trace_file);
+
+    trace << "{\"traceEvents\":[\n";
+    trace.write(all.data(), all.size());
+
+    for(int r = 0; r < size; ++r) {
+      trace << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << r <<
+        ",\"args\":{\"name\":\"rank " << r << "\"}}" <<
+        (r + 1 < size ? ",\n" : "\n");
+    } // for
+
+    trace << "]}" << std::endl;
+  } // if
+} // mpi_task_profiler_t::finalize
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
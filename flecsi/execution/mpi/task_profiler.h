@@ -0,0 +1,225 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_task_profiler_h
+#define flecsi_execution_mpi_task_profiler_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 17, 2017
+//----------------------------------------------------------------------------//
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "flecsi/runtime/types.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The mpi_task_profiler_t type accumulates per-task timings and per-field
+//! ghost communication volumes for the MPI runtime. Recording is enabled
+//! with ENABLE_MPI_TASK_PROFILER. At exit, runtime_main calls finalize to
+//! print a table of cross-rank statistics and to write a Chrome trace
+//! (chrome://tracing) with one process per rank.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct mpi_task_profiler_t
+{
+  using clock_t = std::chrono::high_resolution_clock;
+  using time_point_t = clock_t::time_point;
+
+  //--------------------------------------------------------------------------//
+  //! Accumulated statistics of one task key on the local rank. Times are
+  //! in seconds.
+  //--------------------------------------------------------------------------//
+
+  struct task_stats_t {
+    size_t calls = 0;
+    double prolog = 0.0;
+    double ghost = 0.0;
+    double kernel = 0.0;
+    double epilog = 0.0;
+  }; // struct task_stats_t
+
+  //--------------------------------------------------------------------------//
+  //! Accumulated ghost communication of one field on the local rank.
+  //--------------------------------------------------------------------------//
+
+  struct field_stats_t {
+    size_t exchanges = 0;
+    size_t bytes_sent = 0;
+    size_t bytes_received = 0;
+  }; // struct field_stats_t
+
+  //--------------------------------------------------------------------------//
+  //! Myer's singleton instance.
+  //!
+  //! @return The single instance of this type.
+  //--------------------------------------------------------------------------//
+
+  static
+  mpi_task_profiler_t &
+  instance()
+  {
+    static mpi_task_profiler_t profiler;
+    return profiler;
+  } // instance
+
+  //--------------------------------------------------------------------------//
+  //! Associate a readable name with a task key.
+  //!
+  //! @param key  The task hash key.
+  //! @param name The task name.
+  //--------------------------------------------------------------------------//
+
+  void
+  register_task(
+    size_t key,
+    const std::string & name
+  )
+  {
+    names_[key] = name;
+  } // register_task
+
+  //--------------------------------------------------------------------------//
+  //! Record one execution of a task.
+  //!
+  //! @param key          The task hash key.
+  //! @param begin        Start of the prolog.
+  //! @param ghost_begin  Start of the ghost exchange in the prolog.
+  //! @param kernel_begin End of the prolog and start of the user kernel.
+  //! @param epilog_begin End of the user kernel and start of the epilog.
+  //! @param end          End of the epilog.
+  //--------------------------------------------------------------------------//
+
+  void
+  record_task(
+    size_t key,
+    time_point_t begin,
+    time_point_t ghost_begin,
+    time_point_t kernel_begin,
+    time_point_t epilog_begin,
+    time_point_t end
+  );
+
+  //--------------------------------------------------------------------------//
+  //! Record the volume of one ghost exchange for a field.
+  //!
+  //! @param fid            The field id.
+  //! @param bytes_sent     Bytes sent to all peers.
+  //! @param bytes_received Bytes received from all peers.
+  //--------------------------------------------------------------------------//
+
+  void
+  record_ghost_exchange(
+    field_id_t fid,
+    size_t bytes_sent,
+    size_t bytes_received
+  )
+  {
+    auto & stats = fields_[fid];
+    ++stats.exchanges;
+    stats.bytes_sent += bytes_sent;
+    stats.bytes_received += bytes_received;
+  } // record_ghost_exchange
+
+  //--------------------------------------------------------------------------//
+  //! Return the statistics gathered on this rank.
+  //--------------------------------------------------------------------------//
+
+  const std::map<size_t, task_stats_t> &
+  tasks()
+  const
+  {
+    return tasks_;
+  } // tasks
+
+  const std::map<field_id_t, field_stats_t> &
+  fields()
+  const
+  {
+    return fields_;
+  } // fields
+
+  //--------------------------------------------------------------------------//
+  //! Reduce the statistics across MPI_COMM_WORLD and write the report.
+  //! This is collective.
+  //!
+  //! @param stream     The stream that rank 0 prints the table to.
+  //! @param trace_file The Chrome trace file written by rank 0. No trace is
+  //!                   written if this is empty.
+  //--------------------------------------------------------------------------//
+
+  void
+  finalize(
+    std::ostream & stream,
+    const std::string & trace_file
+  );
+
+private:
+
+  mpi_task_profiler_t()
+  : start_(clock_t::now()) {}
+
+  ~mpi_task_profiler_t() {}
+
+  mpi_task_profiler_t(const mpi_task_profiler_t &) = delete;
+  mpi_task_profiler_t & operator = (const mpi_task_profiler_t &) = delete;
+
+  //--------------------------------------------------------------------------//
+  //! A complete ("X") Chrome trace event. Times are in microseconds since
+  //! the profiler was created.
+  //--------------------------------------------------------------------------//
+
+  struct trace_event_t {
+    size_t key;
+    const char * phase;
+    double begin;
+    double duration;
+  }; // struct trace_event_t
+
+  // Bound on the number of recorded trace events per rank, so that long
+  // runs do not grow without limit. Statistics are always accumulated.
+  static constexpr size_t max_trace_events = 1 << 20;
+
+  void
+  add_event(
+    size_t key,
+    const char * phase,
+    time_point_t begin,
+    time_point_t end
+  );
+
+  std::string
+  name(
+    size_t key
+  )
+  const;
+
+  time_point_t start_;
+  std::map<size_t, std::string> names_;
+  std::map<size_t, task_stats_t> tasks_;
+  std::map<field_id_t, field_stats_t> fields_;
+  std::vector<trace_event_t> events_;
+
+}; // struct mpi_task_profiler_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_task_profiler_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
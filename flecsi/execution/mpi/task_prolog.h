@@ -26,6 +26,7 @@
 #include "flecsi/data/data.h"
 #include "flecsi/execution/context.h"
 #include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 
 namespace flecsi {
 namespace execution {
@@ -50,7 +51,9 @@ namespace execution {
 
 
     //------------------------------------------------------------------------//
-    //! FIXME: Need a description.
+    //! Walk the data handles for a flecsi task and collect the fields
+    //! whose ghosts are read by the task but are stale, so that they can
+    //! be refreshed by launch_copies.
     //!
     //! @tparam T                     The data type referenced by the handle.
     //! @tparam EXCLUSIVE_PERMISSIONS The permissions required on the exclusive
@@ -59,9 +62,6 @@ namespace execution {
     //!                               indices of the index partition.
     //! @tparam GHOST_PERMISSIONS     The permissions required on the ghost
     //!                               indices of the index partition.
-    //!
-    //! @param runtime The Legion task runtime.
-    //! @param context The Legion task runtime context.
     //------------------------------------------------------------------------//
 
     template<
@@ -81,13 +81,52 @@ namespace execution {
     )
     {
       // TODO: move field data allocation here?
+
+      if (GHOST_PERMISSIONS != ro && GHOST_PERMISSIONS != rw)
+        return;
+
+      auto& context = context_t::instance();
+      auto& field_metadata = context.registered_field_metadata().at(h.fid);
+
+      if (field_metadata.dirty) {
+        stale_fields.push_back({h.fid, h.shared_data, h.ghost_data});
+        field_metadata.dirty = false;
+      } // if
     } // handle
 
+    //------------------------------------------------------------------------//
+    //! Use the fields collected by the walk to refresh all stale ghosts
+    //! with one aggregated exchange before the task runs.
+    //------------------------------------------------------------------------//
+
+    void launch_copies()
+    {
+      if (stale_fields.empty())
+        return;
+
+      context_t::instance().exchange_ghosts(stale_fields);
+    } // launch_copies
+
     template<
       typename T,
       size_t PERMISSIONS
     >
-    void
+    std::enable_if_t<topology::is_structured_mesh_topology__<
+      typename T::type_identifier_t>::value>
+    handle(
+      data_client_handle__<T, PERMISSIONS> &
+    )
+    {
+      // Structured topologies compute their entities from their box, so
+      // there is no storage to initialize.
+    } // handle
+
+    template<
+      typename T,
+      size_t PERMISSIONS
+    >
+    std::enable_if_t<!topology::is_structured_mesh_topology__<
+      typename T::type_identifier_t>::value>
     handle(
       data_client_handle__<T, PERMISSIONS> & h
     )
@@ -204,6 +243,8 @@ namespace execution {
     {
     } // handle
 
+    std::vector<context_t::ghost_field_t> stale_fields;
+
   }; // struct task_prolog_t
 
 } // namespace execution 
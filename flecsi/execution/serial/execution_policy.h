@@ -231,6 +231,27 @@ struct serial_execution_policy_t
     return executor__<RETURN, ARG_TUPLE>::execute(fun, std::forward_as_tuple(args ...));
   } // execute_task
 
+  ///
+  /// Serial backend trace start and end. These are no-ops.
+  ///
+  static
+  void
+  begin_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+  } // begin_trace
+
+  static
+  void
+  end_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+  } // end_trace
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
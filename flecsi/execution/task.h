@@ -148,6 +148,44 @@ struct task_model__
       launch, parent, std::forward<ARGS>(args) ...);
   } // execute_task
 
+  //--------------------------------------------------------------------------//
+  //! Start a trace. Backends that support tracing, e.g., Legion, record the
+  //! dependence analysis of the task launches issued until the matching
+  //! end_trace, and replay it when a trace with the same id is issued
+  //! again. Every instance of a trace must issue the same sequence of tasks
+  //! with the same arguments and privileges. Traces cannot be nested.
+  //!
+  //! @param id     The trace id.
+  //! @param parent A hash key that uniquely identifies the calling task.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  begin_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+    EXECUTION_POLICY::begin_trace(id, parent);
+  } // begin_trace
+
+  //--------------------------------------------------------------------------//
+  //! End a trace.
+  //!
+  //! @param id     The trace id.
+  //! @param parent A hash key that uniquely identifies the calling task.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  end_trace(
+    size_t id,
+    size_t parent
+  )
+  {
+    EXECUTION_POLICY::end_trace(id, parent);
+  } // end_trace
+
 }; // struct task__
 
 } // namespace execution
@@ -200,6 +238,39 @@ class task_t : public base_task_t
 
 using task_model_t = task_model__<FLECSI_RUNTIME_EXECUTION_POLICY>;
 
+//----------------------------------------------------------------------------//
+//! The trace_guard_t type traces the task launches issued during its
+//! lifetime. See task_model__::begin_trace.
+//!
+//! @ingroup execution
+//----------------------------------------------------------------------------//
+
+struct trace_guard_t
+{
+  trace_guard_t(
+    size_t id,
+    size_t parent
+  )
+  : id_(id), parent_(parent)
+  {
+    task_model_t::begin_trace(id_, parent_);
+  } // trace_guard_t
+
+  ~trace_guard_t()
+  {
+    task_model_t::end_trace(id_, parent_);
+  } // ~trace_guard_t
+
+  trace_guard_t(const trace_guard_t &) = delete;
+  trace_guard_t & operator = (const trace_guard_t &) = delete;
+
+private:
+
+  size_t id_;
+  size_t parent_;
+
+}; // struct trace_guard_t
+
 //----------------------------------------------------------------------------//
 //! Use the execution policy to define the future type.
 //!
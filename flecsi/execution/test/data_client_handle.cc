@@ -205,6 +205,25 @@ void print_task(client_handle_t<test_mesh_t, ro> mesh,
   }
 } // print_task
 
+//----------------------------------------------------------------------------//
+// Check that the compact connectivity storage of the mesh gives the same
+// adjacencies as the full connectivity.
+//----------------------------------------------------------------------------//
+
+void compact_task(client_handle_t<test_mesh_t, ro> mesh) {
+  for(auto c: mesh.entities<2, 0>()) {
+    auto full = mesh.entities<0, 0>(c);
+    auto compact = mesh.local_entities<0, 0>(c);
+
+    ASSERT_EQ(full.size(), compact.size());
+
+    size_t i(0);
+    for(auto v: full) {
+      ASSERT_EQ(v->template id<0>(), compact[i++]);
+    } // for
+  } // for
+} // compact_task
+
 void hello() {
   clog(info) << "Hello!!!" << std::endl;
 } // hello
@@ -217,6 +236,7 @@ flecsi_register_field(test_mesh_t, hydro, pressure, double, dense, 1, 0);
 
 flecsi_register_task(fill_task, loc, single);
 flecsi_register_task(print_task, loc, single);
+flecsi_register_task(compact_task, loc, single);
 flecsi_register_task(hello, loc, single);
 
 namespace flecsi {
@@ -276,6 +296,13 @@ void specialization_spmd_init(int argc, char ** argv) {
   f2.wait();
   } // scope
 
+  {
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+
+  auto f3 = flecsi_execute_task(compact_task, single, ch);
+  f3.wait();
+  } // scope
+
 } // specialization_spmd_init
 
 //----------------------------------------------------------------------------//
@@ -0,0 +1,171 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 17, 2017
+///
+
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/topology/structured_mesh_topology.h"
+
+using namespace flecsi;
+using namespace topology;
+
+class test_mesh_types_t {
+public:
+  static constexpr size_t num_dimensions = 2;
+}; // class test_mesh_types_t
+
+struct test_mesh_t : public structured_mesh_topology_t<test_mesh_types_t> {};
+
+// Cells of the global mesh
+const test_mesh_t::coord_t extents = {{4, 4}};
+
+// Cells are in index space 2.
+const size_t cells = 2;
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_field(test_mesh_t, hydro, pressure, double, dense, 2, cells);
+flecsi_register_field(test_mesh_t, hydro, density, double, dense, 1, cells);
+flecsi_register_field(test_mesh_t, hydro, zones, int, dense, 1, cells);
+flecsi_register_field(test_mesh_t, material, fraction, double, dense, 1,
+  cells);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Color the cells by block decomposition.
+//----------------------------------------------------------------------------//
+
+void add_structured_colorings() {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const auto grid = test_mesh_t::block_grid(extents, size);
+
+  coloring::index_coloring_t local;
+  std::unordered_map<size_t, coloring::coloring_info_t> coloring_info;
+
+  for(int color(0); color < size; ++color) {
+    coloring::index_coloring_t c;
+    auto box = test_mesh_t::color_block(cells, extents, grid, color, 1,
+      c, coloring_info[color]);
+
+    if(color == rank) {
+      local = std::move(c);
+      test_mesh_t::set_local_box(box);
+    } // if
+  } // for
+
+  context_t::instance().add_coloring(cells, local, coloring_info);
+} // add_structured_colorings
+
+flecsi_register_mpi_task(add_structured_colorings);
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  flecsi_execute_mpi_task(add_structured_colorings);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  const size_t client_hash =
+    typeid(test_mesh_t::type_identifier_t).hash_code();
+  const size_t hydro = utils::const_string_t{"hydro"}.hash();
+  const size_t material = utils::const_string_t{"material"}.hash();
+
+  // Every version of a field is registered as a separate field.
+  auto & doubles = context.fields_of_type(client_hash, data::dense,
+    typeid(double).hash_code());
+  ASSERT_EQ(4, doubles.size());
+
+  for(size_t i(1); i < doubles.size(); ++i) {
+    ASSERT_LE(std::make_pair(doubles[i-1]->namespace_hash,
+      doubles[i-1]->name_hash), std::make_pair(doubles[i]->namespace_hash,
+      doubles[i]->name_hash));
+  } // for
+
+  for(auto fi: doubles) {
+    ASSERT_EQ(typeid(double).hash_code(), fi->type_hash);
+    ASSERT_EQ(client_hash, fi->data_client_hash);
+  } // for
+
+  auto & ints = context.fields_of_type(client_hash, data::dense,
+    typeid(int).hash_code());
+  ASSERT_EQ(1, ints.size());
+  ASSERT_EQ(utils::const_string_t{"zones"}.hash(), ints[0]->name_hash);
+
+  ASSERT_TRUE(context.fields_of_type(client_hash, data::dense,
+    typeid(float).hash_code()).empty());
+
+  auto range = context.fields_of_type(client_hash, data::dense,
+    typeid(double).hash_code(), material);
+  ASSERT_EQ(1, std::distance(range.first, range.second));
+  ASSERT_EQ(utils::const_string_t{"fraction"}.hash(),
+    (*range.first)->name_hash);
+
+  range = context.fields_of_type(client_hash, data::dense,
+    typeid(double).hash_code(), hydro);
+  ASSERT_EQ(3, std::distance(range.first, range.second));
+
+  // The handle lookups go through the same index.
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+
+  auto handles = flecsi_get_handles(ch, hydro, double, dense, 0,
+    [](const auto &) { return true; });
+  ASSERT_EQ(2, handles.size());
+
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, dense, 0);
+  auto dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  ASSERT_TRUE((handles[0].fid == ph.fid && handles[1].fid == dh.fid) ||
+    (handles[0].fid == dh.fid && handles[1].fid == ph.fid));
+
+  handles = flecsi_get_handles(ch, hydro, double, dense, 1,
+    [](const auto &) { return true; });
+  ASSERT_EQ(1, handles.size());
+  ASSERT_EQ(
+    (flecsi_get_handle(ch, hydro, pressure, double, dense, 1)).fid,
+    handles[0].fid);
+
+  handles = flecsi_get_handles_all(ch, double, dense, 0,
+    [](const auto &) { return true; });
+  ASSERT_EQ(3, handles.size());
+
+  auto zones = flecsi_get_handles_all(ch, int, dense, 0,
+    [](const auto &) { return true; });
+  ASSERT_EQ(1, zones.size());
+  ASSERT_EQ(context.coloring(cells).exclusive.size(),
+    zones[0].exclusive_size());
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(field_lookup, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -47,6 +47,25 @@ void driver(int argc, char ** argv) {
  
     ASSERT_EQ(global_max, static_cast<double>(num_colors * cycle));
     ASSERT_EQ(global_min, static_cast<double>(cycle));
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+    // Fused non-blocking reductions with different operators and types.
+    mpi_reduction_batch_t batch;
+    auto max_future = batch.add<reduction::max_t>(local_future);
+    auto sum_future = batch.add<reduction::sum_t>(size_t(my_color));
+    auto bounds_future = batch.add<reduction::min_t>(
+      std::array<double, 2>{{double(my_color), -double(my_color)}});
+    batch.start();
+
+    auto min_future = flecsi::execution::context_t::instance().
+      reduce_async<reduction::min_t>(local_future);
+
+    ASSERT_EQ(max_future.get(), static_cast<double>(num_colors * cycle));
+    ASSERT_EQ(sum_future.get(), size_t(num_colors * (num_colors - 1) / 2));
+    ASSERT_EQ(bounds_future.get()[0], 0.0);
+    ASSERT_EQ(bounds_future.get()[1], -double(num_colors - 1));
+    ASSERT_EQ(min_future.get(), static_cast<double>(cycle));
+#endif
   } // cycle
 
 } // driver
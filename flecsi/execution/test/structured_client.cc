@@ -0,0 +1,166 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 17, 2017
+///
+
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/topology/structured_mesh_topology.h"
+
+using namespace flecsi;
+using namespace topology;
+
+class test_mesh_types_t {
+public:
+  static constexpr size_t num_dimensions = 2;
+}; // class test_mesh_types_t
+
+struct test_mesh_t : public structured_mesh_topology_t<test_mesh_types_t> {};
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_legion
+template<typename T, size_t EP, size_t SP, size_t GP>
+using handle_t =
+  data::legion::dense_handle_t<T, EP, SP, GP>;
+#elif FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+template<typename T, size_t EP, size_t SP, size_t GP>
+using handle_t =
+  data::mpi::dense_handle_t<T, EP, SP, GP>;
+#endif
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+// Cells of the global mesh and ghost depth
+const test_mesh_t::coord_t extents = {{8, 6}};
+const size_t depth = 1;
+
+// Cells are in index space 2.
+const size_t cells = 2;
+
+//----------------------------------------------------------------------------//
+// Store the global id of each owned cell.
+//----------------------------------------------------------------------------//
+
+void fill_task(client_handle_t<test_mesh_t, ro> mesh,
+  handle_t<size_t, rw, rw, ro> ids) {
+  auto & coloring = execution::context_t::instance().coloring(cells);
+
+  size_t i(0);
+  for(auto & e: coloring.exclusive) {
+    ids.exclusive(i++) = e.id;
+  } // for
+
+  i = 0;
+  for(auto & s: coloring.shared) {
+    ids.shared(i++) = s.id;
+  } // for
+} // fill_task
+
+//----------------------------------------------------------------------------//
+// Check the ghosts after the exchange and the connectivity of the local
+// box of the client handle.
+//----------------------------------------------------------------------------//
+
+void check_task(client_handle_t<test_mesh_t, ro> mesh,
+  handle_t<size_t, ro, ro, ro> ids) {
+  auto & coloring = execution::context_t::instance().coloring(cells);
+
+  size_t i(0);
+  for(auto & g: coloring.ghost) {
+    ASSERT_EQ(g.id, ids.ghost(i++));
+  } // for
+
+  ASSERT_EQ(coloring.exclusive.size() + coloring.shared.size() +
+    coloring.ghost.size(), mesh.num_entities(cells));
+
+  for(auto c: mesh.entities(cells)) {
+    const coloring::entity_info_t info(mesh.global_id(cells, c));
+
+    ASSERT_TRUE(coloring.exclusive.count(info) ||
+      coloring.shared.count(info) || coloring.ghost.count(info));
+    ASSERT_EQ(4, mesh.entities(cells, c, 0).size());
+  } // for
+} // check_task
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_field(test_mesh_t, test, cell_id, size_t, dense, 1, cells);
+
+flecsi_register_task(fill_task, loc, single);
+flecsi_register_task(check_task, loc, single);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Color the cells by block decomposition. Every rank computes the coloring
+// information of all colors, so no communication is needed.
+//----------------------------------------------------------------------------//
+
+void add_structured_colorings() {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const auto grid = test_mesh_t::block_grid(extents, size);
+
+  coloring::index_coloring_t local;
+  std::unordered_map<size_t, coloring::coloring_info_t> coloring_info;
+
+  for(int color(0); color < size; ++color) {
+    coloring::index_coloring_t c;
+    auto box = test_mesh_t::color_block(cells, extents, grid, color, depth,
+      c, coloring_info[color]);
+
+    if(color == rank) {
+      local = std::move(c);
+      test_mesh_t::set_local_box(box);
+    } // if
+  } // for
+
+  context_t::instance().add_coloring(cells, local, coloring_info);
+} // add_structured_colorings
+
+flecsi_register_mpi_task(add_structured_colorings);
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  flecsi_execute_mpi_task(add_structured_colorings);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto ih = flecsi_get_handle(ch, test, cell_id, size_t, dense, 0);
+
+  flecsi_execute_task(fill_task, single, ch, ih);
+  flecsi_execute_task(check_task, single, ch, ih);
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(structured_client, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -272,8 +272,7 @@ void add_colorings(int dummy) {
 
       // Collect all colors with whom we require communication
       // to send shared information.
-      cell_color_info.shared_users = flecsi::utils::set_union(
-        cell_color_info.shared_users, i);
+      cell_color_info.shared_users.insert(i.begin(), i.end());
     }
     else {
       cells.exclusive.insert(
@@ -397,8 +396,7 @@ void add_colorings(int dummy) {
 
       // Collect all colors with whom we require communication
       // to send shared information.
-      vertex_color_info.shared_users = flecsi::utils::set_union(
-        vertex_color_info.shared_users, i.shared);
+      vertex_color_info.shared_users.insert(i.shared.begin(), i.shared.end());
     }
     else {
       vertices.exclusive.insert(i);
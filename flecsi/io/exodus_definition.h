@@ -166,6 +166,29 @@ void intersect(
 
 }
 
+//==============================================================================
+//! \brief Compact a connectivity array into compressed row storage
+//==============================================================================
+template< typename CONNECTIVITY_TYPE, typename CRS_TYPE >
+void to_crs( const CONNECTIVITY_TYPE & in, CRS_TYPE & out )
+{
+  size_t num_indices = 0;
+  for ( const auto & row : in ) num_indices += row.size();
+
+  out.offsets.clear();
+  out.indices.clear();
+  out.offsets.reserve( in.size() + 1 );
+  out.indices.reserve( num_indices );
+
+  out.offsets.push_back( 0 );
+
+  for ( const auto & row : in ) {
+    out.indices.insert( out.indices.end(), row.begin(), row.end() );
+    out.offsets.push_back( out.indices.size() );
+  }
+
+}
+
 } // namespace detail
 
 
@@ -920,6 +943,182 @@ public:
 
 	}
   
+  //============================================================================
+  //! \brief read the number of entries in a block of an exodus file.
+  //! \param [in] exo_id  The exodus file id.
+  //! \param [in] blk_id  The block id.
+  //! \param [in] entity_type  The type of the block.
+  //! \return the number of entries in the block
+  //============================================================================
+  template< typename U >
+  static size_t read_block_size( 
+    int exoid, ex_entity_id blk_id, ex_entity_type entity_type
+  ) {
+    // some type aliases
+    using ex_index_t = U;
+
+    ex_index_t num_entries_this_blk = 0;
+    ex_index_t num_nodes_per_entry = 0;
+    ex_index_t num_edges_per_entry = 0;
+    ex_index_t num_faces_per_entry = 0;
+    ex_index_t num_attr = 0;
+    char entry_type[MAX_STR_LENGTH];
+    auto status = ex_get_block(
+      exoid, 
+      entity_type, 
+      blk_id, 
+      entry_type, 
+      &num_entries_this_blk, 
+      &num_nodes_per_entry, 
+      &num_edges_per_entry, 
+      &num_faces_per_entry, 
+      &num_attr 
+    );
+    if ( status )
+      clog_fatal( 
+        "Problem reading block, ex_get_block() returned " << status 
+      );
+
+    return num_entries_this_blk;
+  }
+
+  //============================================================================
+  //! \brief read a contiguous range of the elements of a block from an 
+  //!        exodus file.  Only blocks with a fixed number of nodes per
+  //!        element can be read partially.
+  //! \param [in] exo_id  The exodus file id.
+  //! \param [in] elem_blk_id  The block id.
+  //! \param [in] start  The (0-based) index of the first element in the
+  //!                    block to read.
+  //! \param [in] count  The number of elements to read.
+  //! \param [out] elements  The element vertices are appended here.
+  //============================================================================
+  template< typename U >
+  static void read_partial_element_block( 
+    int exoid, 
+    ex_entity_id elem_blk_id, 
+    size_t start, 
+    size_t count, 
+    connectivity_t & elements 
+  ) {
+    // some type aliases
+    using ex_index_t = U;
+        
+    // get the info about this block
+    ex_index_t num_elem_this_blk = 0;
+    ex_index_t num_faces_per_elem = 0;
+    ex_index_t num_edges_per_elem = 0;
+    ex_index_t num_nodes_per_elem = 0;
+    ex_index_t num_attr = 0;
+    char elem_type[MAX_STR_LENGTH];
+    auto status = ex_get_block(
+      exoid, 
+      EX_ELEM_BLOCK, 
+      elem_blk_id, 
+      elem_type, 
+      &num_elem_this_blk, 
+      &num_nodes_per_elem, 
+      &num_edges_per_elem, 
+      &num_faces_per_elem, 
+      &num_attr 
+    );
+    if ( status )
+      clog_fatal( 
+        "Problem reading block, ex_get_block() returned " << status 
+      );
+
+    if ( strcasecmp("nsided",elem_type) == 0 || 
+         strcasecmp("nfaced",elem_type) == 0 )
+      clog_fatal( 
+        "Partial reads of " << elem_type << " blocks are not supported"
+      );
+
+    if ( count == 0 ) return;
+
+    // read the element definitions in the range ( exodus uses 1 indexed
+    // arrays )
+    vector<ex_index_t> elt_conn(count * num_nodes_per_elem);
+    status = ex_get_partial_conn(
+      exoid, EX_ELEM_BLOCK, elem_blk_id, start+1, count, 
+      elt_conn.data(), nullptr, nullptr
+    );
+    if (status)
+      clog_fatal(
+        "Problem getting element connectivity, ex_get_partial_conn() " <<
+        "returned " << status
+      );
+      
+    // create cells in mesh
+    elements.reserve( elements.size() + count );
+
+    for (size_t e = 0; e < count; ++e) {
+      // base offset into elt_conn
+      auto b = e*num_nodes_per_elem;
+      elements.emplace_back( 
+        elt_conn.begin() + b, elt_conn.begin() + b + num_nodes_per_elem
+      );
+      for ( auto & v : elements.back() ) --v;
+    }
+
+  }
+
+  //============================================================================
+  //! \brief read the coordinates of some of the vertices of the mesh.
+  //!
+  //! The file is read in windows of at most \e window vertices, so only
+  //! the requested coordinates and one window are held at a time.
+  //!
+  //! \param [in] exo_id  The exodus file id.
+  //! \param [in] vertex_ids  The sorted (0-based) ids of the vertices.
+  //! \param [in] window  The largest number of vertices read at once.
+  //! \return the vertex coordinates, stored as in read_point_coords
+  //============================================================================
+  static auto read_point_coords( 
+    int exo_id, 
+    const index_vector_t & vertex_ids,
+    size_t window = 65536
+  ) { 
+
+    auto num_nodes = vertex_ids.size();
+    vector<real_t> vertex_coord( num_dims * num_nodes );
+    vector<real_t> buffer( num_dims * window );
+
+    for ( size_t i=0; i<num_nodes; ) {
+
+      // the window starting at this vertex
+      auto first = vertex_ids[i];
+      auto last = std::lower_bound(
+        vertex_ids.begin() + i, vertex_ids.end(), first + window
+      );
+      auto num_window = *std::prev(last) - first + 1;
+
+      // exodus is kind enough to fetch the data in the real type we ask for
+      auto status = ex_get_partial_coord( 
+        exo_id, 
+        first+1,
+        num_window,
+        buffer.data(), 
+        buffer.data()+window, 
+        num_dims > 2 ? buffer.data()+2*window : nullptr
+      );
+
+      if (status)
+        clog_fatal(
+          "Problem getting vertex coordinates from exodus file, " <<
+          " ex_get_partial_coord() returned " << status 
+        );
+
+      // keep the requested vertices
+      for ( auto it = vertex_ids.begin() + i; it != last; ++it, ++i )
+        for ( size_t d=0; d<num_dims; ++d )
+          vertex_coord[ d*num_nodes + i ] = buffer[ d*window + *it - first ];
+
+    }
+
+    return vertex_coord;
+
+  }
+
   //============================================================================
   //! \brief read the element blocks from an exodus file.
   //! \param [in] exo_id  The exodus file id.
@@ -996,6 +1195,9 @@ public:
   //! the connectivity type
   using connectivity_t = typename base_t::connectivity_t;
 
+  //! the compressed connectivity type
+  using crs_t = typename mesh_definition_t::crs_t;
+
   //============================================================================
   // Constructors
   //============================================================================
@@ -1033,6 +1235,13 @@ public:
 
     clog(info) << "Reading mesh from: " << name << std::endl;
 
+    // any cached inverse connectivity is about to be stale
+    mesh_definition_t::clear_connectivity_cache();
+
+    // the connectivity is built as lists of lists, and compacted into
+    // contiguous storage once it is complete
+    std::map< index_t, std::map<index_t, connectivity_t> > connectivity;
+
     //--------------------------------------------------------------------------
     // Open file
 
@@ -1064,7 +1273,7 @@ public:
     auto num_elem_blk = exo_params.num_elem_blk;
     vector<index_t> elem_blk_ids;
 
-		auto & cell_vertices_ref = entities_[2][0];
+		auto & cell_vertices_ref = connectivity[2][0];
     
     // get the element block ids 
     if ( int64 )
@@ -1098,8 +1307,8 @@ public:
     // build the edges
     
     // reference storage for the cell edges and edge vertices
-    auto & cell_edges_ref = entities_[2][1];
-    auto & edge_vertices_ref = entities_[1][0];
+    auto & cell_edges_ref = connectivity[2][1];
+    auto & edge_vertices_ref = connectivity[1][0];
 
     // temprary storage for matching edges
     auto edge_vertices_sorted = std::make_unique<connectivity_t>();
@@ -1132,13 +1341,25 @@ public:
     //--------------------------------------------------------------------------
     // Create the remainder of the connectivities
 
-    entities_[1][2].reserve(num_edges);
-    entities_[0][2].reserve(num_vertices);
-    entities_[0][1].reserve(num_vertices);
+    connectivity[1][2].reserve(num_edges);
+    connectivity[0][2].reserve(num_vertices);
+    connectivity[0][1].reserve(num_vertices);
+
+    detail::transpose( connectivity[2][1], connectivity[1][2] );
+    detail::transpose( connectivity[2][0], connectivity[0][2] );
+    detail::transpose( connectivity[1][0], connectivity[0][1] );
 
-    detail::transpose( entities_[2][1], entities_[1][2] );
-    detail::transpose( entities_[2][0], entities_[0][2] );
-    detail::transpose( entities_[1][0], entities_[0][1] );
+    //--------------------------------------------------------------------------
+    // compact the connectivity
+
+    entities_.clear();
+
+    for ( auto & from : connectivity ) {
+      for ( auto & to : from.second ) {
+        detail::to_crs( to.second, entities_[from.first][to.first] );
+        connectivity_t().swap( to.second );
+      }
+    }
 
     //--------------------------------------------------------------------------
     // close the file
@@ -1325,9 +1546,24 @@ public:
   const 
   override
   {
-    return entities_.at(from_dim).at(to_dim).at(from_id);
+    const auto & crs = entities_.at(from_dim).at(to_dim);
+    return std::vector<size_t>( crs.begin(from_id), crs.end(from_id) );
   } // vertices
 
+  /// Return the whole connectivity between two dimensions, without copying.
+  /// \param [in] from_dim  The dimension of the entities being defined.
+  /// \param [in] to_dim  The dimension of the entities of the definition.
+  const crs_t &
+  entities_crs( 
+    size_t from_dim,
+		size_t to_dim
+  )
+  const 
+  override
+  {
+    return entities_.at(from_dim).at(to_dim);
+  } // entities_crs
+
   /// Return the vertex coordinates for a certain id.
   /// \param [in] vertex_id  The id of the vertex to query.
   template < typename POINT_TYPE >
@@ -1346,8 +1582,8 @@ private:
   // Private data
   //============================================================================
 
-  //! \brief storage for element verts
-  std::map< index_t, std::map<index_t, connectivity_t> > entities_;
+  //! \brief storage for element verts, in compressed row storage
+  std::map< index_t, std::map<index_t, crs_t> > entities_;
 
   
   //! \brief storage for vertex coordinates
@@ -1393,6 +1629,9 @@ public:
   //! the connectivity type
   using connectivity_t = typename base_t::connectivity_t;
 
+  //! the compressed connectivity type
+  using crs_t = typename mesh_definition_t::crs_t;
+
   //============================================================================
   // Constructors
   //============================================================================
@@ -1429,6 +1668,13 @@ public:
 
     clog(info) << "Reading mesh from: " << name << std::endl;
 
+    // any cached inverse connectivity is about to be stale
+    mesh_definition_t::clear_connectivity_cache();
+
+    // the connectivity is built as lists of lists, and compacted into
+    // contiguous storage once it is complete
+    std::map< index_t, std::map<index_t, connectivity_t> > connectivity;
+
     //--------------------------------------------------------------------------
     // Open file
 
@@ -1452,7 +1698,7 @@ public:
     auto num_face_blk = exo_params.num_face_blk;
     vector<index_t> face_blk_ids;
 	
-		auto & face_vertices_ref = entities_[2][0];
+		auto & face_vertices_ref = connectivity[2][0];
 
     // get the face block ids 
     if ( int64 )
@@ -1488,8 +1734,8 @@ public:
     auto num_elem_blk = exo_params.num_elem_blk;
     vector<index_t> elem_blk_ids;
   			
-		auto & cell_faces_ref = entities_[3][2];     
-  	auto & cell_vertices_ref = entities_[3][0];     
+		auto & cell_faces_ref = connectivity[3][2];     
+  	auto & cell_vertices_ref = connectivity[3][0];     
 
     // temprary storage for matching faces
     auto face_vertices_sorted = std::make_unique<connectivity_t>();
@@ -1606,8 +1852,8 @@ public:
     // build the edges
     
     // make storage for the face edges
-    auto & face_edges_ref = entities_[2][1];
-    auto & edge_vertices_ref = entities_[1][0];
+    auto & face_edges_ref = connectivity[2][1];
+    auto & edge_vertices_ref = connectivity[1][0];
 
     // temprary storage for matching edges
     auto edge_vertices_sorted = std::make_unique<connectivity_t>();
@@ -1638,7 +1884,7 @@ public:
     auto num_edges = edge_vertices_ref.size();
 
     // Determine cell edges
-    auto & cell_edges_ref = entities_[3][1];
+    auto & cell_edges_ref = connectivity[3][1];
     detail::intersect( cell_faces_ref, face_edges_ref, cell_edges_ref );
   
     //--------------------------------------------------------------------------
@@ -1647,20 +1893,32 @@ public:
     auto num_vertices = vertices_.size() / dimension();
     auto num_faces = face_vertices_ref.size();
 
-    entities_[0][1].reserve(num_vertices);
-    entities_[0][2].reserve(num_vertices);
-    entities_[0][3].reserve(num_vertices);
-    entities_[1][2].reserve(num_edges);
-    entities_[1][3].reserve(num_edges);
-    entities_[2][3].reserve(num_faces);
-
-    detail::transpose( entities_[1][0], entities_[0][1] );
-    detail::transpose( entities_[2][0], entities_[0][2] );
-    detail::transpose( entities_[3][0], entities_[0][3] );
-    detail::transpose( entities_[2][1], entities_[1][2] );
-    detail::transpose( entities_[3][1], entities_[1][3] );
-    detail::transpose( entities_[3][2], entities_[2][3] );
+    connectivity[0][1].reserve(num_vertices);
+    connectivity[0][2].reserve(num_vertices);
+    connectivity[0][3].reserve(num_vertices);
+    connectivity[1][2].reserve(num_edges);
+    connectivity[1][3].reserve(num_edges);
+    connectivity[2][3].reserve(num_faces);
+
+    detail::transpose( connectivity[1][0], connectivity[0][1] );
+    detail::transpose( connectivity[2][0], connectivity[0][2] );
+    detail::transpose( connectivity[3][0], connectivity[0][3] );
+    detail::transpose( connectivity[2][1], connectivity[1][2] );
+    detail::transpose( connectivity[3][1], connectivity[1][3] );
+    detail::transpose( connectivity[3][2], connectivity[2][3] );
    
+    //--------------------------------------------------------------------------
+    // compact the connectivity
+
+    entities_.clear();
+
+    for ( auto & from : connectivity ) {
+      for ( auto & to : from.second ) {
+        detail::to_crs( to.second, entities_[from.first][to.first] );
+        connectivity_t().swap( to.second );
+      }
+    }
+
     //--------------------------------------------------------------------------
     // close the file
     base_t::close( exoid );
@@ -1865,9 +2123,24 @@ public:
   const 
   override
   {
-    return entities_.at(from_dim).at(to_dim).at(from_id);
+    const auto & crs = entities_.at(from_dim).at(to_dim);
+    return std::vector<size_t>( crs.begin(from_id), crs.end(from_id) );
   } // vertices
 
+  /// Return the whole connectivity between two dimensions, without copying.
+  /// \param [in] from_dim  The dimension of the entities being defined.
+  /// \param [in] to_dim  The dimension of the entities of the definition.
+  const crs_t &
+  entities_crs( 
+    size_t from_dim,
+		size_t to_dim
+  )
+  const 
+  override
+  {
+    return entities_.at(from_dim).at(to_dim);
+  } // entities_crs
+
 
   /// Return the vertex coordinates for a certain id.
   /// \param [in] vertex_id  The id of the vertex to query.
@@ -1887,8 +2160,8 @@ private:
   // Private data
   //============================================================================
 
-  //! \brief storage for element verts
-  std::map< index_t, std::map<index_t, connectivity_t> > entities_;
+  //! \brief storage for element verts, in compressed row storage
+  std::map< index_t, std::map<index_t, crs_t> > entities_;
 
   //! \brief storage for vertex coordinates
   vector<real_t> vertices_;
@@ -1897,6 +2170,327 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief This is a distributed reader for Exodus meshes with fixed-size
+///        element blocks.
+///
+/// Each rank reads only a contiguous range of the elements, and the
+/// coordinates of the vertices that they reference, so that the memory
+/// used by each rank scales with the number of elements divided by the
+/// number of ranks.  The elements are distributed in blocks of the same
+/// sizes as naive_coloring and make_dcrs use.  Only the element-to-vertex
+/// connectivity is available, and vertices keep their global ids.
+////////////////////////////////////////////////////////////////////////////////
+template< int D, typename T >
+class distributed_exodus_definition__
+{
+
+public:
+
+  //============================================================================
+  // Typedefs
+  //============================================================================
+  
+  //! the instantiated base type
+  using base_t = exodus_base__<D, T>;
+
+  //! the floating point type
+  using real_t = typename base_t::real_t;
+  //! the index type
+  using index_t = typename base_t::index_t;
+ 
+  //! the vector type
+  template <typename U>
+  using vector = typename base_t::template vector<U>;
+
+  //! the connectivity type
+  using connectivity_t = typename base_t::connectivity_t;
+
+  //! the compressed connectivity type
+  using crs_t = typename topology::mesh_definition__<D>::crs_t;
+
+  //! the non-allocating view type
+  using id_array_t = typename topology::mesh_definition__<D>::id_array_t;
+
+  //============================================================================
+  // Constructors
+  //============================================================================
+
+  //! \brief Default constructor
+  distributed_exodus_definition__() = default;
+
+  //! \brief Constructor with filename
+  //! \param [in] filename  The name of the file to load
+  //! \param [in] rank  The rank of the caller
+  //! \param [in] size  The number of ranks reading the file
+  distributed_exodus_definition__(
+    const std::string & filename, size_t rank, size_t size )
+  {
+    read( filename, rank, size );
+  }
+
+  /// Copy constructor (disabled)
+  distributed_exodus_definition__(
+    const distributed_exodus_definition__ &) = delete;
+
+  /// Assignment operator (disabled)
+  distributed_exodus_definition__ & operator = (
+    const distributed_exodus_definition__ &) = delete;
+
+  /// Destructor
+  ~distributed_exodus_definition__() = default;
+
+  ///
+  /// Return the dimension of the mesh.
+  ///
+  static 
+  constexpr
+  size_t
+  dimension()
+  {
+    return D;
+  } // dimension
+
+  //============================================================================
+  //! \brief Read this rank's part of a mesh.
+  //!
+  //! \param[in] name  The name of the file to read.
+  //! \param[in] rank  The rank of the caller.
+  //! \param[in] size  The number of ranks reading the file.
+  //============================================================================
+  void read( const std::string &name, size_t rank, size_t size )
+  {
+
+    clog(info) << "Reading part " << rank << " of " << size 
+      << " of mesh from: " << name << std::endl;
+
+    //--------------------------------------------------------------------------
+    // Open file
+
+    // open the exodus file
+    auto exoid = base_t::open( name, std::ios_base::in );
+
+    // get the initialization parameters
+    auto exo_params = base_t::read_params(exoid);
+
+    // check the integer type used in the exodus file
+    auto int64 = base_t::is_int64(exoid);
+
+    num_vertices_ = exo_params.num_nodes;
+    num_cells_ = exo_params.num_elem;
+
+    //--------------------------------------------------------------------------
+    // this rank's range of elements, with higher ranks getting an 
+    // additional element for non-zero remainders
+
+    auto quot = num_cells_ / size;
+    auto rem = num_cells_ % size;
+
+    offset_ = 0;
+    for ( size_t r=0; r<rank; ++r )
+      offset_ += quot + ((r >= (size - rem)) ? 1 : 0);
+
+    auto first = offset_;
+    auto last = first + quot + ((rank >= (size - rem)) ? 1 : 0);
+
+    //--------------------------------------------------------------------------
+    // element blocks
+    
+    auto num_elem_blk = exo_params.num_elem_blk;
+    vector<index_t> elem_blk_ids;
+
+    // get the element block ids 
+    if ( int64 )
+      elem_blk_ids = base_t::template read_block_ids<long long>( 
+          exoid, EX_ELEM_BLOCK, num_elem_blk 
+        );
+    else
+      elem_blk_ids = base_t::template read_block_ids<int>( 
+          exoid, EX_ELEM_BLOCK, num_elem_blk 
+        );
+
+    // read the part of each block that overlaps the range
+    connectivity_t cell_vertices;
+    size_t blk_first = 0;
+
+    for ( int iblk=0; iblk<num_elem_blk && blk_first<last; iblk++ ) {
+
+      auto num_elem_this_blk = int64 ?
+        base_t::template read_block_size<long long>( 
+          exoid, elem_blk_ids[iblk], EX_ELEM_BLOCK
+        ) :
+        base_t::template read_block_size<int>( 
+          exoid, elem_blk_ids[iblk], EX_ELEM_BLOCK
+        );
+
+      auto lo = std::max( first, blk_first );
+      auto hi = std::min( last, blk_first + num_elem_this_blk );
+
+      if ( lo < hi ) {
+        if ( int64 )
+          base_t::template read_partial_element_block<long long>( 
+            exoid, elem_blk_ids[iblk], lo - blk_first, hi - lo, cell_vertices
+          );
+        else
+          base_t::template read_partial_element_block<int>( 
+            exoid, elem_blk_ids[iblk], lo - blk_first, hi - lo, cell_vertices
+          );
+      }
+
+      blk_first += num_elem_this_blk;
+    }
+
+    // check some assertions
+    clog_assert( 
+      cell_vertices.size() == last - first,
+      "Mismatch in read blocks"
+    );
+
+    // compact the connectivity
+    detail::to_crs( cell_vertices, cell_vertices_ );
+    connectivity_t().swap( cell_vertices );
+
+    //--------------------------------------------------------------------------
+    // read the coordinates of the referenced vertices
+
+    vertex_ids_ = cell_vertices_.indices;
+    std::sort( vertex_ids_.begin(), vertex_ids_.end() );
+    vertex_ids_.erase( 
+      std::unique( vertex_ids_.begin(), vertex_ids_.end() ),
+      vertex_ids_.end()
+    );
+
+    vertices_ = base_t::read_point_coords(exoid, vertex_ids_);
+
+    //--------------------------------------------------------------------------
+    // close the file
+    base_t::close( exoid );
+  }
+
+  /// Return the global number of entities of a particular dimension
+  /// \param [in] dim  The entity dimension to query.
+  size_t num_entities( size_t dim ) const
+  {
+    switch (dim)
+    {
+      case 0: 
+        return num_vertices_;
+      case D: 
+        return num_cells_;
+      default:
+        clog_fatal( 
+          "Dimension not available: " << dim 
+        );
+        return 0;
+    }
+  }
+
+  /// Return the number of entities of a particular dimension on this rank
+  /// \param [in] dim  The entity dimension to query.
+  size_t num_local_entities( size_t dim ) const
+  {
+    switch (dim)
+    {
+      case 0: 
+        return vertex_ids_.size();
+      case D: 
+        return cell_vertices_.size();
+      default:
+        clog_fatal( 
+          "Dimension not available: " << dim 
+        );
+        return 0;
+    }
+  }
+
+  /// Return the global id of the first element on this rank.
+  size_t offset() const
+  {
+    return offset_;
+  }
+
+  /// Return the element-to-vertex connectivity of the elements on this
+  /// rank, indexed by local element id and holding global vertex ids.
+  /// \param [in] from_dim  The dimension of the elements.
+  /// \param [in] to_dim  Must be zero.
+  const crs_t &
+  entities_crs( 
+    size_t from_dim,
+		size_t to_dim
+  )
+  const 
+  {
+    clog_assert( from_dim == D && to_dim == 0, 
+      "Only the element-to-vertex connectivity is available" );
+    return cell_vertices_;
+  } // entities_crs
+
+  /// Return the global vertex ids of a local element.
+  /// \param [in] from_dim  The dimension of the elements.
+  /// \param [in] to_dim  Must be zero.
+  /// \param [in] from_id  The local id of the element.
+  id_array_t
+  entities_ref( 
+    size_t from_dim,
+		size_t to_dim,
+    size_t from_id
+  )
+  const 
+  {
+    return entities_crs(from_dim, to_dim)[from_id];
+  } // entities_ref
+
+  /// Return the sorted global ids of the vertices on this rank.
+  const auto & vertex_ids() const
+  {
+    return vertex_ids_;
+  }
+
+  /// Return the vertex coordinates for a certain id.
+  /// \param [in] vertex_id  The global id of the vertex to query, which 
+  ///                        must be referenced by an element on this rank.
+  template < typename POINT_TYPE >
+  auto vertex( size_t vertex_id ) const
+  {
+    auto it = std::lower_bound( 
+      vertex_ids_.begin(), vertex_ids_.end(), vertex_id 
+    );
+    clog_assert( it != vertex_ids_.end() && *it == vertex_id,
+      "Vertex " << vertex_id << " is not on this rank" );
+
+    auto num_vertices = vertex_ids_.size();
+    auto local_id = std::distance( vertex_ids_.begin(), it );
+    POINT_TYPE p;
+    for ( int i=0; i<dimension(); ++i )
+      p[i] = vertices_[ i*num_vertices + local_id ];
+    return p;
+  } // vertex
+
+private:
+
+  //============================================================================
+  // Private data
+  //============================================================================
+
+  //! \brief the global numbers of vertices and elements
+  size_t num_vertices_ = 0;
+  size_t num_cells_ = 0;
+
+  //! \brief the global id of the first local element
+  size_t offset_ = 0;
+
+  //! \brief storage for the local element verts
+  crs_t cell_vertices_;
+
+  //! \brief the global ids of the local vertices
+  vector<index_t> vertex_ids_;
+
+  //! \brief storage for the local vertex coordinates
+  vector<real_t> vertices_;
+
+};
+
+
 } // namespace io
 } // namespace flecsi
 
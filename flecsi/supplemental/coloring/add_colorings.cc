@@ -148,22 +148,15 @@ void add_colorings(coloring_map_t map) {
   // dependencies. This also gives information about the ranks
   // that access our shared cells.
   auto cell_nn_info =
-    communicator->get_primary_info(cells.primary, nearest_neighbors);
+    communicator->get_primary_info(cells.primary, nearest_neighbors,
+      dcrs.distribution);
 
   // Get the rank and offset information for all relevant neighbor
   // dependencies. This information will be necessary for determining
   // shared vertices.
   auto cell_all_info =
-    communicator->get_primary_info(cells.primary, all_neighbors);
-
-  // Create a map version of the local info for lookups below.
-  std::unordered_map<size_t, size_t> primary_indices_map;
-  {
-  size_t offset(0);
-  for(auto i: cells.primary) {
-    primary_indices_map[offset++] = i;
-  } // for
-  } // scope
+    communicator->get_primary_info(cells.primary, all_neighbors,
+      dcrs.distribution);
 
   // Create a map version of the remote info for lookups below.
   std::unordered_map<size_t, flecsi::coloring::entity_info_t> remote_info_map;
@@ -171,44 +164,10 @@ void add_colorings(coloring_map_t map) {
     remote_info_map[i.id] = i;
   } // for
 
-  // Populate exclusive and shared cell information.
-  {
-  size_t offset(0);
-  for(auto i: std::get<0>(cell_nn_info)) {
-    if(i.size()) {
-      cells.shared.insert(
-        flecsi::coloring::entity_info_t(primary_indices_map[offset],
-        rank, offset, i));
-      
-      // Collect all colors with whom we require communication
-      // to send shared information.
-      cell_color_info.shared_users = flecsi::utils::set_union(
-        cell_color_info.shared_users, i);
-    }
-    else {
-      cells.exclusive.insert(
-        flecsi::coloring::entity_info_t(primary_indices_map[offset],
-        rank, offset, i));
-    } // if
-    ++offset;
-  } // for
-  } // scope
-  
-  // Populate ghost cell information.
-  {
-  size_t offset(0);
-  for(auto i: std::get<1>(cell_nn_info)) {
-    cells.ghost.insert(i);
-
-    // Collect all colors with whom we require communication
-    // to receive ghost information.
-    cell_color_info.ghost_owners.insert(i.rank);
-  } // for
-  } // scope
-
-  cell_color_info.exclusive = cells.exclusive.size();
-  cell_color_info.shared = cells.shared.size();
-  cell_color_info.ghost = cells.ghost.size();
+  // Populate exclusive, shared and ghost cell information, and the
+  // colors with whom we require communication.
+  flecsi::coloring::build_index_coloring(rank, cell_nn_info, cells,
+    cell_color_info);
 
   {
   clog_tag_guard(coloring_output);
@@ -308,8 +267,7 @@ void add_colorings(coloring_map_t map) {
 
       // Collect all colors with whom we require communication
       // to send shared information.
-      vertex_color_info.shared_users = flecsi::utils::set_union(
-        vertex_color_info.shared_users, i.shared);
+      vertex_color_info.shared_users.insert(i.shared.begin(), i.shared.end());
     }
     else {
       vertices.exclusive.insert(i);
@@ -317,12 +275,16 @@ void add_colorings(coloring_map_t map) {
   } // for
 
   {
+  // Ghosts arrive grouped by owner rather than sorted by id, so
+  // collect them first and sort once.
+  std::vector<flecsi::coloring::entity_info_t> ghost;
+
   size_t r(0);
   for(auto i: vertex_requests) {
 
     auto offset(vertex_offset_info[r].begin());
     for(auto s: i) {
-      vertices.ghost.insert(flecsi::coloring::entity_info_t(s, r, *offset));
+      ghost.push_back(flecsi::coloring::entity_info_t(s, r, *offset));
       ++offset;
 
       // Collect all colors with whom we require communication
@@ -332,6 +294,8 @@ void add_colorings(coloring_map_t map) {
 
     ++r;
   } // for
+
+  vertices.ghost.insert(ghost.begin(), ghost.end());
   } // scope
 
   {
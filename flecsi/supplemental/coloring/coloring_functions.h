@@ -137,8 +137,7 @@ void color_entity(
       entities.shared.insert(i);
       // Collect all colors with whom we require communication
       // to send shared information.
-      entity_color_info.shared_users = 
-        flecsi::utils::set_union(entity_color_info.shared_users, i.shared);
+      entity_color_info.shared_users.insert(i.shared.begin(), i.shared.end());
     }
     // otherwise, its exclusive
     else 
@@ -146,12 +145,16 @@ void color_entity(
   } // for
 
   {
+    // Ghosts arrive grouped by owner rather than sorted by id, so
+    // collect them first and sort once.
+    std::vector<entity_info_t> ghost;
+
     size_t r(0);
     for(auto i: entity_requests) {
 
       auto offset(entity_offset_info[r].begin());
       for(auto s: i) {
-        entities.ghost.insert(entity_info_t(s, r, *offset));
+        ghost.push_back(entity_info_t(s, r, *offset));
         // Collect all colors with whom we require communication
         // to receive ghost information.
         entity_color_info.ghost_owners.insert(r);
@@ -161,6 +164,8 @@ void color_entity(
 
       ++r;
     } // for
+
+    entities.ghost.insert(ghost.begin(), ghost.end());
   } // scope
 
   {
@@ -6,6 +6,9 @@
 #ifndef flecsi_topology_closure_utils_h
 #define flecsi_topology_closure_utils_h
 
+#include <algorithm>
+#include <vector>
+
 #include "flecsi/topology/mesh_definition.h"
 #include "flecsi/utils/logging.h"
 #include "flecsi/utils/set_utils.h"
@@ -20,7 +23,10 @@ namespace flecsi {
 namespace topology {
 
 ///
-/// Find the neighbors of the given entity id.
+/// Find the neighbors of the given entity id and append them, in
+/// increasing order, to the given vector. This version does not allocate
+/// once the vectors have grown to the local degree of the mesh, so it
+/// can be called repeatedly with the same vectors.
 ///
 /// \tparam from_dim The topological dimension of the entity for which
 ///                  the neighbor information is being requested.
@@ -32,6 +38,8 @@ namespace topology {
 ///           information.
 /// \param entity_id The id of the entity in from_dim for which the neighbors
 ///           are to be found.
+/// \param neighbors The vector to which the neighbors are appended.
+/// \param candidates Scratch storage.
 ///
 template<
   size_t from_dim,
@@ -39,40 +47,94 @@ template<
   size_t thru_dim,
   size_t D
 >
-std::set<size_t>
+void
 entity_neighbors(
   const mesh_definition__<D> & md,
-  size_t entity_id
+  size_t entity_id,
+  std::vector<size_t> & neighbors,
+  std::vector<size_t> & candidates
 )
 {
   // Get the vertices of the requested id
-  auto vertices = md.entities_set(from_dim, 0, entity_id);
+  auto vertices = md.entities_ref(from_dim, 0, entity_id);
 
-  // Put the results into set form
-  std::set<size_t> neighbors;
+  // The entities of the to_dim that reference each vertex
+  const auto & referencers = md.inverse_index(to_dim, 0);
+
+  // Gather every entity of the to_dim that shares a vertex with the
+  // requested entity, once per shared vertex
+  candidates.clear();
 
-  // Go through the entities of the to_dim
-  for(size_t e(0); e<md.num_entities(to_dim); ++e) {
+  for(auto v = vertices.begin(); v != vertices.end(); ++v) {
 
-    // Skip the input id if the dimensions are the same
-    if(from_dim == to_dim && e == entity_id) {
+    // Count a vertex that is listed twice only once
+    if(std::find(vertices.begin(), v, *v) != v) {
       continue;
     } // if
 
-    // Get the vertices that define the current entity from the to_dim
-    auto other = md.entities_set(to_dim, 0, e);
+    for(auto e = referencers.begin(*v); e != referencers.end(*v); ++e) {
 
-    // Get the intersection set
-    auto intersect = flecsi::utils::set_intersection(vertices, other);
+      // Skip the input id if the dimensions are the same
+      if(from_dim == to_dim && *e == entity_id) {
+        continue;
+      } // if
 
-    // Add this entity id if the intersection shares at least
-    // intersections vertices
-    if(intersect.size() > thru_dim) {
-      neighbors.insert(e);
+      candidates.push_back(*e);
+    } // for
+  } // for
+
+  std::sort(candidates.begin(), candidates.end());
+
+  // Add each entity id that shares more than thru_dim vertices
+  for(size_t i(0); i<candidates.size();) {
+    size_t j(i+1);
+
+    while(j<candidates.size() && candidates[j] == candidates[i]) {
+      ++j;
+    } // while
+
+    if(j-i > thru_dim) {
+      neighbors.push_back(candidates[i]);
     } // if
+
+    i = j;
   } // for
+} // entity_neighbors
+
+///
+/// Find the neighbors of the given entity id.
+///
+/// \tparam from_dim The topological dimension of the entity for which
+///                  the neighbor information is being requested.
+/// \tparam to_dim The topological dimension to search for neighbors.
+/// \tparam thru_dim The topological dimension through which the neighbor
+///                  connection exists.
+///
+/// \param md The mesh definition containing the topological connectivity
+///           information.
+/// \param entity_id The id of the entity in from_dim for which the neighbors
+///           are to be found.
+///
+template<
+  size_t from_dim,
+  size_t to_dim,
+  size_t thru_dim,
+  size_t D
+>
+std::set<size_t>
+entity_neighbors(
+  const mesh_definition__<D> & md,
+  size_t entity_id
+)
+{
+  std::vector<size_t> neighbors;
+  std::vector<size_t> candidates;
+
+  entity_neighbors<from_dim, to_dim, thru_dim>(md, entity_id,
+    neighbors, candidates);
 
-  return neighbors;
+  // Put the results into set form
+  return std::set<size_t>(neighbors.begin(), neighbors.end());
 } // entity_neighbors
 
 ///
@@ -108,12 +170,15 @@ entity_neighbors(
   std::set<size_t> closure( std::forward<U>(indices).begin(), 
     std::forward<U>(indices).end() );
 
+  std::vector<size_t> ncurr;
+  std::vector<size_t> candidates;
+
   // Iterate over the entity indices and add all neighbors
   for(auto i: indices) {
-    auto ncurr =
-      entity_neighbors<from_dim, to_dim, thru_dim>(md, i);
+    ncurr.clear();
+    entity_neighbors<from_dim, to_dim, thru_dim>(md, i, ncurr, candidates);
 
-    closure = flecsi::utils::set_union(ncurr, closure);
+    closure.insert(ncurr.begin(), ncurr.end());
   } // for
 
   return closure;
@@ -140,22 +205,10 @@ entity_referencers(
   size_t id
 )
 {
-  std::set<size_t> referencers;
-
-  // Iterate over entities adding any entity that contains
-  // the vertex id to the set.
-  for(size_t e(0); e<md.num_entities(from_dim); ++e) {
-
-    // Get the vertex ids of current cell
-    const auto & eset = md.entities(from_dim, to_dim, e);
-
-    // If the cell references this vertex add it
-    if(std::find(eset.begin(), eset.end(), id) != eset.end())
-      referencers.insert(e);
-
-  } // for
+  // The entities of the from_dim that reference each entity of the to_dim
+  const auto & index = md.inverse_index(from_dim, to_dim);
 
-  return referencers;
+  return std::set<size_t>(index.begin(id), index.end(id));
 } // vertex_referencers
 
 ///
@@ -186,7 +239,7 @@ entity_closure(
   // Iterate over the entities in indices and add any vertices that are
   // referenced by one of the entity indices
   for(auto i: std::forward<U>(indices)) {
-    const auto & vset = md.entities(from_dim, to_dim, i);
+    auto vset = md.entities_ref(from_dim, to_dim, i);
     closure.insert(vset.begin(), vset.end());
   } // for
 
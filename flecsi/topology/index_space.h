@@ -273,12 +273,12 @@ public:
       return *this;
     }
 
-    S&
+    S
     operator*()
     {
       while(B::index_ < B::end_)
       {
-        T& item = B::get_(B::index_);
+        S item = B::get_(B::index_);
         if(P()(item))
         {
           return item;
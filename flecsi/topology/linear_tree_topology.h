@@ -0,0 +1,1291 @@
+/*~--------------------------------------------------------------------------~*
+ *  @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+ * /@@/////  /@@          @@////@@ @@////// /@@
+ * /@@       /@@  @@@@@  @@    // /@@       /@@
+ * /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+ * /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+ * /@@       /@@/@@//// //@@    @@       /@@/@@
+ * /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+ * //       ///  //////   //////  ////////  //
+ *
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_topology_linear_tree_topology_h
+#define flecsi_topology_linear_tree_topology_h
+
+/*!
+  \file linear_tree_topology.h
+  \date Initial file creation: Oct 17, 2017
+ */
+
+/*
+  Linear tree storage for tree topology. A policy selects it with
+
+    using storage = topology::linear_tree_storage;
+
+  and additionally defines max_leaf_entities, the number of entities above
+  which a branch is refined, and a branch_t type derived from
+  linear_tree_branch.
+
+  The branches are stored breadth first in one contiguous array. The
+  children of a branch are adjacent, so that child i of branch b is found
+  at index b.first_child + i, and no branch map or child pointers are
+  needed. The entities are sorted by Morton key and their pointers and
+  coordinates are stored in separate contiguous arrays, so that the
+  entities below any branch form one contiguous range.
+
+  Insertions, removals and updates mark the tree as stale, and the tree is
+  rebuilt in bulk, in O(n log n), by the next query. Branch pointers are
+  invalidated by a rebuild.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "flecsi/topology/tree_topology.h"
+
+namespace flecsi {
+namespace topology {
+
+/*!
+  Linear tree branch base class.
+ */
+template<
+  typename T,
+  size_t D
+>
+class linear_tree_branch
+{
+public:
+  using branch_int_t = T;
+
+  static const size_t dimension = D;
+
+  using branch_id_t = branch_id<T, D>;
+
+  using id_t = branch_id_t;
+
+  static constexpr size_t num_children = branch_int_t(1) << dimension;
+
+  linear_tree_branch()
+  : first_child_(0),
+  first_entity_(0),
+  num_entities_(0)
+  {}
+
+  branch_id_t
+  id() const
+  {
+    return id_;
+  }
+
+  bool
+  is_leaf() const
+  {
+    // The root is the first branch, so no branch has its children there.
+    return first_child_ == 0;
+  }
+
+  /*!
+    Return the number of entities below this branch.
+   */
+  size_t
+  size() const
+  {
+    return num_entities_;
+  }
+
+  /*!
+    Return the coordinates of the lower corner of this branch.
+   */
+  template<
+    typename S
+  >
+  point__<S, dimension>
+  coordinates(
+    const std::array<point__<S, dimension>, 2>& range
+  ) const
+  {
+    point__<S, dimension> p;
+    id_.coordinates(range, p);
+    return p;
+  }
+
+  bool
+  is_valid() const
+  {
+    return true;
+  }
+
+private:
+  template<class P, typename S>
+  friend class tree_topology;
+
+  branch_id_t id_;
+  size_t first_child_;
+  size_t first_entity_;
+  size_t num_entities_;
+};
+
+/*!
+  Tree topology with linear storage.
+ */
+template<
+  class P
+>
+class tree_topology<P, linear_tree_storage> :
+  public P, public data::data_client_t
+{
+public:
+  using Policy = P;
+
+  static const size_t dimension = Policy::dimension;
+
+  using element_t = typename Policy::element_t;
+
+  using point_t = point__<element_t, dimension>;
+
+  using range_t = std::pair<element_t, element_t>;
+
+  using branch_int_t = typename Policy::branch_int_t;
+
+  using branch_id_t = branch_id<branch_int_t, dimension>;
+
+  using branch_id_vector_t = std::vector<branch_id_t>;
+
+
+  using branch_t = typename Policy::branch_t;
+
+  using branch_vector_t = std::vector<branch_t*>;
+
+
+  using entity_t = typename Policy::entity_t;
+
+  using entity_vector_t = std::vector<entity_t*>;
+
+  using entity_id_vector_t = std::vector<entity_id_t>;
+
+  using geometry_t = tree_geometry<element_t, dimension>;
+
+  using entity_space_t = index_space<entity_t*, true, true, false>;
+
+  using subentity_space_t = index_space<entity_t*, false, true, false>;
+
+  using neighbor_list_t = tree_neighbor_list__<entity_t>;
+
+  static_assert(std::is_base_of<
+    linear_tree_branch<branch_int_t, dimension>, branch_t>::value,
+    "linear tree storage requires a branch type derived from "
+    "linear_tree_branch");
+
+  struct filter_valid{
+    bool operator()(entity_t* ent) const{
+      return ent->is_valid();
+    }
+  };
+
+  /*!
+    The contiguous range of entities below a branch.
+   */
+  struct entity_range_t{
+    entity_t* const* first;
+    entity_t* const* last;
+
+    entity_t* const* begin() const { return first; }
+    entity_t* const* end() const { return last; }
+    size_t size() const { return last - first; }
+  };
+
+  /*!
+    Constuct a tree topology with unit coordinates, i.e. each coordinate
+    dimension is in range [0, 1].
+   */
+  tree_topology()
+  {
+    for(size_t d = 0; d < dimension; ++d)
+    {
+      range_[0][d] = element_t(0);
+      range_[1][d] = element_t(1);
+      scale_[d] = element_t(1);
+    }
+
+    max_scale_ = element_t(1);
+    build_();
+  }
+
+  /*!
+    Construct a tree topology with specified ranges [end, start] for each
+    dimension.
+   */
+  tree_topology(
+    const point__<element_t, dimension>& start,
+    const point__<element_t, dimension>& end
+  )
+  {
+    max_scale_ = element_t(0);
+
+    for(size_t d = 0; d < dimension; ++d)
+    {
+      scale_[d] = end[d] - start[d];
+      max_scale_ = std::max(max_scale_, scale_[d]);
+      range_[0][d] = start[d];
+      range_[1][d] = end[d];
+    }
+
+    build_();
+  }
+
+  ~tree_topology()
+  {
+    for(auto ent : entities_)
+    {
+      delete ent;
+    }
+  }
+
+  /*!
+     Get the ci-th child of the given branch.
+   */
+  branch_t*
+  child(
+    branch_t* b,
+    size_t ci
+  )
+  {
+    assert(!b->is_leaf() && ci < branch_t::num_children);
+    return &branches_[b->first_child_ + ci];
+  }
+
+  /*!
+    Return an index space containing all entities (including those removed).
+   */
+  auto
+  all_entities() const
+  {
+    return entities_.template slice<>();
+  }
+
+  /*!
+    Return an index space containing all non-removed entities.
+   */
+  auto
+  entities()
+  {
+    return entities_.template cast<
+      entity_t*, false, false, false, filter_valid>();
+  }
+
+  /*!
+    Return the entities below branch b, in Morton order.
+   */
+  entity_range_t
+  entities(
+    const branch_t* b
+  ) const
+  {
+    entity_t* const* first = ents_.data() + b->first_entity_;
+    return {first, first + b->num_entities_};
+  }
+
+  /*!
+    Insert an entity. The tree is rebuilt by the next query.
+   */
+  void
+  insert(
+    entity_t* ent
+  )
+  {
+    assert(!ent->is_valid());
+    ent->set_branch_id_(branch_id_t::root());
+    stale_ = true;
+  }
+
+  /*!
+    Update is called when an entity's coordinates have changed. The tree
+    stores a copy of the coordinates, so it is rebuilt by the next query.
+   */
+  void
+  update(
+    entity_t* ent
+  )
+  {
+    assert(ent->is_valid());
+    stale_ = true;
+  }
+
+  /*!
+    Rebuild the tree. Called when all entity coordinates are assumed to have
+    changed.
+   */
+  void
+  update_all()
+  {
+    stale_ = true;
+    build_();
+  }
+
+  /*!
+    Rebuild the tree. Called when all entity coordinates are assumed to have
+    changed. Additionally expands or contracts the coordinate ranges of each
+    dimension to [start, end].
+   */
+  void
+  update_all(
+    const point__<element_t, dimension>& start,
+    const point__<element_t, dimension>& end
+  )
+  {
+    for(size_t d = 0; d < dimension; ++d)
+    {
+      scale_[d] = end[d] - start[d];
+      max_scale_ = std::max(max_scale_, scale_[d]);
+      range_[0][d] = start[d];
+      range_[1][d] = end[d];
+    }
+
+    update_all();
+  }
+
+  /*!
+    Remove an entity from the tree. Note this method does not actually
+    delete it. The tree is rebuilt by the next query.
+   */
+  void
+  remove(
+    entity_t* ent
+  )
+  {
+    assert(ent->is_valid());
+    ent->set_branch_id_(branch_id_t::null());
+    stale_ = true;
+  }
+
+  /*!
+    Convert a point to unit coordinates.
+   */
+  point_t
+  unit_coordinates(
+    const point_t& p
+  )
+  {
+    point_t pn;
+
+    for(size_t d = 0; d < dimension; ++d)
+    {
+      pn[d] = (p[d] - range_[0][d]) / scale_[d];
+    }
+
+    return pn;
+  }
+
+  /*!
+    Return an index space containing all entities within the specified
+    spheroid.
+   */
+  subentity_space_t
+  find_in_radius(
+    const point_t& center,
+    element_t radius
+  )
+  {
+    build_();
+
+    subentity_space_t ents;
+    ents.set_master(entities_);
+
+    traverse_(0, element_t(1),
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within(coordinates_[i], center, radius))
+          {
+            ents.push_back(ents_[i]);
+          }
+        }
+      },
+      geometry_t::intersects, center, radius);
+
+    return ents;
+  }
+
+  /*!
+    Return an index space containing all entities within the specified
+    spheroid. (Concurrent version.)
+   */
+  subentity_space_t
+  find_in_radius(
+    thread_pool& pool,
+    const point_t& center,
+    element_t radius
+  )
+  {
+    return find_(pool,
+      [&](size_t i){
+        return geometry_t::within(coordinates_[i], center, radius);
+      },
+      geometry_t::intersects, center, radius);
+  }
+
+  /*!
+    Return an index space containing all entities within the specified
+    box.
+   */
+  subentity_space_t
+  find_in_box(
+    const point_t& min,
+    const point_t& max
+  )
+  {
+    build_();
+
+    subentity_space_t ents;
+    ents.set_master(entities_);
+
+    traverse_(0, element_t(1),
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within_box(coordinates_[i], min, max))
+          {
+            ents.push_back(ents_[i]);
+          }
+        }
+      },
+      geometry_t::intersects_box, min, max);
+
+    return ents;
+  }
+
+  /*!
+    Return an index space containing all entities within the specified
+    box. (Concurrent version.)
+   */
+  subentity_space_t
+  find_in_box(
+    thread_pool& pool,
+    const point_t& min,
+    const point_t& max
+  )
+  {
+    return find_(pool,
+      [&](size_t i){
+        return geometry_t::within_box(coordinates_[i], min, max);
+      },
+      geometry_t::intersects_box, min, max);
+  }
+
+  /*!
+    Find the entities within radii[i] of centers[i] for a batch of query
+    points. Returns the neighbors of each query, in query order, as a CSR
+    list.
+   */
+  neighbor_list_t
+  find_in_radius(
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    build_();
+
+    neighbor_list_t nl;
+    auto groups = group_queries_(centers, radii);
+
+    for(auto& g : groups)
+    {
+      find_group_(g, centers, radii);
+    }
+
+    query_batch_t::gather(groups, centers.size(), nl);
+
+    return nl;
+  }
+
+  /*!
+    Find the entities within radii[i] of centers[i] for a batch of query
+    points. (Concurrent version.)
+   */
+  neighbor_list_t
+  find_in_radius(
+    thread_pool& pool,
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    build_();
+
+    neighbor_list_t nl;
+    auto groups = group_queries_(centers, radii);
+
+    task_group group(pool);
+
+    for(auto& g : groups)
+    {
+      group.run([&]()
+      {
+        find_group_(g, centers, radii);
+      });
+    }
+
+    group.wait();
+
+    query_batch_t::gather(groups, centers.size(), nl);
+
+    return nl;
+  }
+
+  /*!
+    For all entities within the specified spheroid, apply the given callable
+    object ef with args.
+   */
+  template<
+    typename EF,
+    typename... ARGS
+  >
+  void
+  apply_in_radius(
+    const point_t& center,
+    element_t radius,
+    EF&& ef,
+    ARGS&&... args)
+  {
+    build_();
+
+    traverse_(0, element_t(1),
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within(coordinates_[i], center, radius))
+          {
+            ef(ents_[i], std::forward<ARGS>(args)...);
+          }
+        }
+      },
+      geometry_t::intersects, center, radius);
+  }
+
+  /*!
+    For all entities within the specified spheroid, apply the given callable
+    object ef with args. (Concurrent version.)
+   */
+  template<
+    typename EF,
+    typename... ARGS
+  >
+  void
+  apply_in_radius(
+    thread_pool& pool,
+    const point_t& center,
+    element_t radius,
+    EF&& ef,
+    ARGS&&... args)
+  {
+    apply_(pool,
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within(coordinates_[i], center, radius))
+          {
+            ef(ents_[i], std::forward<ARGS>(args)...);
+          }
+        }
+      },
+      geometry_t::intersects, center, radius);
+  }
+
+  /*!
+    For all entities within the specified box, apply the given callable
+    object ef with args.
+   */
+  template<
+    typename EF,
+    typename... ARGS
+  >
+  void
+  apply_in_box(
+    const point_t& min,
+    const point_t& max,
+    EF&& ef,
+    ARGS&&... args
+  )
+  {
+    build_();
+
+    traverse_(0, element_t(1),
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within_box(coordinates_[i], min, max))
+          {
+            ef(ents_[i], std::forward<ARGS>(args)...);
+          }
+        }
+      },
+      geometry_t::intersects_box, min, max);
+  }
+
+  /*!
+    For all entities within the specified box, apply the given callable
+    object ef with args. (Concurrent version.)
+   */
+  template<
+    typename EF,
+    typename... ARGS
+  >
+  void
+  apply_in_box(
+    thread_pool& pool,
+    const point_t& min,
+    const point_t& max,
+    EF&& ef,
+    ARGS&&... args
+  )
+  {
+    apply_(pool,
+      [&](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i)
+        {
+          if(geometry_t::within_box(coordinates_[i], min, max))
+          {
+            ef(ents_[i], std::forward<ARGS>(args)...);
+          }
+        }
+      },
+      geometry_t::intersects_box, min, max);
+  }
+
+  /*!
+    Construct a new entity. The entity is not inserted into the tree
+    directly.
+   */
+  template<
+    class... Args
+  >
+  entity_t*
+  make_entity(
+    Args&&... args
+  )
+  {
+    auto ent = new entity_t(std::forward<Args>(args)...);
+    entity_id_t id = entities_.size();
+    ent->set_id_(id);
+    entities_.push_back(ent);
+    return ent;
+  }
+
+  /*!
+    Return the tree's current max depth.
+   */
+  size_t
+  max_depth()
+  {
+    build_();
+    return max_depth_;
+  }
+
+  /*!
+    Get an entity by entity id.
+   */
+  entity_t*
+  get(
+    entity_id_t id
+  )
+  {
+    assert(id < entities_.size());
+    return entities_[id];
+  }
+
+  /*!
+    Get a branch by branch id.
+   */
+  branch_t*
+  get(
+    branch_id_t id
+  )
+  {
+    build_();
+
+    const size_t depth = id.depth();
+    size_t bi = 0;
+
+    for(size_t d = 0; d < depth; ++d)
+    {
+      assert(!branches_[bi].is_leaf() && "invalid branch id");
+
+      size_t shift = (depth - d - 1) * dimension;
+      bi = branches_[bi].first_child_ +
+        ((id.value_() >> shift) & (branch_t::num_children - 1));
+    }
+
+    return &branches_[bi];
+  }
+
+  /*!
+    Get the root branch (depth 0).
+   */
+  branch_t*
+  root()
+  {
+    build_();
+    return &branches_[0];
+  }
+
+  /*!
+    Visit and apply callable object f and args on all sub-branches of branch b.
+   */
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit(
+    branch_t* b,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    visit_(b - branches_.data(), 0,
+           std::forward<F>(f), std::forward<ARGS>(args)...);
+  }
+
+  /*!
+    Visit and apply callable object f and args on all sub-branches of branch b.
+    (Concurrent version.)
+   */
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit(
+    thread_pool& pool,
+    branch_t* b,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    task_group group(pool);
+
+    visit_(group, b - branches_.data(), 0, get_queue_depth(pool),
+           std::forward<F>(f), std::forward<ARGS>(args)...);
+
+    group.wait();
+  }
+
+  /*!
+    Visit and apply callable object f and args on all sub-entities of branch b.
+   */
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit_children(
+    branch_t* b,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    for(auto ent : entities(b))
+    {
+      f(ent, std::forward<ARGS>(args)...);
+    }
+  }
+
+  /*!
+    Visit and apply callable object f and args on all sub-entities of branch b.
+    (Concurrent version.)
+   */
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit_children(
+    thread_pool& pool,
+    branch_t* b,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    // The entities below b are contiguous, so they are split into one
+    // block per task.
+    const size_t n = b->num_entities_;
+    const size_t num_blocks =
+      std::min(n, std::max(pool.num_threads(), size_t(1)) * 4);
+
+    task_group group(pool);
+
+    for(size_t k = 0; k < num_blocks; ++k)
+    {
+      size_t first = b->first_entity_ + n * k / num_blocks;
+      size_t last = b->first_entity_ + n * (k + 1) / num_blocks;
+
+      group.run([&, first, last]()
+      {
+        for(size_t i = first; i < last; ++i)
+        {
+          f(ents_[i], std::forward<ARGS>(args)...);
+        }
+      });
+    }
+
+    group.wait();
+  }
+
+private:
+
+  using query_batch_t = tree_query_batch__<entity_t, element_t, dimension>;
+
+  using query_group_t = typename query_batch_t::group_t;
+
+  branch_id_t
+  to_branch_id(
+    const point_t& p,
+    size_t max_depth
+  )
+  {
+    return branch_id_t(range_, p, max_depth);
+  }
+
+  size_t
+  get_queue_depth(
+    thread_pool& pool
+  )
+  {
+    size_t n = std::max(pool.num_threads(), size_t(1));
+    constexpr size_t rb = branch_int_t(1) << P::dimension;
+    double bn = std::log2(double(rb));
+    return std::log2(double(n))/bn + 1;
+  }
+
+  /*!
+    Rebuild the branches and the entity arrays if the tree is stale.
+   */
+  void
+  build_()
+  {
+    if(!stale_)
+    {
+      return;
+    }
+
+    constexpr size_t max_key_depth = branch_id_t::max_depth;
+    constexpr branch_int_t digit_mask = branch_t::num_children - 1;
+
+    // Sort the inserted entities by their Morton key at full depth.
+    std::vector<std::pair<branch_int_t, entity_t*>> sorted;
+    sorted.reserve(entities_.size());
+
+    for(auto ent : entities_)
+    {
+      if(ent->is_valid())
+      {
+        sorted.emplace_back(
+          to_branch_id(ent->coordinates(), max_key_depth).value_(), ent);
+      }
+    }
+
+    std::sort(sorted.begin(), sorted.end(),
+      [](const std::pair<branch_int_t, entity_t*>& a,
+         const std::pair<branch_int_t, entity_t*>& b){
+        return a.first < b.first ||
+          (a.first == b.first && a.second->id() < b.second->id());
+      });
+
+    const size_t n = sorted.size();
+
+    keys_.resize(n);
+    ents_.resize(n);
+    coordinates_.resize(n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      keys_[i] = sorted[i].first;
+      ents_[i] = sorted[i].second;
+      coordinates_[i] = ents_[i]->coordinates();
+    }
+
+    // Refine breadth first. The entities of a branch are split among its
+    // children by the next digit of their keys.
+    branches_.clear();
+    branches_.emplace_back();
+    branches_[0].id_ = branch_id_t::root();
+    branches_[0].num_entities_ = n;
+    max_depth_ = 0;
+
+    for(size_t bi = 0; bi < branches_.size(); ++bi)
+    {
+      const branch_id_t bid = branches_[bi].id_;
+      const size_t depth = bid.depth();
+      size_t first = branches_[bi].first_entity_;
+      const size_t last = first + branches_[bi].num_entities_;
+
+      if(last - first <= Policy::max_leaf_entities ||
+         depth == max_key_depth)
+      {
+        for(size_t i = first; i < last; ++i)
+        {
+          ents_[i]->set_branch_id_(bid);
+        }
+
+        continue;
+      }
+
+      const size_t shift = (max_key_depth - depth - 1) * dimension;
+      branches_[bi].first_child_ = branches_.size();
+      max_depth_ = std::max(max_depth_, depth + 1);
+
+      for(branch_int_t ci = 0; ci < branch_t::num_children; ++ci)
+      {
+        size_t child_last = std::partition_point(
+          keys_.begin() + first, keys_.begin() + last,
+          [&](branch_int_t key){
+            return ((key >> shift) & digit_mask) <= ci;
+          }) - keys_.begin();
+
+        branch_t c;
+        c.id_ = bid;
+        c.id_.push(ci);
+        c.first_entity_ = first;
+        c.num_entities_ = child_last - first;
+        branches_.push_back(c);
+
+        first = child_last;
+      }
+    }
+
+    stale_ = false;
+  }
+
+  /*!
+    Descend from branch bi into the non-empty branches that satisfy bf and
+    call lf(first, last) on the entity range of each leaf reached.
+   */
+  template<
+    typename LF,
+    typename BF,
+    typename... ARGS
+  >
+  void
+  traverse_(
+    size_t bi,
+    element_t size,
+    LF&& lf,
+    BF&& bf,
+    ARGS&&... args
+  )
+  {
+    const branch_t& b = branches_[bi];
+
+    if(b.is_leaf())
+    {
+      lf(b.first_entity_, b.first_entity_ + b.num_entities_);
+      return;
+    }
+
+    size /= 2;
+
+    for(size_t i = 0; i < branch_t::num_children; ++i)
+    {
+      const size_t ci = b.first_child_ + i;
+
+      if(branches_[ci].num_entities_ > 0 &&
+         bf(branches_[ci].coordinates(range_),
+            size, scale_, std::forward<ARGS>(args)...))
+      {
+        traverse_(ci, size, std::forward<LF>(lf), std::forward<BF>(bf),
+                  std::forward<ARGS>(args)...);
+      }
+    }
+  }
+
+  /*!
+    Concurrent traverse_. The branches at queue_depth are traversed by
+    tasks of the group, and lf(slot, first, last) is passed the index of
+    the branch at queue_depth that contains the leaf.
+   */
+  template<
+    typename LF,
+    typename BF,
+    typename... ARGS
+  >
+  void
+  traverse_(
+    task_group& group,
+    size_t slot,
+    size_t queue_depth,
+    size_t depth,
+    size_t bi,
+    element_t size,
+    LF&& lf,
+    BF&& bf,
+    ARGS&&... args
+  )
+  {
+    const branch_t& b = branches_[bi];
+
+    if(b.is_leaf())
+    {
+      lf(slot << (queue_depth - depth) * dimension,
+        b.first_entity_, b.first_entity_ + b.num_entities_);
+      return;
+    }
+
+    size /= 2;
+    ++depth;
+
+    for(size_t i = 0; i < branch_t::num_children; ++i)
+    {
+      const size_t ci = b.first_child_ + i;
+      const size_t si = slot * branch_t::num_children + i;
+
+      if(branches_[ci].num_entities_ == 0 ||
+         !bf(branches_[ci].coordinates(range_),
+             size, scale_, std::forward<ARGS>(args)...))
+      {
+        continue;
+      }
+
+      if(depth == queue_depth)
+      {
+        group.run([&, size, ci, si]()
+        {
+          traverse_(ci, size,
+            [&](size_t first, size_t last){ lf(si, first, last); },
+            std::forward<BF>(bf), std::forward<ARGS>(args)...);
+        });
+      }
+      else{
+        traverse_(group, si, queue_depth, depth, ci, size,
+                  std::forward<LF>(lf), std::forward<BF>(bf),
+                  std::forward<ARGS>(args)...);
+      }
+    }
+  }
+
+  template<
+    typename EF,
+    typename BF,
+    typename... ARGS
+  >
+  subentity_space_t
+  find_(
+    thread_pool& pool,
+    EF&& ef,
+    BF&& bf,
+    ARGS&&... args
+  )
+  {
+    build_();
+
+    const size_t queue_depth = get_queue_depth(pool);
+
+    // One result slot per branch at queue_depth. The slots are merged in
+    // branch order, so the result does not depend on the scheduling.
+    std::vector<std::vector<entity_t*>> slots(
+      branch_int_t(1) << queue_depth * dimension);
+
+    auto lf = [&](size_t slot, size_t first, size_t last){
+      for(size_t i = first; i < last; ++i)
+      {
+        if(ef(i))
+        {
+          slots[slot].push_back(ents_[i]);
+        }
+      }
+    };
+
+    task_group group(pool);
+
+    traverse_(group, 0, queue_depth, 0, 0, element_t(1), lf,
+      std::forward<BF>(bf), std::forward<ARGS>(args)...);
+
+    group.wait();
+
+    subentity_space_t ents;
+    ents.set_master(entities_);
+
+    for(auto& slot : slots)
+    {
+      for(auto ent : slot)
+      {
+        ents.push_back(ent);
+      }
+    }
+
+    return ents;
+  }
+
+  template<
+    typename LF,
+    typename BF,
+    typename... ARGS
+  >
+  void
+  apply_(
+    thread_pool& pool,
+    LF&& lf,
+    BF&& bf,
+    ARGS&&... args
+  )
+  {
+    build_();
+
+    auto slot_lf = [&](size_t, size_t first, size_t last){
+      lf(first, last);
+    };
+
+    task_group group(pool);
+
+    traverse_(group, 0, get_queue_depth(pool), 0, 0, element_t(1), slot_lf,
+      std::forward<BF>(bf), std::forward<ARGS>(args)...);
+
+    group.wait();
+  }
+
+  std::vector<query_group_t>
+  group_queries_(
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    return query_batch_t::group(centers, radii,
+      [this](const point_t& p){
+        return to_branch_id(p, branch_id_t::max_depth).value_();
+      });
+  }
+
+  void
+  find_group_(
+    query_group_t& g,
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    // Collect the leaves that intersect the bounding box of the group.
+    std::vector<std::pair<size_t, size_t>> leaves;
+
+    traverse_(0, element_t(1),
+      [&](size_t first, size_t last){
+        leaves.emplace_back(first, last);
+      },
+      geometry_t::intersects_box, g.min, g.max);
+
+    g.offsets.resize(g.queries.size() + 1);
+    g.offsets[0] = 0;
+
+    for(size_t q = 0; q < g.queries.size(); ++q)
+    {
+      const point_t& c = centers[g.queries[q]];
+      const element_t r = radii[g.queries[q]];
+
+      for(auto& l : leaves)
+      {
+        for(size_t i = l.first; i < l.second; ++i)
+        {
+          if(geometry_t::within(coordinates_[i], c, r))
+          {
+            g.ents.push_back(ents_[i]);
+          }
+        }
+      }
+
+      g.offsets[q + 1] = g.ents.size();
+    }
+  }
+
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit_(
+    size_t bi,
+    size_t depth,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    branch_t* b = &branches_[bi];
+
+    if(f(b, depth, std::forward<ARGS>(args)...) || b->is_leaf())
+    {
+      return;
+    }
+
+    for(size_t i = 0; i < branch_t::num_children; ++i)
+    {
+      visit_(b->first_child_ + i, depth + 1,
+             std::forward<F>(f), std::forward<ARGS>(args)...);
+    }
+  }
+
+  template<
+    typename F,
+    typename... ARGS
+  >
+  void
+  visit_(
+    task_group& group,
+    size_t bi,
+    size_t depth,
+    size_t queue_depth,
+    F&& f,
+    ARGS&&... args
+  )
+  {
+    if(depth == queue_depth)
+    {
+      group.run([&, bi, depth]()
+      {
+        visit_(bi, depth, std::forward<F>(f), std::forward<ARGS>(args)...);
+      });
+
+      return;
+    }
+
+    branch_t* b = &branches_[bi];
+
+    if(f(b, depth, std::forward<ARGS>(args)...) || b->is_leaf())
+    {
+      return;
+    }
+
+    for(size_t i = 0; i < branch_t::num_children; ++i)
+    {
+      visit_(group, b->first_child_ + i, depth + 1, queue_depth,
+             std::forward<F>(f), std::forward<ARGS>(args)...);
+    }
+  }
+
+  // Branches, breadth first, with the children of each branch adjacent.
+  std::vector<branch_t> branches_;
+
+  // Inserted entities in Morton order, and their keys and coordinates.
+  std::vector<branch_int_t> keys_;
+  entity_vector_t ents_;
+  std::vector<point_t> coordinates_;
+
+  // All entities, by entity id.
+  entity_space_t entities_;
+
+  bool stale_ = true;
+  size_t max_depth_ = 0;
+  std::array<point__<element_t, dimension>, 2> range_;
+  point__<element_t, dimension> scale_;
+  element_t max_scale_;
+};
+
+} // namespace topology
+} // namespace flecsi
+
+#endif // flecsi_topology_linear_tree_topology_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
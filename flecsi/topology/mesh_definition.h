@@ -11,10 +11,13 @@
 //! @date Initial file creation: Nov 17, 2016
 //----------------------------------------------------------------------------//
 
+#include <map>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "flecsi/geometry/point.h"
+#include "flecsi/utils/array_ref.h"
 
 namespace flecsi {
 namespace topology {
@@ -34,6 +37,59 @@ public:
 
   using point_t = point__<double, DIMENSION>;
 
+  /// Non-allocating view of the entities that define an entity.
+  using id_array_t = utils::array_ref<size_t>;
+
+  //--------------------------------------------------------------------------//
+  //! Compressed row storage of a connectivity: row \em i holds the ids
+  //! of the entities that are connected to entity \em i.
+  //--------------------------------------------------------------------------//
+
+  struct crs_t
+  {
+    std::vector<size_t> offsets;
+    std::vector<size_t> indices;
+
+    /// Return the number of rows.
+    size_t
+    size()
+    const
+    {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    } // size
+
+    /// Return a pointer to the first entry of row \em i.
+    const size_t *
+    begin(
+      size_t i
+    )
+    const
+    {
+      return indices.data() + offsets[i];
+    } // begin
+
+    /// Return a pointer past the last entry of row \em i.
+    const size_t *
+    end(
+      size_t i
+    )
+    const
+    {
+      return indices.data() + offsets[i+1];
+    } // end
+
+    /// Return a view of row \em i.
+    id_array_t
+    operator [] (
+      size_t i
+    )
+    const
+    {
+      return id_array_t(begin(i), offsets[i+1] - offsets[i]);
+    } // operator []
+
+  }; // struct crs_t
+
   /// Default constructor
   mesh_definition__() {}
 
@@ -105,10 +161,169 @@ public:
   )
   const
   {
-    auto vvec = entities(from_dimension, to_dimension, id);
-    return std::set<size_t>(vvec.begin(), vvec.end());
+    auto ids = entities_ref(from_dimension, to_dimension, id);
+    return std::set<size_t>(ids.begin(), ids.end());
   } // entities_set
 
+  //--------------------------------------------------------------------------//
+  //! Return the whole connectivity from \em from_dimension to
+  //! \em to_dimension in compressed row storage. Specializations that
+  //! store their connectivity this way should return it directly. The
+  //! default implementation gathers it from entities() on first use and
+  //! keeps it until clear_connectivity_cache is called.
+  //!
+  //! @param from_dimension The dimension of the entities being defined.
+  //! @param to_dimension   The dimension of the entities of the definition.
+  //--------------------------------------------------------------------------//
+
+  virtual
+  const crs_t &
+  entities_crs(
+    size_t from_dimension,
+    size_t to_dimension
+  )
+  const
+  {
+    auto key = std::make_pair(from_dimension, to_dimension);
+    auto itr = connectivity_cache_.find(key);
+
+    if(itr != connectivity_cache_.end()) {
+      return itr->second;
+    } // if
+
+    crs_t & crs = connectivity_cache_[key];
+
+    const size_t num_from = num_entities(from_dimension);
+    crs.offsets.reserve(num_from+1);
+    crs.offsets.push_back(0);
+
+    for(size_t e(0); e<num_from; ++e) {
+      auto ids = entities(from_dimension, to_dimension, e);
+      crs.indices.insert(crs.indices.end(), ids.begin(), ids.end());
+      crs.offsets.push_back(crs.indices.size());
+    } // for
+
+    return crs;
+  } // entities_crs
+
+  //--------------------------------------------------------------------------//
+  //! Return a view of the entities of dimension \em to that define the
+  //! entity of dimension \em from with the given identifier \em id. The
+  //! view stays valid as long as the connectivity is not changed.
+  //!
+  //! @param from_dimension The dimension of the entity for which the
+  //!                       definition is being requested.
+  //! @param to_dimension   The dimension of the entities of the definition.
+  //! @param id             The id of the entity for which the definition is
+  //!                       being requested.
+  //--------------------------------------------------------------------------//
+
+  id_array_t
+  entities_ref(
+    size_t from_dimension,
+    size_t to_dimension,
+    size_t id
+  )
+  const
+  {
+    return entities_crs(from_dimension, to_dimension)[id];
+  } // entities_ref
+
+  //--------------------------------------------------------------------------//
+  //! Return the inverse of the connectivity from \em from_dimension to
+  //! \em to_dimension. The index is built on first use with a single pass
+  //! over the connectivity and is kept until clear_connectivity_cache is
+  //! called. It is not safe to build indices concurrently.
+  //!
+  //! @param from_dimension The dimension of the referencing entities.
+  //! @param to_dimension   The dimension of the referenced entities.
+  //--------------------------------------------------------------------------//
+
+  const crs_t &
+  inverse_index(
+    size_t from_dimension,
+    size_t to_dimension
+  )
+  const
+  {
+    auto key = std::make_pair(from_dimension, to_dimension);
+    auto itr = inverse_indices_.find(key);
+
+    if(itr != inverse_indices_.end()) {
+      return itr->second;
+    } // if
+
+    crs_t & index = inverse_indices_[key];
+
+    const crs_t & conn = entities_crs(from_dimension, to_dimension);
+    const size_t num_from = conn.size();
+    const size_t num_to = num_entities(to_dimension);
+
+    // Count the entries of each row.
+    index.offsets.assign(num_to+1, 0);
+
+    for(auto v: conn.indices) {
+      ++index.offsets[v+1];
+    } // for
+
+    for(size_t v(0); v<num_to; ++v) {
+      index.offsets[v+1] += index.offsets[v];
+    } // for
+
+    // Fill the rows. Entities are visited in increasing order, so each
+    // row is sorted, and an entity listing a vertex twice is only added
+    // once (the row then has an unused slot that is compacted below).
+    std::vector<size_t> fill(index.offsets.begin(), index.offsets.end()-1);
+    index.indices.resize(index.offsets[num_to]);
+    bool compact = false;
+
+    for(size_t e(0); e<num_from; ++e) {
+      for(auto v: conn[e]) {
+        if(fill[v] > index.offsets[v] && index.indices[fill[v]-1] == e) {
+          compact = true;
+          continue;
+        } // if
+
+        index.indices[fill[v]++] = e;
+      } // for
+    } // for
+
+    if(compact) {
+      size_t pos(0);
+
+      for(size_t v(0); v<num_to; ++v) {
+        const size_t first = index.offsets[v];
+        index.offsets[v] = pos;
+
+        for(size_t i(first); i<fill[v]; ++i) {
+          index.indices[pos++] = index.indices[i];
+        } // for
+      } // for
+
+      index.offsets[num_to] = pos;
+      index.indices.resize(pos);
+    } // if
+
+    return index;
+  } // inverse_index
+
+  //--------------------------------------------------------------------------//
+  //! Discard the cached connectivities and inverse indices. This must be
+  //! called by derived types when their connectivity changes.
+  //--------------------------------------------------------------------------//
+
+  void
+  clear_connectivity_cache()
+  {
+    connectivity_cache_.clear();
+    inverse_indices_.clear();
+  } // clear_connectivity_cache
+
+private:
+
+  mutable std::map<std::pair<size_t, size_t>, crs_t> connectivity_cache_;
+  mutable std::map<std::pair<size_t, size_t>, crs_t> inverse_indices_;
+
 }; // class mesh_definition__
 
 } // namespace topology
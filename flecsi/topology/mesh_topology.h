@@ -70,8 +70,12 @@
 #include <map>
 #include <cstring>
 #include <type_traits>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <numeric>
 
+#include "flecsi/concurrency/parallel_for.h"
 #include "flecsi/execution/context.h"
 #include "flecsi/topology/mesh_storage.h"
 #include "flecsi/topology/mesh_types.h"
@@ -583,7 +587,9 @@ public:
     E * e 
   )
   {
-    connectivity_t & c = get_connectivity(FM, TM, E::dimension, D);
+    // Read through the const connectivity, so that iterating does not
+    // bump its version.
+    const connectivity_t & c = get_connectivity(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
 
     using etype = entity_type<D, TM>;
@@ -628,6 +634,44 @@ public:
     return entities<D, FM, TM>(e.entity());
   } // entities
 
+  /*!
+    Get the local offsets of the entities of topological dimension D
+    connected to another entity by specified connectivity from domain FM
+    and to domain TM, from the compact 32-bit connectivity storage. The
+    offsets index into entities<D, TM>(). The compact storage is built,
+    or rebuilt after the connectivity changes, on first use, so this must
+    not be called concurrently with itself or with mesh modifications.
+  */
+  template<
+    size_t D,
+    size_t FM = 0,
+    size_t TM = FM,
+    class E
+  >
+  auto
+  local_entities(
+    const E * e
+  ) const
+  {
+    const auto & c =
+      base_t::ms_->topology[FM][TM].get_compact(E::dimension, D);
+    return c.indices(e->template id<FM>());
+  } // local_entities
+
+  template<
+    size_t D,
+    size_t FM = 0,
+    size_t TM = FM,
+    class E
+  >
+  auto
+  local_entities(
+    const domain_entity<FM, E> & e
+  ) const
+  {
+    return local_entities<D, FM, TM>(e.entity());
+  } // local_entities
+
   /*!
     Get the top-level entities of topological dimension D of the specified
     domain M. e.g: cells of the mesh.
@@ -1210,8 +1254,11 @@ private:
     connectivity_t & cell_to_entity =
       get_connectivity_(Domain, UsingDimension, DimensionToBuild);
 
-    // Storage for entity-to-vertex connectivity information.
-    connection_vector_t entity_vertex_conn;
+    // Storage for entity-to-vertex connectivity information. The
+    // vertices of all entities are stored contiguously, along with the
+    // number of vertices of each entity.
+    id_vector_t entity_vertex_conn;
+    index_vector_t entity_vertex_counts;
 
     // Helper variables
     size_t max_cell_entity_conns = 1;
@@ -1231,11 +1278,14 @@ private:
     // Storage for cell-to-entity connectivity information.
     connection_vector_t cell_entity_conn(_num_cells);
 
-    // This map is primarily used to make sure that entities are not
+    // This table is primarily used to make sure that entities are not
     // created multiple times, i.e., that they are unique.  The
-    // emplace method of the map is used to only define a new entity
-    // if it does not already exist in the map.
-    id_vector_map_t entity_vertices_map;
+    // emplace method of the table is used to only define a new entity
+    // if it does not already exist in the table.
+    id_vector_table_t entity_vertices_map(_num_cells);
+
+    // Scratch storage for the sorted vertices of an entity.
+    id_vector_t sorted_vertices;
 
     // This buffer should be large enough to hold all entities
     // vertices that potentially need to be created
@@ -1332,16 +1382,16 @@ private:
         size_t m = sv[i];
 
         // Get the vertices that define this entity by getting
-        // a pointer to the vector-of-vector data and then constructing
-        // a vector of ids for only this entity.
+        // a pointer to the vector-of-vector data and then copying
+        // the ids for only this entity into the scratch storage.
         id_t * a = &entity_vertices[i * m];
-        id_vector_t ev(a, a + m);
+        sorted_vertices.assign(a, a + m);
 
         // Sort the ids for the current entity so that they are
         // monotonically increasing. This ensures that entities are
-        // created uniquely (using emplace_back below) because the ids
+        // created uniquely (using emplace below) because the ids
         // will always occur in the same order for the same entity.
-        std::sort(ev.begin(), ev.end());
+        std::sort(sorted_vertices.begin(), sorted_vertices.end());
 
         //
         // The following set of steps use the vertices that define
@@ -1390,18 +1440,19 @@ private:
 
         // Emplace the sorted vertices into the entity map
         auto itr = entity_vertices_map.emplace(
-            std::move(ev), id_t::make<DimensionToBuild, Domain>(
+            sorted_vertices.data(), m, id_t::make<DimensionToBuild, Domain>(
           entity_id, cell_id.partition()));
 
         // Add this id to the cell to entity connections
-        conns.push_back(itr.first->second);
+        conns.push_back(itr.first);
       
         // If the insertion took place
         if (itr.second) {
 
-          // what does this do?
-          id_vector_t ev2 = id_vector_t(a, a + m);
-          entity_vertex_conn.emplace_back(std::move(ev2));
+          // Keep the vertices of the new entity in their original,
+          // i.e., unsorted, order.
+          entity_vertex_conn.insert(entity_vertex_conn.end(), a, a + m);
+          entity_vertex_counts.push_back(m);
           entity_ids.emplace_back( entity_id );
 
           max_cell_entity_conns =
@@ -1418,17 +1469,40 @@ private:
   
     // sort the entity connectivity. Entities may have been created out of
     // order.  Sort them using the list of entity ids we kept track of
-    if ( has_intermediate_map )
-      utils::reorder_destructive(
-        entity_ids.begin(),
-        entity_ids.end(),
-        entity_vertex_conn.begin()
-      );
+    if ( has_intermediate_map ) {
+      const size_t entity_count = entity_ids.size();
+
+      // Compute the offsets of the entities in their sorted positions.
+      index_vector_t sorted_offsets(entity_count + 1, 0);
+      for(size_t e{0}; e<entity_count; ++e) {
+        sorted_offsets[entity_ids[e] + 1] = entity_vertex_counts[e];
+      } // for
+
+      std::partial_sum(sorted_offsets.begin(), sorted_offsets.end(),
+        sorted_offsets.begin());
+
+      // Scatter the vertices and counts to their sorted positions.
+      id_vector_t sorted_conn(entity_vertex_conn.size());
+      index_vector_t sorted_counts(entity_count);
+
+      size_t pos{0};
+      for(size_t e{0}; e<entity_count; ++e) {
+        const size_t count = entity_vertex_counts[e];
+        std::copy(entity_vertex_conn.begin() + pos,
+          entity_vertex_conn.begin() + pos + count,
+          sorted_conn.begin() + sorted_offsets[entity_ids[e]]);
+        sorted_counts[entity_ids[e]] = count;
+        pos += count;
+      } // for
+
+      entity_vertex_conn.swap(sorted_conn);
+      entity_vertex_counts.swap(sorted_counts);
+    } // if
 
     // Set the connectivity information from the created entities to
     // the vertices.
     connectivity_t & entity_to_vertex = dc.template get<DimensionToBuild>(0);
-    entity_to_vertex.init(entity_vertex_conn);
+    entity_to_vertex.init(entity_vertex_conn, entity_vertex_counts);
     cell_to_entity.init(cell_entity_conn);
   } // build_connectivity
 
@@ -1456,29 +1530,40 @@ private:
     
     // get the list of "to" entities
     const auto & to_entities = entities<TD, TM>();
+    const size_t num_to = to_entities.size();
+
+    const size_t num_from = num_entities_(FD, FM);
 
-    index_vector_t pos(num_entities_(FD, FM), 0);
+    // Count how many connectivities go into each slot. The counters are
+    // atomic because many "to" entities reference the same "from" slot.
+    std::vector<std::atomic<size_t>> counts(num_from);
 
-    // Count how many connectivities go into each slot
-    for (auto to_entity : to_entities) {
+    parallel_for(0, num_to, [&](size_t t) {
+      auto to_entity = to_entities[t];
       for (id_t from_id : entity_ids<FD, TM, FM>(to_entity)) {
-        ++pos[from_id.entity()];
+        counts[from_id.entity()].fetch_add(1, std::memory_order_relaxed);
       }
+    });
+
+    index_vector_t pos(num_from);
+    for (size_t i = 0; i < num_from; ++i) {
+      pos[i] = counts[i].load(std::memory_order_relaxed);
+      counts[i].store(0, std::memory_order_relaxed);
     }
 
     out_conn.resize(pos);
 
-    std::fill(pos.begin(), pos.end(), 0);
-    
-
-    // now do the actual transpose
-    for (auto to_entity : to_entities) {
+    // now do the actual transpose, filling the slots of each "from"
+    // entity directly. The order within a slot is fixed by the sort below.
+    parallel_for(0, num_to, [&](size_t t) {
+      auto to_entity = to_entities[t];
       for (auto from_id : entity_ids<FD, TM, FM>(to_entity)) {
         auto from_lid = from_id.entity();
-        out_conn.set(from_lid, to_entity->template global_id<TM>(),
-            pos[from_lid]++);
+        out_conn.set_unversioned(from_lid,
+          to_entity->template global_id<TM>(),
+          counts[from_lid].fetch_add(1, std::memory_order_relaxed));
       }
-    }
+    });
 
     // now we need to sort the connecvtivity arrays:
     // .. we have to make sure the order of connectivity information apears in
@@ -1499,34 +1584,48 @@ private:
     const auto& to__cis_to_gis = context_.index_map(to_index_space);
 
     // do the final sort of the connectivity arrays
-    for (auto from_id : entity_ids<FD, TM>()) {
-      // get the connectivity array
-      size_t count;
-      auto conn = out_conn.get_entities( from_id.entity(), count );
-      // pack it into a list of id and global id pairs
-      std::vector< std::pair<size_t, id_t> > gids( count );
-      std::transform(
-        conn, conn+count, gids.begin(),
-        [&](auto id) {
-          return std::make_pair( to__cis_to_gis.at(id.entity()), id );
-        }
-      );
-      // sort via global id 
-      std::sort(
-        gids.begin(),
-        gids.end(),
-        []( auto a, auto b ) {
-          return a.first < b.first;
-        }
-      );
-      // upack the results
-      std::transform(
-        gids.begin(), gids.end(), conn,
-        [](auto id_pair) {
-          return id_pair.second;
-        }
-      );
-    }
+    const auto from_ids = entity_ids<FD, TM>();
+    const auto from_ids_begin = from_ids.begin();
+
+    parallel_for_blocks(0, from_ids.end() - from_ids_begin,
+      [&](size_t first, size_t last) {
+      // scratch storage for the id and global id pairs of a slot
+      std::vector< std::pair<size_t, id_t> > gids;
+
+      for (size_t f = first; f < last; ++f) {
+        id_t from_id = from_ids_begin[f];
+        // get the connectivity array
+        size_t count;
+        auto conn = out_conn.get_entities_unversioned( from_id.entity(),
+          count );
+        // pack it into a list of id and global id pairs
+        gids.resize( count );
+        std::transform(
+          conn, conn+count, gids.begin(),
+          [&](auto id) {
+            return std::make_pair( to__cis_to_gis.at(id.entity()), id );
+          }
+        );
+        // sort via global id 
+        std::sort(
+          gids.begin(),
+          gids.end(),
+          []( auto a, auto b ) {
+            return a.first < b.first;
+          }
+        );
+        // upack the results
+        std::transform(
+          gids.begin(), gids.end(), conn,
+          [](auto id_pair) {
+            return id_pair.second;
+          }
+        );
+      }
+    });
+
+    // The parallel fill and sort do not version the connectivity.
+    out_conn.touch();
   } // transpose
 
   /*!
@@ -1556,94 +1655,136 @@ private:
     auto num_from_ent = num_entities_(FD, FM);
     auto num_to_ent = num_entities_(TD, FM);
 
-    // Temporary storage for connection id's
-    connection_vector_t conns(num_from_ent);
-
-    // Keep track of which to id's we have visited
-    using visited_vec = std::vector<bool>;
-    visited_vec visited(num_to_ent);
-
-    size_t max_size = 1;
-
     // Read connectivities
-    connectivity_t & c = get_connectivity_(FM, FD, D);
+    const connectivity_t & c = get_connectivity_(FM, FD, D);
     assert(!c.empty());
 
-    connectivity_t & c2 = get_connectivity_(TM, TD, D);
+    const connectivity_t & c2 = get_connectivity_(TM, TD, D);
     assert(!c2.empty());
-    
-    // Iterate through entities in "from" topological dimension
-    for(auto from_entity : entities<FD, FM>()){
 
-      id_t from_id = from_entity->template global_id<FM>();
-      id_vector_t & ents = conns[from_id.entity()];
-      ents.reserve(max_size);
+    auto from_entities = entities<FD, FM>();
+    const size_t n = from_entities.size();
 
-      size_t count;
-      id_t * ep = c.get_entities(from_id.entity(), count);
+    // The connections are computed in two passes. The first pass finds
+    // the connections of each block of "from" entities and stores them
+    // contiguously in the block. The second pass fills the connectivity
+    // arrays, whose offsets are known once the counts of every "from"
+    // entity are known.
+    struct block_t {
+      size_t first;
+      id_vector_t ids;
+    }; // struct block_t
 
-      // Create a copy of to vertices so they can be sorted
-      id_vector_t from_verts(ep, ep+count);
-      // sort so we have a unique key for from vertices
-      std::sort(from_verts.begin(), from_verts.end());
+    std::vector<block_t> blocks;
+    std::mutex blocks_mutex;
 
-      // initially set all to id's to unvisited
-      for (auto from_ent2 : entities<D, FM>(from_entity)) {
-        for (id_t to_id : entity_ids<TD, TM>(from_ent2)) {
-          visited[to_id.entity()] = false;
-        }
-      }
+    index_vector_t counts(num_from_ent, 0);
 
-      // Loop through each from entity again
-      for (auto from_ent2 : entities<D, FM>(from_entity)) {
-        for (id_t to_id : entity_ids<TD, TM>(from_ent2)) {
+    parallel_for_blocks(0, n, [&](size_t first, size_t last) {
+      block_t block{first, {}};
 
-          // If we have already visited, skip
-          if (visited[to_id.entity()]) {
-            continue;
-          } // if
+      // Keep track of which to id's we have visited
+      using visited_vec = std::vector<bool>;
+      visited_vec visited(num_to_ent);
 
-          visited[to_id.entity()] = true;
+      // Scratch storage for the sorted vertices
+      id_vector_t from_verts;
+      id_vector_t to_verts;
 
-          // If the topological dimensions are the same, always add to id
-          if (FD == TD) {
-            if (from_id != to_id) {
-              ents.push_back(to_id);
-            } // if
-          } else {
-            size_t count;
-            id_t * ep = c2.get_entities(to_id.entity(), count);
-
-            // Create a copy of to vertices so they can be sorted
-            id_vector_t to_verts(ep, ep + count);
-            // Sort to verts so we can do an inclusion check
-            std::sort(to_verts.begin(), to_verts.end());
-
-            // If from vertices contains the to vertices add to id
-            // to this connection set
-            if (D < TD) {
-              if (std::includes(from_verts.begin(), from_verts.end(),
-                                  to_verts.begin(), to_verts.end()))
-                ents.emplace_back(to_id);
-            }
-            // If we are going through a higher level, then set
-            // intersection is sufficient. i.e. one set does not need to
-            // be a subset of the other
-            else {
-              if (utils::intersects(from_verts.begin(), from_verts.end(),
-                                      to_verts.begin(), to_verts.end()))
-                ents.emplace_back(to_id);
+      // Iterate through entities in "from" topological dimension
+      for (size_t e = first; e < last; ++e) {
+        auto from_entity = from_entities[e];
+
+        id_t from_id = from_entity->template global_id<FM>();
+        const size_t start = block.ids.size();
+
+        size_t count;
+        const id_t * ep = c.get_entities(from_id.entity(), count);
+
+        // Create a copy of to vertices so they can be sorted
+        from_verts.assign(ep, ep+count);
+        // sort so we have a unique key for from vertices
+        std::sort(from_verts.begin(), from_verts.end());
+
+        // initially set all to id's to unvisited
+        for (auto from_ent2 : entities<D, FM>(from_entity)) {
+          for (id_t to_id : entity_ids<TD, TM>(from_ent2)) {
+            visited[to_id.entity()] = false;
+          }
+        }
+
+        // Loop through each from entity again
+        for (auto from_ent2 : entities<D, FM>(from_entity)) {
+          for (id_t to_id : entity_ids<TD, TM>(from_ent2)) {
+
+            // If we have already visited, skip
+            if (visited[to_id.entity()]) {
+              continue;
             } // if
 
-          } // if
+            visited[to_id.entity()] = true;
+
+            // If the topological dimensions are the same, always add to id
+            if (FD == TD) {
+              if (from_id != to_id) {
+                block.ids.push_back(to_id);
+              } // if
+            } else {
+              size_t count;
+              const id_t * ep = c2.get_entities(to_id.entity(), count);
+
+              // Create a copy of to vertices so they can be sorted
+              to_verts.assign(ep, ep + count);
+              // Sort to verts so we can do an inclusion check
+              std::sort(to_verts.begin(), to_verts.end());
+
+              // If from vertices contains the to vertices add to id
+              // to this connection set
+              if (D < TD) {
+                if (std::includes(from_verts.begin(), from_verts.end(),
+                                    to_verts.begin(), to_verts.end()))
+                  block.ids.emplace_back(to_id);
+              }
+              // If we are going through a higher level, then set
+              // intersection is sufficient. i.e. one set does not need to
+              // be a subset of the other
+              else {
+                if (utils::intersects(from_verts.begin(), from_verts.end(),
+                                        to_verts.begin(), to_verts.end()))
+                  block.ids.emplace_back(to_id);
+              } // if
+
+            } // if
+          } // for
         } // for
+
+        counts[from_id.entity()] = block.ids.size() - start;
       } // for
 
-      max_size = std::max(ents.size(), max_size);
-    } // for
+      std::lock_guard<std::mutex> lock(blocks_mutex);
+      blocks.emplace_back(std::move(block));
+    });
+
+    // Size the connectivity arrays from the counts
+    out_conn.resize(counts);
+
+    // Fill the connectivity arrays from the blocks
+    parallel_for(0, blocks.size(), [&](size_t b) {
+      const block_t & block = blocks[b];
+      auto itr = block.ids.begin();
+
+      for (size_t e = block.first; itr != block.ids.end(); ++e) {
+        const size_t from_lid =
+          from_entities[e]->template global_id<FM>().entity();
+
+        for (size_t i = 0; i < counts[from_lid]; ++i, ++itr) {
+          out_conn.set_unversioned(from_lid, *itr, i);
+        } // for
+      } // for
+    }, 1);
 
-    // Finally create the connection from the temporary conns
-    out_conn.init(conns);
+    // The parallel fill does not version the connectivity.
+    out_conn.touch();
   } // intersect
 
   /*!
@@ -21,10 +21,12 @@
    \date Initial file creation: Dec 23, 2015
  */
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "flecsi/data/data_client.h"
@@ -85,6 +87,155 @@ struct id_vector_hash_t {
 using id_vector_map_t =
   std::unordered_map<id_vector_t, utils::id_t, id_vector_hash_t>;
 
+/*!
+  \class id_vector_table_t mesh_types.h
+  \brief id_vector_table_t maps sorted id sequences, e.g., the vertices
+    of a face, to an id. It serves the same purpose as id_vector_map_t
+    when building topology connectivities, but without a heap allocation
+    per key: the keys are packed into a single flat array and indexed by
+    an open-addressing hash table with linear probing.
+ */
+class id_vector_table_t
+{
+public:
+
+  using id_t = utils::id_t;
+
+  /*!
+    Constructor.
+
+    \param capacity The expected number of keys.
+   */
+  id_vector_table_t(size_t capacity = 0)
+  {
+    size_t num_slots = 16;
+
+    while(num_slots < 2*capacity) {
+      num_slots *= 2;
+    } // while
+
+    slots_.resize(num_slots, empty_slot());
+    key_offsets_.reserve(capacity + 1);
+    key_offsets_.push_back(0);
+    values_.reserve(capacity);
+    hashes_.reserve(capacity);
+  } // id_vector_table_t
+
+  /*!
+    Insert a key with the given value if it does not already exist.
+
+    \param key   A pointer to the sorted ids of the key.
+    \param count The number of ids in the key.
+    \param value The value to insert.
+
+    \return A pair with the value associated with the key, and a boolean
+      that is true if the insertion took place.
+   */
+  std::pair<id_t, bool>
+  emplace(
+    const id_t * key,
+    size_t count,
+    id_t value
+  )
+  {
+    if(2*(values_.size() + 1) > slots_.size()) {
+      rehash(2*slots_.size());
+    } // if
+
+    const size_t h = hash(key, count);
+    const size_t mask = slots_.size() - 1;
+
+    for(size_t s = h & mask;; s = (s + 1) & mask) {
+      const size_t e = slots_[s];
+
+      if(e == empty_slot()) {
+        slots_[s] = values_.size();
+        keys_.insert(keys_.end(), key, key + count);
+        key_offsets_.push_back(keys_.size());
+        values_.push_back(value);
+        hashes_.push_back(h);
+        return { value, true };
+      } // if
+
+      if(hashes_[e] == h && equal(e, key, count)) {
+        return { values_[e], false };
+      } // if
+    } // for
+  } // emplace
+
+  /*!
+    Return the number of keys.
+   */
+  size_t size() const { return values_.size(); }
+
+private:
+
+  static constexpr size_t empty_slot()
+  {
+    return std::numeric_limits<size_t>::max();
+  } // empty_slot
+
+  // Hash the same bits of the local id that id_t::operator== compares.
+  static
+  size_t
+  hash(
+    const id_t * key,
+    size_t count
+  )
+  {
+    uint64_t h = 14695981039346656037ull;
+
+    for(size_t i = 0; i < count; ++i) {
+      h ^= uint64_t(key[i].local_id() & id_t::FLAGS_UNMASK);
+      h *= 1099511628211ull;
+    } // for
+
+    return h ^ (h >> 32);
+  } // hash
+
+  bool
+  equal(
+    size_t e,
+    const id_t * key,
+    size_t count
+  ) const
+  {
+    const size_t start = key_offsets_[e];
+
+    if(key_offsets_[e + 1] - start != count) {
+      return false;
+    } // if
+
+    return std::equal(key, key + count, keys_.begin() + start);
+  } // equal
+
+  void
+  rehash(
+    size_t num_slots
+  )
+  {
+    slots_.assign(num_slots, empty_slot());
+    const size_t mask = num_slots - 1;
+
+    for(size_t e = 0; e < values_.size(); ++e) {
+      size_t s = hashes_[e] & mask;
+
+      while(slots_[s] != empty_slot()) {
+        s = (s + 1) & mask;
+      } // while
+
+      slots_[s] = e;
+    } // for
+  } // rehash
+
+  id_vector_t keys_;
+  std::vector<size_t> key_offsets_;
+  id_vector_t values_;
+  std::vector<size_t> hashes_;
+  std::vector<size_t> slots_;
+
+}; // class id_vector_table_t
+
 // the second topology vector holds the offsets into to from dimension
 using index_vector_t = std::vector<size_t>;
 
@@ -295,6 +446,7 @@ class connectivity_t
   auto
   entity_storage()
   {
+    ++version_;
     return index_space_.storage();
   }
 
@@ -302,14 +454,31 @@ class connectivity_t
   void
   set_entity_storage(ST s)
   {
+    ++version_;
     index_space_.set_storage(s);
   }
 
+  /*!
+    Return a counter that changes whenever the connections are modified
+    through this interface. Derived storage, e.g., the compact form, uses
+    it to detect that it is out of date. The mutators and the non-const
+    storage accessors bump it, except for the *_unversioned methods, which
+    may be used concurrently and must be followed by a call to touch().
+   */
+  size_t version() const { return version_; }
+
+  /*!
+    Mark the connections as modified, e.g., after filling them through
+    the *_unversioned methods.
+   */
+  void touch() { ++version_; }
+
   /*!
     Clear the storage arrays for this instance.
    */
   void clear()
   {
+    ++version_;
     index_space_.clear();
     offsets_.clear();
   } // clear
@@ -343,6 +512,30 @@ class connectivity_t
     index_space_.end_push_(start);
   } // init
 
+  /*!
+    Initialize the connectivity information from a flat array of ids
+    and the number of ids in each connectivity group.
+
+    \param ids    The concatenated to ids of all groups.
+    \param counts The number of to ids in each group.
+   */
+  void init(const id_vector_t & ids, const index_vector_t & counts) {
+
+    clear();
+
+    size_t start = index_space_.begin_push_();
+
+    for (id_t id : ids) {
+      index_space_.batch_push_(id);
+    } // for
+
+    for (size_t count : counts) {
+      offsets_.add_count(count);
+    } // for
+
+    index_space_.end_push_(start);
+  } // init
+
   /*!
     Resize a connection.
 
@@ -370,6 +563,7 @@ class connectivity_t
     Push a single id into the current from group.
    */
   void push(id_t id) {
+    ++version_;
     index_space_.push_(id);
   } // push
 
@@ -412,6 +606,13 @@ class connectivity_t
     Get the entities of the specified from index.
    */
   id_t * get_entities(size_t index)
+  {
+    assert(index < offsets_.size());
+    ++version_;
+    return index_space_.id_array() + offsets_[index].start();
+  }
+
+  const id_t * get_entities(size_t index) const
   {
     assert(index < offsets_.size());
     return index_space_.id_array() + offsets_[index].start();
@@ -421,6 +622,25 @@ class connectivity_t
     Get the entities of the specified from index and return the count.
    */
   id_t * get_entities(size_t index, size_t & count)
+  {
+    ++version_;
+    return get_entities_unversioned(index, count);
+  }
+
+  const id_t * get_entities(size_t index, size_t & count) const
+  {
+    assert(index < offsets_.size());
+    offset_t o = offsets_[index];
+    count = o.count();
+    return index_space_.id_array() + o.start();
+  }
+
+  /*!
+    Same as get_entities(index, count), but without bumping version(), so
+    that the entities of different from indices may be modified
+    concurrently. Call touch() once the modifications are complete.
+   */
+  id_t * get_entities_unversioned(size_t index, size_t & count)
   {
     assert(index < offsets_.size());
     offset_t o = offsets_[index];
@@ -447,6 +667,7 @@ class connectivity_t
   void reverse_entities(size_t index)
   {
     assert(index < offsets_.size());
+    ++version_;
     offset_t o = offsets_[index];
     std::reverse(index_space_.index_begin_() + o.start(),
                  index_space_.index_begin_() + o.end());
@@ -462,6 +683,7 @@ class connectivity_t
     assert(index < offsets_.size());
     offset_t o = offsets_[index];
     assert(order.size() == o.count());
+    ++version_;
     utils::reorder(
       order.begin(), order.end(), index_space_.id_array() + o.start());
   }
@@ -475,6 +697,16 @@ class connectivity_t
     Set a single connection.
    */
   void set(size_t from_local_id, id_t to_id, size_t pos)
+  {
+    ++version_;
+    set_unversioned(from_local_id, to_id, pos);
+  }
+
+  /*!
+    Same as set(), but without bumping version(), so that connections may
+    be set concurrently. Call touch() once all of them are set.
+   */
+  void set_unversioned(size_t from_local_id, id_t to_id, size_t pos)
   {
     index_space_(offsets_[from_local_id].start() + pos) = to_id;
   }
@@ -524,10 +756,12 @@ class connectivity_t
 
   auto& to_id_storage()
   {
+    ++version_;
     return index_space_.id_storage_();
   }
 
   auto& get_index_space(){
+    ++version_;
     return index_space_;
   }
 
@@ -545,6 +779,7 @@ class connectivity_t
   auto&
   offsets()
   {
+    ++version_;
     return offsets_;
   }
 
@@ -558,6 +793,7 @@ class connectivity_t
   void
   add_count(uint32_t count)
   {
+    ++version_;
     offsets_.add_count(count);
   }
 
@@ -566,6 +802,7 @@ class connectivity_t
     from connection vector.
   */
   void end_from() {
+    ++version_;
     offsets_.add_end(index_space_.size());
   } // end_from
 
@@ -573,8 +810,151 @@ class connectivity_t
     void, entity_storage_t> index_space_;
   
   offset_storage_t offsets_;
+
+  size_t version_ = 0;
 }; // class connectivity_t
 
+/*!
+  \class compact_connectivity__ mesh_types.h
+  \brief compact_connectivity__ stores a connectivity as plain offsets and
+    local entity offsets of type INDEX, e.g., 32-bit, instead of 128-bit
+    ids with packed offsets. Gather loops that only need the local offsets
+    of the connected entities then move a fraction of the memory. The
+    global ids are still available through the source connectivity.
+
+  \tparam INDEX The unsigned integer type of the local offsets.
+ */
+template<typename INDEX = uint32_t>
+class compact_connectivity__
+{
+ public:
+
+  using id_t = utils::id_t;
+  using index_t = INDEX;
+
+  /*!
+    Build the compact storage from a connectivity. The connectivity must
+    outlive this instance. Use current() to check whether it has changed
+    since.
+   */
+  void init(const connectivity_t & c)
+  {
+    clear();
+
+    const auto & ids = c.to_id_storage();
+    const auto & offsets = c.offsets();
+    const size_t n = c.from_size();
+
+    assert(ids.size() <= std::numeric_limits<INDEX>::max() &&
+      "connectivity too large for index type");
+
+    offsets_.reserve(n + 1);
+    offsets_.push_back(0);
+
+    indices_.reserve(ids.size());
+
+    for (size_t i = 0; i < n; ++i) {
+      auto range = offsets.range(i);
+
+      offsets_.push_back(offsets_.back() + (range.second - range.first));
+
+      for (size_t j = range.first; j < range.second; ++j) {
+        assert(ids[j].entity() <= std::numeric_limits<INDEX>::max() &&
+          "entity offset too large for index type");
+        indices_.push_back(INDEX(ids[j].entity()));
+      } // for
+    } // for
+
+    source_ = &c;
+    version_ = c.version();
+  } // init
+
+  /*!
+    Clear the storage arrays for this instance.
+   */
+  void clear()
+  {
+    offsets_.clear();
+    indices_.clear();
+    source_ = nullptr;
+  } // clear
+
+  /*!
+    True if the compact storage has not been built.
+   */
+  bool empty() const { return source_ == nullptr; }
+
+  /*!
+    True if the compact storage was built from the specified connectivity
+    and the connectivity has not been modified since.
+   */
+  bool current(const connectivity_t & c) const
+  {
+    return source_ == &c && version_ == c.version();
+  } // current
+
+  /*!
+    Return the number of from entities.
+   */
+  size_t from_size() const
+  {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  } // from_size
+
+  /*!
+    Return the number of to entities.
+   */
+  size_t to_size() const { return indices_.size(); }
+
+  /*!
+    Return the number of entities connected to the specified from index.
+   */
+  size_t count(size_t index) const
+  {
+    assert(index < from_size());
+    return offsets_[index + 1] - offsets_[index];
+  } // count
+
+  /*!
+    Return the local offsets of the entities connected to the specified
+    from index.
+   */
+  utils::array_ref<INDEX> indices(size_t index) const
+  {
+    assert(index < from_size());
+    return utils::make_array_ref(indices_.data() + offsets_[index],
+      count(index));
+  } // indices
+
+  /*!
+    Return the global id of a connected entity.
+
+    \param index The from index.
+    \param pos   The position of the connected entity.
+   */
+  id_t global_id(size_t index, size_t pos) const
+  {
+    assert(pos < count(index));
+    return source_->get_entity_vec(index)[pos];
+  } // global_id
+
+  /*!
+    Get the raw offsets and indices arrays.
+   */
+  const std::vector<INDEX> & offsets() const { return offsets_; }
+  const std::vector<INDEX> & indices() const { return indices_; }
+
+ private:
+
+  std::vector<INDEX> offsets_;
+  std::vector<INDEX> indices_;
+  const connectivity_t * source_ = nullptr;
+  size_t version_ = 0;
+
+}; // class compact_connectivity__
+
+using compact_connectivity_t = compact_connectivity__<>;
+
 /*!
   Holds the connectivities from domain M1 -> M2 for all topological dimensions.
  */
@@ -629,6 +1009,26 @@ public:
     return conns_[from_dim][to_dim];
   }
 
+  /*!
+    Get the compact storage of a connectivity. It is built on first use
+    and rebuilt if the connectivity has been modified since. Building it
+    writes to a mutable cache, so this must not be called concurrently,
+    even though it is const.
+   */
+  const compact_connectivity_t &
+  get_compact(size_t from_dim, size_t to_dim) const{
+    assert(from_dim <= D && "invalid from dimension");
+    assert(to_dim <= D && "invalid to dimension");
+
+    auto & cc = compact_[from_dim][to_dim];
+
+    if(!cc.current(conns_[from_dim][to_dim])){
+      cc.init(conns_[from_dim][to_dim]);
+    }
+
+    return cc;
+  }
+
   template<size_t FD, size_t ND>
   id_t* get_entities(mesh_entity_t<FD, ND>* from_ent, size_t to_dim){
     return get<FD>(to_dim).get_entities(from_ent->id(from_domain_));
@@ -685,6 +1085,8 @@ private:
     std::array<std::array<connectivity_t, D + 1>, D + 1>;
 
   conn_array_t conns_;
+  mutable std::array<std::array<compact_connectivity_t, D + 1>, D + 1>
+    compact_;
   size_t from_domain_;
   size_t to_domain_;
 };
@@ -0,0 +1,146 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_topology_serial_entity_arena_h
+#define flecsi_topology_serial_entity_arena_h
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+///
+/// \file
+/// \date Initial file creation: Oct 17, 2017
+///
+
+namespace flecsi {
+namespace topology {
+
+///
+/// \class entity_arena_t entity_arena.h
+/// \brief entity_arena_t allocates the mesh entities of one domain and
+///        dimension contiguously in large blocks, instead of one heap
+///        allocation per entity, so that creating entities is cheap and
+///        iterating over them streams through memory.
+///
+/// All of the entities of an arena must have the same type. Blocks grow
+/// geometrically and are never moved, so entity pointers remain valid
+/// for the lifetime of the arena, which destroys its entities.
+///
+
+class entity_arena_t
+{
+public:
+
+  /// The number of entities in the first block.
+  static constexpr size_t initial_block_entities = 1024;
+
+  entity_arena_t() {}
+
+  entity_arena_t(const entity_arena_t &) = delete;
+  entity_arena_t & operator = (const entity_arena_t &) = delete;
+
+  ~entity_arena_t()
+  {
+    for(auto & b : blocks_) {
+      for(size_t offset(0); offset < b.used; offset += entity_size_) {
+        destroy_(b.data.get() + offset);
+      } // for
+    } // for
+  } // ~entity_arena_t
+
+  ///
+  /// Construct a new entity in the arena.
+  ///
+  /// \tparam T The entity type.
+  /// \param args The entity constructor arguments.
+  ///
+  template<class T, class... S>
+  T *
+  make(
+    S &&... args
+  )
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+      "over-aligned entity types are not supported");
+
+    if(!destroy_) {
+      entity_size_ = sizeof(T);
+      destroy_ = [](char * p) { reinterpret_cast<T *>(p)->~T(); };
+    } // if
+
+    assert(entity_size_ == sizeof(T) && "mixed entity types in arena");
+
+    if(blocks_.empty() || blocks_.back().used == blocks_.back().size) {
+      // Double the capacity with each block.
+      const size_t entities = size_ / entity_size_;
+      add_block(entities > initial_block_entities ?
+        entities : initial_block_entities);
+    } // if
+
+    block_t & b = blocks_.back();
+    T * ent = new (b.data.get() + b.used) T(std::forward<S>(args)...);
+    b.used += entity_size_;
+    size_ += entity_size_;
+
+    return ent;
+  } // make
+
+  ///
+  /// Return true if the entity was allocated by this arena.
+  ///
+  bool
+  owns(
+    const void * ent
+  )
+  const
+  {
+    auto p = static_cast<const char *>(ent);
+
+    for(auto & b : blocks_) {
+      if(p >= b.data.get() && p < b.data.get() + b.used) {
+        return true;
+      } // if
+    } // for
+
+    return false;
+  } // owns
+
+private:
+
+  struct block_t {
+    std::unique_ptr<char[]> data;
+    size_t size;
+    size_t used;
+  }; // struct block_t
+
+  void
+  add_block(
+    size_t entities
+  )
+  {
+    const size_t bytes = entities * entity_size_;
+    blocks_.push_back({std::unique_ptr<char[]>(new char[bytes]), bytes, 0});
+  } // add_block
+
+  std::vector<block_t> blocks_;
+  size_t entity_size_ = 0;
+  size_t size_ = 0;
+  void (*destroy_)(char *) = nullptr;
+
+}; // class entity_arena_t
+
+} // namespace topology
+} // namespace flecsi
+
+#endif // flecsi_topology_serial_entity_arena_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
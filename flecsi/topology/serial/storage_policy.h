@@ -19,6 +19,7 @@
 #include "flecsi/utils/array_ref.h"
 #include "flecsi/utils/reorder.h"
 #include "flecsi/topology/index_space.h"
+#include "flecsi/topology/serial/entity_arena.h"
 
 ///
 /// \file
@@ -57,13 +58,19 @@ struct serial_topology_storage_policy_t
   std::array<std::array<index_spaces_t, NM>, num_partitions> 
     partition_index_spaces;
 
+  // Entities created with make are allocated contiguously per domain and
+  // dimension. The arenas destroy them.
+  std::array<std::array<entity_arena_t, ND + 1>, NM> arenas;
+
   ~serial_topology_storage_policy_t()
   {
     for (size_t m = 0; m < NM; ++m) {
       for (size_t d = 0; d <= ND; ++d) {
         auto & is = index_spaces[m][d];
         for (auto ent : is) {
-          delete ent;
+          if (!arenas[m][d].owns(ent)) {
+            delete ent;
+          }
         }
       }
     }
@@ -79,9 +86,9 @@ struct serial_topology_storage_policy_t
   template <class T, size_t M = 0, class... S>
   T * make(S &&... args)
   {
-    T* ent;
+    T* ent = nullptr;
     size_t dim = entity_dimension(ent);
-    ent = new T(std::forward<S>(args)...);
+    ent = arenas[M][dim].template make<T>(std::forward<S>(args)...);
 
     using dtype = domain_entity<M, T>;
 
@@ -92,7 +99,7 @@ struct serial_topology_storage_policy_t
     auto typed_ent = static_cast<mesh_entity_base_t<NM>*>(ent);
 
     typed_ent->template set_global_id<M>(global_id);
-    is.push_back(ent);
+    is.push_back(dtype(ent));
 
     return ent;
   } // make
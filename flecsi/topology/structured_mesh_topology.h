@@ -12,46 +12,966 @@
 // \date Initial file creation: Jan 13, 2017
 ///
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/data/data_client.h"
+
 namespace flecsi {
 namespace topology {
 
+///
+// \struct structured_box__ structured_mesh_topology.h
+// \brief A box of cells of a logically rectangular mesh.
+///
+template<
+  size_t D
+>
+struct structured_box__
+{
+  using coord_t = std::array<size_t, D>;
+
+  // Global coordinates of the first cell of the box
+  coord_t lower = {};
+
+  // Number of cells of the box along each axis
+  coord_t extents = {};
+
+  // Number of cells of the global mesh along each axis
+  coord_t global_extents = {};
+
+}; // struct structured_box__
+
+///
+// \class structured_layout__ structured_mesh_topology.h
+// \brief structured_layout__ numbers the entities of a box of cells.
+//
+// An entity of topological dimension k extends along k of the D axes.
+// These axes are given by its orientation, a bit mask with k bits set,
+// e.g., in 3D, the x-edges have orientation 1 and the yz-faces have
+// orientation 6. Along an axis in its orientation an entity has one
+// position per cell, along the other axes one per vertex. The entities
+// of one orientation form a box that is numbered with x fastest, and
+// the orientations of one dimension follow each other in increasing
+// order.
+///
+template<
+  size_t D
+>
+class structured_layout__
+{
+public:
+
+  using coord_t = std::array<size_t, D>;
+
+  // Number of orientations over all dimensions
+  static constexpr size_t num_orientations = size_t(1) << D;
+
+  /// Constructor
+  structured_layout__(
+    const coord_t & cells = coord_t()
+  )
+  {
+    init(cells);
+  } // structured_layout__
+
+  ///
+  // Set the number of cells along each axis.
+  ///
+  void
+  init(
+    const coord_t & cells
+  )
+  {
+    cells_ = cells;
+    counts_.fill(0);
+
+    for(size_t m = 0; m < num_orientations; ++m) {
+      const size_t dim = dimension(m);
+      offsets_[m] = counts_[dim];
+      counts_[dim] += size(m);
+    } // for
+  } // init
+
+  ///
+  // Return the topological dimension of the entities of an orientation.
+  ///
+  static
+  constexpr
+  size_t
+  dimension(
+    size_t orientation
+  )
+  {
+    return orientation ? (orientation & 1) + dimension(orientation >> 1) : 0;
+  } // dimension
+
+  /// Return the number of cells along an axis.
+  size_t
+  cells(
+    size_t axis
+  )
+  const
+  {
+    return cells_[axis];
+  } // cells
+
+  /// Return the number of entities of an orientation along an axis.
+  size_t
+  extent(
+    size_t orientation,
+    size_t axis
+  )
+  const
+  {
+    return cells_[axis] + ((orientation >> axis) & 1 ? 0 : 1);
+  } // extent
+
+  /// Return the distance between the ids of neighbors along an axis.
+  size_t
+  stride(
+    size_t orientation,
+    size_t axis
+  )
+  const
+  {
+    size_t s = 1;
+
+    for(size_t i = 0; i < axis; ++i) {
+      s *= extent(orientation, i);
+    } // for
+
+    return s;
+  } // stride
+
+  /// Return the number of entities of an orientation.
+  size_t
+  size(
+    size_t orientation
+  )
+  const
+  {
+    size_t s = 1;
+
+    for(size_t i = 0; i < D; ++i) {
+      s *= extent(orientation, i);
+    } // for
+
+    return s;
+  } // size
+
+  /// Return the id of the first entity of an orientation.
+  size_t
+  offset(
+    size_t orientation
+  )
+  const
+  {
+    return offsets_[orientation];
+  } // offset
+
+  /// Return the number of entities of a topological dimension.
+  size_t
+  count(
+    size_t dim
+  )
+  const
+  {
+    return counts_[dim];
+  } // count
+
+  ///
+  // Return the id of the entity of an orientation at a position.
+  ///
+  size_t
+  id(
+    size_t orientation,
+    const coord_t & position
+  )
+  const
+  {
+    size_t linear = 0;
+
+    for(size_t i = D; i-- > 0;) {
+      linear = linear * extent(orientation, i) + position[i];
+    } // for
+
+    return offsets_[orientation] + linear;
+  } // id
+
+  ///
+  // Return the orientation and the position of an entity.
+  ///
+  size_t
+  decode(
+    size_t dim,
+    size_t id,
+    coord_t & position
+  )
+  const
+  {
+    size_t orientation = 0;
+
+    for(size_t m = 0; m < num_orientations; ++m) {
+      if(dimension(m) == dim && id >= offsets_[m] &&
+        id < offsets_[m] + size(m)) {
+        orientation = m;
+        break;
+      } // if
+    } // for
+
+    size_t linear = id - offsets_[orientation];
+
+    for(size_t i = 0; i < D; ++i) {
+      const size_t e = extent(orientation, i);
+      position[i] = linear % e;
+      linear /= e;
+    } // for
+
+    return orientation;
+  } // decode
+
+private:
+
+  coord_t cells_;
+  std::array<size_t, D + 1> counts_;
+  std::array<size_t, num_orientations> offsets_;
+
+}; // class structured_layout__
+
 ///
 // \class structured_mesh_topology_t structured_mesh_topology.h
-// \brief structured_mesh_topology_t provides...
+// \brief structured_mesh_topology_t provides an implicit topology for
+//        logically rectangular meshes in one to three dimensions.
+//
+// The topology only stores the box of cells that it covers. Entity counts,
+// ids and connectivity are computed from the box, see structured_layout__
+// for the numbering. Entities of topological dimension d are registered in
+// index space d, so that fields can be registered on a structured mesh
+// type like on any other data client, e.g.,
+//
+//   flecsi_register_field(mesh_t, hydro, density, double, dense, 1, 2);
+//
+// registers a cell field of a two-dimensional mesh. The coloring of each
+// index space is computed by block decomposition with color_block.
 ///
 template<
   typename MT
 >
-class structured_mesh_topology_t
+class structured_mesh_topology_t : public data::data_client_t
 {
 public:
 
+  static constexpr size_t num_dimensions = MT::num_dimensions;
+
+  static_assert(num_dimensions >= 1 && num_dimensions <= 3,
+    "structured meshes must have one to three dimensions");
+
+  using box_t = structured_box__<num_dimensions>;
+  using layout_t = structured_layout__<num_dimensions>;
+  using coord_t = typename layout_t::coord_t;
+
+  // This type definition is needed so that data client handles can be
+  // specialized for structured topologies.
+  using type_identifier_t = structured_mesh_topology_t;
+
+  // Maximum number of entities adjacent to an entity, e.g., the twelve
+  // edges of a hexahedron.
+  static constexpr size_t max_adjacencies =
+    num_dimensions == 3 ? 12 : (num_dimensions == 2 ? 4 : 2);
+
+  ///
+  // \class id_range_t
+  // \brief A contiguous range of entity ids. Loops over the range compile
+  //        to plain counted loops.
+  ///
+  class id_range_t
+  {
+  public:
+
+    class iterator_t
+    {
+    public:
+
+      iterator_t(size_t id) : id_(id) {}
+
+      size_t operator * () const { return id_; }
+      iterator_t & operator ++ () { ++id_; return *this; }
+
+      bool
+      operator != (
+        const iterator_t & itr
+      )
+      const
+      {
+        return id_ != itr.id_;
+      } // operator !=
+
+    private:
+
+      size_t id_;
+
+    }; // class iterator_t
+
+    id_range_t(size_t begin, size_t end) : begin_(begin), end_(end) {}
+
+    iterator_t begin() const { return begin_; }
+    iterator_t end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+
+  private:
+
+    size_t begin_;
+    size_t end_;
+
+  }; // class id_range_t
+
+  ///
+  // \class id_list_t
+  // \brief A short list of adjacent entity ids with fixed capacity.
+  ///
+  class id_list_t
+  {
+  public:
+
+    void
+    push_back(
+      size_t id
+    )
+    {
+      assert(size_ < max_adjacencies && "too many adjacencies");
+      ids_[size_++] = id;
+    } // push_back
+
+    const size_t * begin() const { return ids_; }
+    const size_t * end() const { return ids_ + size_; }
+    size_t size() const { return size_; }
+    size_t operator [] (size_t i) const { return ids_[i]; }
+
+  private:
+
+    size_t ids_[max_adjacencies];
+    size_t size_ = 0;
+
+  }; // class id_list_t
+
   /// Default constructor
   structured_mesh_topology_t() {}
 
-  /// Copy constructor (disabled)
-  structured_mesh_topology_t(const structured_mesh_topology_t &) = delete;
+  /// Construct a topology over a box of cells
+  structured_mesh_topology_t(
+    const box_t & box
+  )
+  {
+    initialize(box);
+  } // structured_mesh_topology_t
+
+  /// Copy constructor, e.g., for data client handles
+  structured_mesh_topology_t(const structured_mesh_topology_t & m)
+    : data::data_client_t(), box_(m.box_), layout_(m.layout_),
+    global_layout_(m.global_layout_) {}
 
   /// Assignment operator (disabled)
   structured_mesh_topology_t & operator = (const structured_mesh_topology_t &)
     = delete;
 
+  /// Allow move operations
+  structured_mesh_topology_t(structured_mesh_topology_t &&) = default;
+
   /// Destructor
    ~structured_mesh_topology_t() {}
 
+  ///
+  // Set the box of cells covered by the topology.
+  ///
+  void
+  initialize(
+    const box_t & box
+  )
+  {
+    box_ = box;
+    layout_.init(box.extents);
+    global_layout_.init(box.global_extents);
+  } // initialize
+
+  /// Return the box of cells covered by the topology.
+  const box_t &
+  box()
+  const
+  {
+    return box_;
+  } // box
+
+  /// Return the numbering of the entities of the box.
+  const layout_t &
+  layout()
+  const
+  {
+    return layout_;
+  } // layout
+
+  ///
+  // The box of cells of the local color. Like the index spaces of a data
+  // client type, it is shared by all instances of the type. It is set
+  // during specialization initialization, typically from color_block, and
+  // data client handles of the type are initialized from it.
+  ///
+  static
+  const box_t &
+  local_box()
+  {
+    return local_box_();
+  } // local_box
+
+  static
+  void
+  set_local_box(
+    const box_t & box
+  )
+  {
+    local_box_() = box;
+  } // set_local_box
+
   size_t
   num_entities(
     size_t dim,
     size_t domain = 0
   )
+  const
   {
-    return MT::num_entities(dim, domain);
+    assert(domain == 0 && "structured meshes have a single domain");
+    return layout_.count(dim);
   } // num_entities
 
+  ///
+  // Return the ids of the entities of a topological dimension.
+  ///
+  id_range_t
+  entities(
+    size_t dim
+  )
+  const
+  {
+    return { 0, layout_.count(dim) };
+  } // entities
+
+  ///
+  // Return the ids of the entities of one orientation. Neighbors along
+  // axis i are stride(orientation, i) apart, with unit stride along x, so
+  // that loops over the range can be vectorized.
+  ///
+  id_range_t
+  entities_of_orientation(
+    size_t orientation
+  )
+  const
+  {
+    const size_t offset = layout_.offset(orientation);
+    return { offset, offset + layout_.size(orientation) };
+  } // entities_of_orientation
+
+  /// Return the number of entities of an orientation along an axis.
+  size_t
+  extent(
+    size_t orientation,
+    size_t axis
+  )
+  const
+  {
+    return layout_.extent(orientation, axis);
+  } // extent
+
+  /// Return the distance between the ids of neighbors along an axis.
+  size_t
+  stride(
+    size_t orientation,
+    size_t axis
+  )
+  const
+  {
+    return layout_.stride(orientation, axis);
+  } // stride
+
+  ///
+  // Return the entities of dimension to_dim that are adjacent to an entity
+  // of dimension from_dim. Downward adjacencies, e.g., the vertices of a
+  // cell, are complete and ordered by orientation and then with x fastest.
+  // Upward adjacencies, e.g., the cells of a vertex, only include the
+  // entities inside the box.
+  ///
+  id_list_t
+  entities(
+    size_t from_dim,
+    size_t id,
+    size_t to_dim
+  )
+  const
+  {
+    assert(from_dim != to_dim && "adjacencies of the same dimension");
+
+    coord_t position;
+    const size_t orientation = layout_.decode(from_dim, id, position);
+
+    id_list_t list;
+
+    for(size_t m = 0; m < layout_t::num_orientations; ++m) {
+      if(layout_t::dimension(m) != to_dim) {
+        continue;
+      } // if
+
+      if(to_dim < from_dim) {
+        if((m & orientation) == m) {
+          add_neighbors(list, m, orientation & ~m, position, false);
+        } // if
+      }
+      else if((m & orientation) == orientation) {
+        add_neighbors(list, m, m & ~orientation, position, true);
+      } // if
+    } // for
+
+    return list;
+  } // entities
+
+  ///
+  // Return the global id of a local entity.
+  ///
+  size_t
+  global_id(
+    size_t dim,
+    size_t id
+  )
+  const
+  {
+    coord_t position;
+    const size_t orientation = layout_.decode(dim, id, position);
+
+    for(size_t i = 0; i < num_dimensions; ++i) {
+      position[i] += box_.lower[i];
+    } // for
+
+    return global_layout_.id(orientation, position);
+  } // global_id
+
+  ///
+  // Compute the coloring of the entities of one topological dimension by
+  // block decomposition of the cells.
+  //
+  // \param dim The topological dimension.
+  // \param global_extents The number of cells of the mesh along each axis.
+  // \param grid The number of blocks along each axis. Colors are numbered
+  //        with x fastest.
+  // \param color The calling color.
+  // \param depth The number of ghost cell layers.
+  // \param coloring The index coloring to populate. Ids are global ids and
+  //        ghost offsets refer to the primary coloring of their owner.
+  // \param coloring_info The coloring information to populate.
+  //
+  // \return The box of cells of the calling color, including ghosts.
+  //
+  // An entity belongs to the block of the cell with the same position,
+  // or of the last cell for positions past the last cell.
+  ///
+  static
+  box_t
+  color_block(
+    size_t dim,
+    const coord_t & global_extents,
+    const coord_t & grid,
+    size_t color,
+    size_t depth,
+    coloring::index_coloring_t & coloring,
+    coloring::coloring_info_t & coloring_info
+  )
+  {
+    const layout_t global_layout(global_extents);
+
+    coord_t block;
+    for(size_t i = 0, c = color; i < num_dimensions; ++i) {
+      block[i] = c % grid[i];
+      c /= grid[i];
+    } // for
+
+    // Entity ranges of the calling color along each axis, for entities
+    // that do not (0) and do (1) extend along it.
+    std::array<std::array<size_t, 2>, num_dimensions> lower, upper;
+
+    box_t box;
+    box.global_extents = global_extents;
+
+    for(size_t i = 0; i < num_dimensions; ++i) {
+      const size_t lo = block_begin(global_extents[i], grid[i], block[i]);
+      const size_t hi = block_begin(global_extents[i], grid[i], block[i] + 1);
+      box.lower[i] = lo - std::min(lo, depth);
+      box.extents[i] = std::min(hi + depth, global_extents[i]) - box.lower[i];
+
+      for(size_t e = 0; e < 2; ++e) {
+        lower[i][e] = box.lower[i];
+        upper[i][e] = box.lower[i] + box.extents[i] + 1 - e;
+      } // for
+    } // for
+
+    std::vector<coloring::entity_info_t> exclusive;
+    std::vector<coloring::entity_info_t> shared;
+    std::vector<coloring::entity_info_t> ghost;
+    std::vector<size_t> shared_users;
+    std::vector<size_t> ghost_owners;
+
+    coloring.primary.clear();
+
+    size_t offset = 0;
+
+    for(size_t m = 0; m < layout_t::num_orientations; ++m) {
+      if(layout_t::dimension(m) != dim) {
+        continue;
+      } // if
+
+      coord_t position(box.lower);
+
+      // Visit the entities of the box in increasing id order.
+      for(bool done = false; !done;) {
+        const size_t id = global_layout.id(m, position);
+
+        coord_t owner;
+        for(size_t i = 0; i < num_dimensions; ++i) {
+          owner[i] = block_of(global_extents[i], grid[i],
+            std::min(position[i], global_extents[i] - 1));
+        } // for
+
+        if(owner == block) {
+          coloring.primary.insert(coloring.primary.end(), id);
+
+          std::vector<size_t> users;
+          add_users(users, global_extents, grid, depth, m, position, block,
+            0, 0, 1);
+
+          if(users.size()) {
+            shared.emplace_back(id, color, offset,
+              utils::flat_set__<size_t>(users.begin(), users.end()));
+            shared_users.insert(shared_users.end(), users.begin(),
+              users.end());
+          }
+          else {
+            exclusive.emplace_back(id, color, offset);
+          } // if
+
+          ++offset;
+        }
+        else {
+          const size_t owner_color = color_of(grid, owner);
+          ghost.emplace_back(id, owner_color,
+            owned_offset(global_extents, grid, dim, m, owner, position));
+          ghost_owners.push_back(owner_color);
+        } // if
+
+        done = true;
+        for(size_t i = 0; i < num_dimensions; ++i) {
+          const size_t e = (m >> i) & 1;
+          if(++position[i] < upper[i][e]) {
+            done = false;
+            break;
+          } // if
+          position[i] = lower[i][e];
+        } // for
+      } // for
+    } // for
+
+    coloring.exclusive =
+      coloring::index_coloring_t::entity_set_t(std::move(exclusive));
+    coloring.shared =
+      coloring::index_coloring_t::entity_set_t(std::move(shared));
+    coloring.ghost =
+      coloring::index_coloring_t::entity_set_t(std::move(ghost));
+
+    coloring_info.exclusive = coloring.exclusive.size();
+    coloring_info.shared = coloring.shared.size();
+    coloring_info.ghost = coloring.ghost.size();
+    coloring_info.shared_users =
+      utils::flat_set__<size_t>(std::move(shared_users));
+    coloring_info.ghost_owners =
+      utils::flat_set__<size_t>(std::move(ghost_owners));
+
+    return box;
+  } // color_block
+
+  ///
+  // Return a grid of blocks for a number of colors that keeps the blocks
+  // close to cubes.
+  ///
+  static
+  coord_t
+  block_grid(
+    const coord_t & global_extents,
+    size_t colors
+  )
+  {
+    std::vector<size_t> factors;
+    for(size_t f = 2; f * f <= colors; ++f) {
+      for(; colors % f == 0; colors /= f) {
+        factors.push_back(f);
+      } // for
+    } // for
+
+    if(colors > 1) {
+      factors.push_back(colors);
+    } // if
+
+    coord_t grid;
+    grid.fill(1);
+
+    // Assign the largest factors first to the axis with the most cells
+    // per block.
+    for(size_t f = factors.size(); f-- > 0;) {
+      size_t axis = 0;
+      for(size_t i = 1; i < num_dimensions; ++i) {
+        if(global_extents[i] * grid[axis] > global_extents[axis] * grid[i]) {
+          axis = i;
+        } // if
+      } // for
+
+      grid[axis] *= factors[f];
+    } // for
+
+    return grid;
+  } // block_grid
+
 private:
 
+  static
+  box_t &
+  local_box_()
+  {
+    static box_t box;
+    return box;
+  } // local_box_
+
+  ///
+  // Add the entities of an orientation at the position, moved along the
+  // given axes by zero or one in every combination: forward for downward
+  // and backward for upward adjacencies.
+  ///
+  void
+  add_neighbors(
+    id_list_t & list,
+    size_t orientation,
+    size_t axes,
+    const coord_t & position,
+    bool upward
+  )
+  const
+  {
+    for(size_t c = 0; c < layout_t::num_orientations; ++c) {
+      if((c & axes) != c) {
+        continue;
+      } // if
+
+      coord_t p(position);
+      bool inside = true;
+
+      for(size_t i = 0; i < num_dimensions; ++i) {
+        if(!((c >> i) & 1)) {
+          continue;
+        } // if
+
+        if(upward) {
+          inside = inside && p[i] > 0;
+          --p[i];
+        }
+        else {
+          ++p[i];
+        } // if
+      } // for
+
+      // Upward neighbors extend along the added axes and must start
+      // before the last vertex.
+      for(size_t i = 0; upward && i < num_dimensions; ++i) {
+        inside = inside && p[i] < layout_.extent(orientation, i);
+      } // for
+
+      if(inside) {
+        list.push_back(layout_.id(orientation, p));
+      } // if
+    } // for
+  } // add_neighbors
+
+  /// Return the first cell of a block.
+  static
+  size_t
+  block_begin(
+    size_t cells,
+    size_t blocks,
+    size_t block
+  )
+  {
+    return cells * block / blocks;
+  } // block_begin
+
+  /// Return the block of a cell.
+  static
+  size_t
+  block_of(
+    size_t cells,
+    size_t blocks,
+    size_t cell
+  )
+  {
+    return (blocks * (cell + 1) - 1) / cells;
+  } // block_of
+
+  static
+  size_t
+  color_of(
+    const coord_t & grid,
+    const coord_t & block
+  )
+  {
+    size_t color = 0;
+
+    for(size_t i = num_dimensions; i-- > 0;) {
+      color = color * grid[i] + block[i];
+    } // for
+
+    return color;
+  } // color_of
+
+  ///
+  // Return the range of entities of an orientation along an axis that a
+  // block owns.
+  ///
+  static
+  std::array<size_t, 2>
+  owned_range(
+    size_t cells,
+    size_t blocks,
+    size_t block,
+    bool extended
+  )
+  {
+    const size_t hi = block_begin(cells, blocks, block + 1);
+    return { block_begin(cells, blocks, block),
+      hi + (!extended && hi == cells ? 1 : 0) };
+  } // owned_range
+
+  ///
+  // Return the offset of an entity in the primary coloring of its owner.
+  ///
+  static
+  size_t
+  owned_offset(
+    const coord_t & global_extents,
+    const coord_t & grid,
+    size_t dim,
+    size_t orientation,
+    const coord_t & block,
+    const coord_t & position
+  )
+  {
+    size_t offset = 0;
+
+    for(size_t m = 0; m < orientation; ++m) {
+      if(layout_t::dimension(m) != dim) {
+        continue;
+      } // if
+
+      size_t size = 1;
+      for(size_t i = 0; i < num_dimensions; ++i) {
+        auto r = owned_range(global_extents[i], grid[i], block[i],
+          (m >> i) & 1);
+        size *= r[1] - r[0];
+      } // for
+
+      offset += size;
+    } // for
+
+    size_t linear = 0;
+    for(size_t i = num_dimensions; i-- > 0;) {
+      auto r = owned_range(global_extents[i], grid[i], block[i],
+        (orientation >> i) & 1);
+      linear = linear * (r[1] - r[0]) + position[i] - r[0];
+    } // for
+
+    return offset + linear;
+  } // owned_offset
+
+  ///
+  // Collect the colors other than the owner whose boxes, including
+  // ghosts, contain an entity. Along each axis, these are the blocks
+  // around the owner whose ghosted range contains the position.
+  ///
+  static
+  void
+  add_users(
+    std::vector<size_t> & users,
+    const coord_t & global_extents,
+    const coord_t & grid,
+    size_t depth,
+    size_t orientation,
+    const coord_t & position,
+    const coord_t & owner,
+    size_t axis,
+    size_t color,
+    size_t stride
+  )
+  {
+    if(axis == num_dimensions) {
+      const size_t owner_color = color_of(grid, owner);
+
+      if(color != owner_color) {
+        users.push_back(color);
+      } // if
+
+      return;
+    } // if
+
+    const size_t cells = global_extents[axis];
+    const size_t blocks = grid[axis];
+    const size_t extended = (orientation >> axis) & 1;
+
+    auto contains = [&](size_t b) {
+      const size_t lo = block_begin(cells, blocks, b);
+      const size_t hi = block_begin(cells, blocks, b + 1);
+      const size_t glo = lo - std::min(lo, depth);
+      const size_t ghi = std::min(hi + depth, cells) + 1 - extended;
+      return position[axis] >= glo && position[axis] < ghi;
+    };
+
+    size_t first = owner[axis];
+    while(first > 0 && contains(first - 1)) {
+      --first;
+    } // while
+
+    for(size_t b = first; b < blocks && contains(b); ++b) {
+      add_users(users, global_extents, grid, depth, orientation, position,
+        owner, axis + 1, color + b * stride, stride * blocks);
+    } // for
+  } // add_users
+
+  box_t box_;
+  layout_t layout_;
+  layout_t global_layout_;
+
 }; // class structured_mesh_topology_t
 
+///
+// Detect structured topologies, e.g., from the type_identifier_t of a
+// data client, so that data client handles can be dispatched on it.
+///
+template<
+  typename T
+>
+struct is_structured_mesh_topology__ : std::false_type {};
+
+template<
+  typename MT
+>
+struct is_structured_mesh_topology__<structured_mesh_topology_t<MT>>
+  : std::true_type {};
+
 } // namespace topology
 } // namespace flecsi
 
@@ -183,6 +183,55 @@ TEST(closure, vertex_closure) {
 
 } // TEST
 
+// This test checks that the compressed cell-to-vertex connectivity of a
+// 4x4 mesh matches the cell definitions.
+TEST(closure, entities_crs) {
+
+  flecsi::topology::test_definition_t td;
+
+  auto & crs = td.entities_crs(2, 0);
+
+  CINCH_ASSERT(EQ, td.num_entities(2), crs.size());
+
+  for(size_t c(0); c<td.num_entities(2); ++c) {
+    auto ids = td.entities_ref(2, 0, c);
+    std::vector<size_t> row(ids.begin(), ids.end());
+    CINCH_ASSERT(EQ, td.entities(2, 0, c), row);
+    CINCH_ASSERT(EQ, crs.begin(c), ids.begin());
+  } // for
+
+} // TEST
+
+// This test checks that the inverse vertex-to-cell index of a 4x4 mesh
+// matches the cell definitions.
+TEST(closure, inverse_index) {
+
+  flecsi::topology::test_definition_t td;
+
+  auto & index = td.inverse_index(2, 0);
+
+  CINCH_ASSERT(EQ, td.num_entities(0), index.size());
+
+  // The index is only built once.
+  CINCH_ASSERT(EQ, &index, &td.inverse_index(2, 0));
+
+  for(size_t v(0); v<td.num_entities(0); ++v) {
+    std::vector<size_t> compare;
+
+    for(size_t c(0); c<td.num_entities(2); ++c) {
+      auto vertices = td.entities(2, 0, c);
+
+      if(std::find(vertices.begin(), vertices.end(), v) != vertices.end()) {
+        compare.push_back(c);
+      } // if
+    } // for
+
+    std::vector<size_t> row(index.begin(v), index.end(v));
+    CINCH_ASSERT(EQ, compare, row);
+  } // for
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
@@ -0,0 +1,87 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <cinchtest.h>
+
+#include <set>
+#include <vector>
+
+#include "flecsi/topology/serial/entity_arena.h"
+
+using namespace flecsi::topology;
+
+// Counts live instances so that the test can check that the arena
+// destroys every entity it made.
+struct counted_t {
+
+  counted_t(size_t id) : id(id) { ++live; }
+  ~counted_t() { --live; }
+
+  size_t id;
+  double padding[3];
+
+  static size_t live;
+}; // struct counted_t
+
+size_t counted_t::live = 0;
+
+TEST(entity_arena, blocks) {
+  // Fill the first block exactly, then cross two more block boundaries.
+  constexpr size_t n = 4 * entity_arena_t::initial_block_entities + 3;
+
+  entity_arena_t arena;
+  std::vector<counted_t *> ents;
+
+  for(size_t i(0); i < n; ++i) {
+    ents.push_back(arena.make<counted_t>(i));
+  } // for
+
+  ASSERT_EQ(n, counted_t::live);
+
+  // Pointers stay valid and distinct as blocks are added.
+  std::set<counted_t *> unique(ents.begin(), ents.end());
+  ASSERT_EQ(n, unique.size());
+
+  for(size_t i(0); i < n; ++i) {
+    ASSERT_EQ(i, ents[i]->id);
+    ASSERT_TRUE(arena.owns(ents[i]));
+  } // for
+
+  // Entities of one block are contiguous.
+  for(size_t i(1); i < entity_arena_t::initial_block_entities; ++i) {
+    ASSERT_EQ(ents[i-1] + 1, ents[i]);
+  } // for
+
+  counted_t outside(0);
+  ASSERT_FALSE(arena.owns(&outside));
+} // TEST
+
+TEST(entity_arena, destruction) {
+  counted_t::live = 0;
+
+  {
+  entity_arena_t arena;
+
+  for(size_t i(0); i < entity_arena_t::initial_block_entities + 1; ++i) {
+    arena.make<counted_t>(i);
+  } // for
+
+  ASSERT_EQ(entity_arena_t::initial_block_entities + 1, counted_t::live);
+  } // scope
+
+  ASSERT_EQ(0, counted_t::live);
+
+  // An empty arena has nothing to destroy.
+  {
+  entity_arena_t arena;
+  } // scope
+
+  ASSERT_EQ(0, counted_t::live);
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
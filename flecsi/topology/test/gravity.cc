@@ -15,7 +15,7 @@ struct Aggregate{
   }
 
   double mass;
-  point<double, 2> center;
+  point__<double, 2> center;
 };
 
 class tree_policy{
@@ -28,7 +28,7 @@ public:
 
   using element_t = double;
 
-  using point_t = point<element_t, dimension>;
+  using point_t = point__<element_t, dimension>;
 
   class body : public topology::tree_entity<branch_int_t, dimension>{
   public:
@@ -120,7 +120,7 @@ public:
     }
 
     point_t
-    coordinates(const std::array<point<element_t, dimension>, 2>& range) const{
+    coordinates(const std::array<point__<element_t, dimension>, 2>& range) const{
       point_t p;
       branch_id_t bid = id();
       bid.coordinates(range, p);
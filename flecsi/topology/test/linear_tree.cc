@@ -0,0 +1,289 @@
+#include <cinchtest.h>
+#include <iostream>
+#include <cmath>
+
+#include "flecsi/topology/tree_topology.h"
+#include "pseudo_random.h"
+
+
+using namespace std;
+using namespace flecsi;
+
+class tree_policy{
+public:
+  using storage = topology::linear_tree_storage;
+
+  using tree_t = topology::tree_topology<tree_policy>;
+
+  using branch_int_t = uint64_t;
+
+  static const size_t dimension = 2;
+
+  static const size_t max_leaf_entities = 8;
+
+  using element_t = double;
+
+  using point_t = point__<element_t, dimension>;
+
+  class entity : public topology::tree_entity<branch_int_t, dimension>{
+  public:
+    entity(const point_t& p)
+    : coordinates_(p){}
+
+    const point_t& coordinates() const{
+      return coordinates_;
+    }
+
+    void move(const point_t& offset){
+      coordinates_ += offset;
+    }
+
+    private:
+      point_t coordinates_;
+  };
+
+  using entity_t = entity;
+
+  using branch_t = topology::linear_tree_branch<branch_int_t, dimension>;
+};
+
+using tree_topology_t = topology::tree_topology<tree_policy>;
+using entity_t = tree_topology_t::entity;
+using point_t = tree_topology_t::point_t;
+using branch_t = tree_topology_t::branch_t;
+using branch_id_t = tree_topology_t::branch_id_t;
+using element_t = tree_topology_t::element_t;
+
+TEST(linear_tree_topology, branches) {
+  tree_topology_t t;
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+
+  size_t n = 100000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(), rng.uniform()};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+  }
+
+  for(size_t i = 0; i < 10000; ++i){
+    t.remove(ents[i]);
+  }
+
+  size_t count = 0;
+
+  auto f = [&](branch_t* b, size_t depth) -> bool{
+    assert(depth == b->id().depth());
+    assert(t.get(b->id()) == b);
+
+    if(b->is_leaf()){
+      assert(b->size() <= tree_policy::max_leaf_entities);
+
+      for(auto ent : t.entities(b)){
+        assert(ent->get_branch_id() == b->id());
+        ++count;
+      }
+    }
+
+    return false;
+  };
+
+  t.visit(t.root(), f);
+
+  ASSERT_TRUE(count == n - 10000);
+  ASSERT_TRUE(t.root()->size() == n - 10000);
+}
+
+TEST(linear_tree_topology, neighbors) {
+  tree_topology_t t;
+  thread_pool pool;
+  pool.start(8);
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+
+  size_t n = 1000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0, 1), rng.uniform(0, 1)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+  }
+
+  for(size_t i = 0; i < n; ++i){
+    auto ent = ents[i];
+
+    auto ns = t.find_in_radius(ent->coordinates(), 0.05);
+    auto pns = t.find_in_radius(pool, ent->coordinates(), 0.05);
+
+    set<entity_t*> s1;
+    for(auto e : ns){
+      s1.insert(e);
+    }
+
+    set<entity_t*> s2;
+    for(auto e : pns){
+      s2.insert(e);
+    }
+
+    set<entity_t*> s3;
+
+    for(size_t j = 0; j < n; ++j){
+      auto ej = ents[j];
+
+      if(distance(ent->coordinates(), ej->coordinates()) <= 0.05){
+        s3.insert(ej);
+      }
+    }
+
+    ASSERT_TRUE(s1 == s3);
+    ASSERT_TRUE(s2 == s3);
+
+    set<entity_t*> s4;
+    t.apply_in_radius(pool, ent->coordinates(), 0.05,
+      [&](entity_t* e){
+        static std::mutex mtx;
+        std::lock_guard<std::mutex> lock(mtx);
+        s4.insert(e);
+      });
+
+    ASSERT_TRUE(s4 == s3);
+  }
+}
+
+TEST(linear_tree_topology, neighbors_rectangular) {
+  tree_topology_t t({0, 0}, {50, 30});
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+  std::vector<point_t> centers;
+  std::vector<element_t> radii;
+
+  size_t n = 1000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0, 50), rng.uniform(0, 30)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+    centers.push_back(p);
+    radii.push_back(rng.uniform(1.0, 5.0));
+  }
+
+  auto nl = t.find_in_radius(centers, radii);
+
+  ASSERT_TRUE(nl.size() == n);
+
+  for(size_t i = 0; i < n; ++i){
+    set<entity_t*> s1(nl.entities.begin() + nl.offsets[i],
+                      nl.entities.begin() + nl.offsets[i + 1]);
+
+    set<entity_t*> s2;
+
+    for(size_t j = 0; j < n; ++j){
+      auto ej = ents[j];
+
+      if(distance(centers[i], ej->coordinates()) <= radii[i]){
+        s2.insert(ej);
+      }
+    }
+
+    ASSERT_TRUE(s1 == s2);
+  }
+}
+
+TEST(linear_tree_topology, neighbors_box) {
+  tree_topology_t t;
+  thread_pool pool;
+  pool.start(8);
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+
+  size_t n = 1000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0, 1), rng.uniform(0, 1)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+  }
+
+  for(element_t x = 0; x < 1.0; x += 0.1){
+    for(element_t y = 0; y < 1.0; y += 0.1){
+      point_t min = {x, y};
+      point_t max = {x + 0.1, y + 0.1};
+
+      auto ns = t.find_in_box(min, max);
+      set<entity_t*> s1;
+      for(auto e : ns){
+        s1.insert(e);
+      }
+
+      auto pns = t.find_in_box(pool, min, max);
+      set<entity_t*> s2;
+      for(auto e : pns){
+        s2.insert(e);
+      }
+
+      set<entity_t*> s3;
+
+      for(size_t j = 0; j < n; ++j){
+        auto ej = ents[j];
+
+        point_t p = ej->coordinates();
+
+        if(p[0] <= max[0] && p[0] >= min[0] &&
+           p[1] <= max[1] && p[1] >= min[1]){
+          s3.insert(ej);
+        }
+      }
+
+      ASSERT_TRUE(s1 == s3);
+      ASSERT_TRUE(s2 == s3);
+    }
+  }
+}
+
+TEST(linear_tree_topology, update_all) {
+  tree_topology_t t;
+  thread_pool pool;
+  pool.start(8);
+
+  pseudo_random rng;
+
+  size_t n = 10000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0.1, 0.9), rng.uniform(0.1, 0.9)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+  }
+
+  for(size_t i = 0; i < t.entities().size(); ++i){
+    auto ent = t.entities()[i];
+    point_t dp = {rng.uniform(-0.05, 0.05), rng.uniform(-0.05, 0.05)};
+    ent->move(dp);
+  }
+
+  t.update_all();
+
+  std::atomic<size_t> count(0);
+
+  t.visit_children(pool, t.root(),
+    [&](entity_t* ent){
+      assert(ent->get_branch_id() ==
+        t.get(ent->get_branch_id())->id());
+      ++count;
+    });
+
+  ASSERT_TRUE(count == n);
+}
@@ -5,33 +5,179 @@
 
 #include <cinchtest.h>
 
-template<size_t> struct domain_ {};
-template<size_t D, size_t NM>
-struct structured_mesh_entity_t {};
+#include <algorithm>
+#include <vector>
 
-struct structured_vertex_t : public structured_mesh_entity_t<0,2> {
-}; // structured_vertex_t
+#include "flecsi/topology/structured_mesh_topology.h"
 
-struct structured_cell_t : public structured_mesh_entity_t<2,2> {
-}; // structured_cell_t
+using namespace flecsi;
+using namespace flecsi::topology;
 
-struct structured_corner_t : public structured_mesh_entity_t<1,2> {
-}; // structured_corner_t
-
-struct structured_mesh_type_t {
+struct structured_mesh_2d_t {
   static constexpr size_t num_dimensions = 2;
-  static constexpr size_t num_domains = 2;
+}; // struct structured_mesh_2d_t
+
+struct structured_mesh_3d_t {
+  static constexpr size_t num_dimensions = 3;
+}; // struct structured_mesh_3d_t
+
+using mesh_2d_t = structured_mesh_topology_t<structured_mesh_2d_t>;
+using mesh_3d_t = structured_mesh_topology_t<structured_mesh_3d_t>;
+
+template<typename MESH>
+typename MESH::box_t
+global_box(
+  const typename MESH::coord_t & extents
+)
+{
+  typename MESH::box_t box;
+  box.extents = extents;
+  box.global_extents = extents;
+  return box;
+} // global_box
+
+// Every downward adjacency must appear as the matching upward adjacency.
+template<typename MESH>
+void
+check_adjacencies(
+  const MESH & mesh
+)
+{
+  for(size_t from = 0; from <= MESH::num_dimensions; ++from) {
+    for(size_t to = 0; to <= MESH::num_dimensions; ++to) {
+      if(from == to) {
+        continue;
+      } // if
+
+      size_t forward = 0;
+      size_t backward = 0;
+
+      for(auto e: mesh.entities(from)) {
+        for(auto a: mesh.entities(from, e, to)) {
+          ASSERT_LT(a, mesh.num_entities(to));
+          auto r = mesh.entities(to, a, from);
+          ASSERT_TRUE(std::find(r.begin(), r.end(), e) != r.end());
+          ++forward;
+        } // for
+      } // for
+
+      for(auto e: mesh.entities(to)) {
+        backward += mesh.entities(to, e, from).size();
+      } // for
+
+      ASSERT_EQ(forward, backward);
+    } // for
+  } // for
+} // check_adjacencies
+
+TEST(structured, counts) {
+  mesh_2d_t m2(global_box<mesh_2d_t>({{3, 2}}));
+
+  ASSERT_EQ(12, m2.num_entities(0));
+  ASSERT_EQ(17, m2.num_entities(1));
+  ASSERT_EQ(6, m2.num_entities(2));
+
+  mesh_3d_t m3(global_box<mesh_3d_t>({{2, 3, 4}}));
+
+  ASSERT_EQ(60, m3.num_entities(0));
+  ASSERT_EQ(133, m3.num_entities(1));
+  ASSERT_EQ(98, m3.num_entities(2));
+  ASSERT_EQ(24, m3.num_entities(3));
+
+  // y-edges of the 2D mesh follow the x-edges, with unit stride along x.
+  auto y_edges = m2.entities_of_orientation(2);
+  ASSERT_EQ(9, *y_edges.begin());
+  ASSERT_EQ(8, y_edges.size());
+  ASSERT_EQ(1, m2.stride(2, 0));
+  ASSERT_EQ(4, m2.stride(2, 1));
+} // TEST
+
+TEST(structured, connectivity) {
+  mesh_2d_t m2(global_box<mesh_2d_t>({{3, 2}}));
+
+  // The vertices of the last cell.
+  auto v = m2.entities(2, 5, 0);
+  ASSERT_EQ(4, v.size());
+  ASSERT_EQ(6, v[0]);
+  ASSERT_EQ(7, v[1]);
+  ASSERT_EQ(10, v[2]);
+  ASSERT_EQ(11, v[3]);
+
+  // The two x-edges and then the two y-edges of the first cell.
+  auto e = m2.entities(2, 0, 1);
+  ASSERT_EQ(4, e.size());
+  ASSERT_EQ(0, e[0]);
+  ASSERT_EQ(3, e[1]);
+  ASSERT_EQ(9, e[2]);
+  ASSERT_EQ(10, e[3]);
+
+  // A corner vertex has a single cell, an interior one four.
+  ASSERT_EQ(1, m2.entities(0, 0, 2).size());
+  ASSERT_EQ(4, m2.entities(0, 5, 2).size());
+
+  check_adjacencies(m2);
+
+  mesh_3d_t m3(global_box<mesh_3d_t>({{2, 3, 4}}));
+
+  ASSERT_EQ(8, m3.entities(3, 0, 0).size());
+  ASSERT_EQ(12, m3.entities(3, 0, 1).size());
+  ASSERT_EQ(6, m3.entities(3, 0, 2).size());
+
+  check_adjacencies(m3);
+} // TEST
+
+TEST(structured, coloring) {
+  const mesh_2d_t::coord_t extents = {{5, 4}};
+  const auto grid = mesh_2d_t::block_grid(extents, 4);
+  const size_t colors = 4;
+
+  ASSERT_EQ(2, grid[0]);
+  ASSERT_EQ(2, grid[1]);
+
+  for(size_t dim = 0; dim <= 2; ++dim) {
+    std::vector<coloring::index_coloring_t> c(colors);
+    std::vector<coloring::coloring_info_t> ci(colors);
+    std::vector<mesh_2d_t::box_t> boxes;
+
+    size_t owned = 0;
+    for(size_t color = 0; color < colors; ++color) {
+      boxes.push_back(mesh_2d_t::color_block(dim, extents, grid, color, 1,
+        c[color], ci[color]));
+      owned += c[color].primary.size();
+      ASSERT_EQ(c[color].primary.size(),
+        c[color].exclusive.size() + c[color].shared.size());
+    } // for
+
+    mesh_2d_t global(global_box<mesh_2d_t>(extents));
+    ASSERT_EQ(global.num_entities(dim), owned);
 
+    for(size_t color = 0; color < colors; ++color) {
+      // Every ghost is found at its offset in the primary coloring of its
+      // owner, which shares it with us.
+      for(auto & g: c[color].ghost) {
+        auto & primary = c[g.rank].primary;
+        ASSERT_LT(g.offset, primary.size());
+        ASSERT_EQ(g.id, *std::next(primary.begin(), g.offset));
 
+        auto s = c[g.rank].shared.find(g);
+        ASSERT_TRUE(s != c[g.rank].shared.end());
+        ASSERT_EQ(g.offset, s->offset);
+        ASSERT_EQ(1, s->shared.count(color));
+      } // for
 
-  using entity_types = std::tuple<
-    std::pair<domain_<0>, structured_vertex_t>,
-    std::pair<domain_<0>, structured_cell_t>,
-    std::pair<domain_<1>, structured_corner_t>
-  >;
-}; // struct structured_mesh_type_t
+      // The local topology covers exactly the owned and ghost entities.
+      mesh_2d_t m(boxes[color]);
+      ASSERT_EQ(c[color].primary.size() + c[color].ghost.size(),
+        m.num_entities(dim));
 
-TEST(structured, testname) {
+      for(auto e: m.entities(dim)) {
+        const size_t id = m.global_id(dim, e);
+        ASSERT_TRUE(c[color].primary.count(id) ||
+          c[color].ghost.find(coloring::entity_info_t(id)) !=
+          c[color].ghost.end());
+      } // for
+    } // for
+  } // for
 } // TEST
 
 /*----------------------------------------------------------------------------*
@@ -19,7 +19,7 @@ public:
 
   using element_t = double;
 
-  using point_t = point<element_t, dimension>;
+  using point_t = point__<element_t, dimension>;
 
   class entity : public topology::tree_entity<branch_int_t, dimension>{
   public:
@@ -79,7 +79,7 @@ public:
     }
 
     point_t
-    coordinates(const std::array<point<element_t, dimension>, 2>& range) const{
+    coordinates(const std::array<point__<element_t, dimension>, 2>& range) const{
       point_t p;
       id().coordinates(range, p);
       return p;
@@ -286,7 +286,9 @@ TEST(tree_topology, neighbors) {
     auto ns = t.find_in_radius(ent->coordinates(), 0.05);
 
     set<entity_t*> s1;
-    s1.insert(ns.begin(), ns.end());
+    for(auto e : ns){
+      s1.insert(e);
+    }
 
     set<entity_t*> s2;
 
@@ -326,7 +328,9 @@ TEST(tree_topology, neighbors_thread_pool) {
     auto ns = t.find_in_radius(pool, ent->coordinates(), 0.05);
 
     set<entity_t*> s1;
-    s1.insert(ns.begin(), ns.end());
+    for(auto e : ns){
+      s1.insert(e);
+    }
 
     set<entity_t*> s2;
 
@@ -364,7 +368,9 @@ TEST(tree_topology, neighbors_rectangular) {
     auto ns = t.find_in_radius(ent->coordinates(), 5.0);
 
     set<entity_t*> s1;
-    s1.insert(ns.begin(), ns.end());
+    for(auto e : ns){
+      s1.insert(e);
+    }
 
     set<entity_t*> s2;
 
@@ -403,7 +409,9 @@ TEST(tree_topology, neighbors_box) {
 
       auto ns = t.find_in_box(min, max);
       set<entity_t*> s1;
-      s1.insert(ns.begin(), ns.end());
+      for(auto e : ns){
+        s1.insert(e);
+      }
 
       set<entity_t*> s2;
 
@@ -422,6 +430,53 @@ TEST(tree_topology, neighbors_box) {
   }
 }
 
+TEST(tree_topology, neighbors_batch) {
+  tree_topology_t t;
+  thread_pool pool;
+  pool.start(8);
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+  std::vector<point_t> centers;
+  std::vector<element_t> radii;
+
+  size_t n = 1000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0, 1), rng.uniform(0, 1)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+    centers.push_back(p);
+    radii.push_back(rng.uniform(0.01, 0.1));
+  }
+
+  auto nl = t.find_in_radius(centers, radii);
+  auto pnl = t.find_in_radius(pool, centers, radii);
+
+  ASSERT_TRUE(nl.size() == n);
+  ASSERT_TRUE(nl.offsets == pnl.offsets);
+  ASSERT_TRUE(nl.entities == pnl.entities);
+
+  for(size_t i = 0; i < n; ++i){
+    set<entity_t*> s1(nl.entities.begin() + nl.offsets[i],
+                      nl.entities.begin() + nl.offsets[i + 1]);
+
+    set<entity_t*> s2;
+
+    for(size_t j = 0; j < n; ++j){
+      auto ej = ents[j];
+
+      if(distance(centers[i], ej->coordinates()) <= radii[i]){
+        s2.insert(ej);
+      }
+    }
+
+    ASSERT_TRUE(s1 == s2);
+  }
+}
+
 TEST(tree_topology, iterator_update_all) {
   tree_topology_t t;
 
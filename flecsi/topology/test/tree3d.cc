@@ -18,7 +18,7 @@ public:
 
   using element_t = double;
 
-  using point_t = point<element_t, dimension>;
+  using point_t = point__<element_t, dimension>;
 
   class entity : public tree_entity<branch_int_t, dimension>{
   public:
@@ -78,7 +78,7 @@ public:
     }
 
     point_t
-    coordinates(const std::array<point<element_t, dimension>, 2>& range) const{
+    coordinates(const std::array<point__<element_t, dimension>, 2>& range) const{
       point_t p;
       id().coordinates(range, p);
       return p;
@@ -134,7 +134,9 @@ TEST(tree_topology, neighbors) {
     auto ns = t.find_in_radius(ent->coordinates(), 0.10);
 
     set<entity_t*> s1;
-    s1.insert(ns.begin(), ns.end());
+    for(auto e : ns){
+      s1.insert(e);
+    }
 
     set<entity_t*> s2;
 
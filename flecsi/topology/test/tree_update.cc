@@ -0,0 +1,182 @@
+#include <cinchtest.h>
+#include <iostream>
+#include <cmath>
+
+#include "flecsi/topology/tree_topology.h"
+#include "pseudo_random.h"
+
+
+using namespace std;
+using namespace flecsi;
+
+class tree_policy{
+public:
+  using tree_t = topology::tree_topology<tree_policy>;
+
+  using branch_int_t = uint64_t;
+
+  static const size_t dimension = 2;
+
+  using element_t = double;
+
+  using point_t = point__<element_t, dimension>;
+
+  class entity : public topology::tree_entity<branch_int_t, dimension>{
+  public:
+    entity(const point_t& p)
+    : coordinates_(p){}
+
+    const point_t& coordinates() const{
+      return coordinates_;
+    }
+
+    void move(const point_t& offset){
+      coordinates_ += offset;
+    }
+
+    private:
+      point_t coordinates_;
+  };
+
+  using entity_t = entity;
+
+  class branch : public topology::tree_branch<branch_int_t, dimension>{
+  public:
+    branch(){}
+
+    void insert(entity_t* ent){
+      ents_.push_back(ent);
+
+      if(ents_.size() > 1){
+        refine();
+      }
+    }
+
+    void remove(entity_t* ent){
+      auto itr = std::find(ents_.begin(), ents_.end(), ent);
+      assert(itr != ents_.end());
+      ents_.erase(itr);
+
+      if(ents_.empty()){
+        coarsen();
+      }
+    }
+
+    auto begin(){
+      return ents_.begin();
+    }
+
+    auto end(){
+      return ents_.end();
+    }
+
+    void clear(){
+      ents_.clear();
+    }
+
+    size_t count(){
+      return ents_.size();
+    }
+
+    point_t
+    coordinates(const std::array<point__<element_t, dimension>, 2>& range) const{
+      point_t p;
+      id().coordinates(range, p);
+      return p;
+    }
+
+    size_t size(){
+      return ents_.size();
+    }
+
+  private:
+    std::vector<entity_t*> ents_;
+  };
+
+  bool should_coarsen(branch* parent){
+    return true;
+  }
+
+  using branch_t = branch;
+};
+
+
+
+using tree_topology_t = topology::tree_topology<tree_policy>;
+using entity_t = tree_topology_t::entity;
+using point_t = tree_topology_t::point_t;
+using branch_t = tree_topology_t::branch_t;
+using branch_id_t = tree_topology_t::branch_id_t;
+using element_t = tree_topology_t::element_t;
+
+TEST(tree_topology, update_all_incremental) {
+  tree_topology_t t;
+  thread_pool pool;
+  pool.start(8);
+
+  pseudo_random rng;
+
+  std::vector<entity_t*> ents;
+
+  size_t n = 10000;
+
+  for(size_t i = 0; i < n; ++i){
+    point_t p = {rng.uniform(0.1, 0.9), rng.uniform(0.1, 0.9)};
+    auto e = t.make_entity(p);
+    t.insert(e);
+    ents.push_back(e);
+  }
+
+  std::array<point_t, 2> range = {{{0, 0}, {1, 1}}};
+
+  auto check = [&](){
+    for(auto ent : ents){
+      branch_id_t bid = ent->get_branch_id();
+      branch_t* b = t.get(bid);
+      ASSERT_TRUE(b->is_leaf());
+      ASSERT_TRUE(branch_id_t(range, ent->coordinates(), bid.depth()) == bid);
+      ASSERT_TRUE(std::count(b->begin(), b->end(), ent) == 1);
+    }
+
+    for(size_t i = 0; i < n; i += 100){
+      auto ns = t.find_in_radius(ents[i]->coordinates(), 0.05);
+
+      set<entity_t*> s1;
+      for(auto e : ns){
+        s1.insert(e);
+      }
+
+      set<entity_t*> s2;
+
+      for(size_t j = 0; j < n; ++j){
+        if(distance(ents[i]->coordinates(), ents[j]->coordinates()) <= 0.05){
+          s2.insert(ents[j]);
+        }
+      }
+
+      ASSERT_TRUE(s1 == s2);
+    }
+  };
+
+  for(size_t step = 0; step < 4; ++step){
+    for(size_t i = step; i < n; i += 4){
+      point_t dp = {rng.uniform(-0.05, 0.05), rng.uniform(-0.05, 0.05)};
+      ents[i]->move(dp);
+    }
+
+    if(step % 2 == 0){
+      t.update_all();
+    }
+    else{
+      t.update_all(pool);
+    }
+
+    check();
+  }
+
+  t.rebuild();
+  check();
+
+  t.rebuild(pool);
+  check();
+}
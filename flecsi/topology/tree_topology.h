@@ -39,12 +39,14 @@
 #include <map>
 #include <cmath>
 #include <bitset>
+#include <cstring>
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <set>
 #include <functional>
 #include <mutex>
+#include <type_traits>
 
 #include "flecsi/geometry/point.h"
 #include "flecsi/concurrency/thread_pool.h"
@@ -79,7 +81,7 @@ template<
 >
 struct tree_geometry<T, 1>
 {
-  using point_t = point<T, 1>;
+  using point_t = point__<T, 1>;
   using element_t = T;
 
   /*!
@@ -181,7 +183,7 @@ template<
 >
 struct tree_geometry<T, 2>
 {
-  using point_t = point<T, 2>;
+  using point_t = point__<T, 2>;
   using element_t = T;
 
   /*!
@@ -298,7 +300,7 @@ template<
 >
 struct tree_geometry<T, 3>
 {
-  using point_t = point<T, 3>;
+  using point_t = point__<T, 3>;
   using element_t = T;
 
   /*!
@@ -439,8 +441,8 @@ public:
     typename S
   >
   branch_id(
-    const std::array<point<S, dimension>, 2>& range,
-    const point<S, dimension>& p,
+    const std::array<point__<S, dimension>, 2>& range,
+    const point__<S, dimension>& p,
     size_t depth)
   : id_(int_t(1) << depth * dimension + (bits - 1) % dimension)
   {
@@ -667,8 +669,8 @@ public:
   >
   void
   coordinates(
-    const std::array<point<S, dimension>, 2>& range,
-    point<S, dimension>& p) const
+    const std::array<point__<S, dimension>, 2>& range,
+    point__<S, dimension>& p) const
   {
     std::array<int_t, dimension> coords;
     coords.fill(int_t(0));
@@ -793,14 +795,232 @@ enum class action : uint8_t{
   coarsen = 0b10
 };
 
+/*!
+  Tree storage types. A tree policy selects the storage of its branches and
+  entities by defining "using storage = ...;" to one of these types. Trees
+  whose policy does not define a storage type use hashed_tree_storage.
+ */
+
+//! Branches are allocated individually, linked by pointers, and looked up
+//! through a hash map of branch ids. Branches are refined and coarsened
+//! incrementally as entities are inserted and removed.
+struct hashed_tree_storage{};
+
+//! Branches are stored level by level in a contiguous array, with the
+//! children of a branch adjacent, and entities are stored in Morton order.
+//! The tree is rebuilt in bulk after insertions and removals. See
+//! linear_tree_topology.h.
+struct linear_tree_storage{};
+
+template<
+  class P,
+  typename = void
+>
+struct tree_storage__
+{
+  using type = hashed_tree_storage;
+};
+
+template<
+  class P
+>
+struct tree_storage__<P,
+  typename std::conditional<true, void, typename P::storage>::type>
+{
+  using type = typename P::storage;
+};
+
+/*!
+  Neighbor list in compressed row storage, as returned by the batched
+  find_in_radius. The neighbors of query i are
+  entities[offsets[i]] ... entities[offsets[i + 1] - 1].
+ */
+template<
+  typename E
+>
+struct tree_neighbor_list__
+{
+  std::vector<size_t> offsets;
+  std::vector<E*> entities;
+
+  size_t
+  size() const
+  {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+};
+
+/*!
+  Grouping of batched radius queries. The queries are sorted by Morton key
+  and consecutive queries are grouped, so that each group can walk the
+  tree once for all of its queries.
+ */
+template<
+  typename E,
+  typename T,
+  size_t D
+>
+struct tree_query_batch__
+{
+  using point_t = point__<T, D>;
+
+  /*!
+    A group of queries that are close in Morton order, and the entities
+    found for them. The neighbors of queries[i] are
+    ents[offsets[i]] ... ents[offsets[i + 1] - 1].
+   */
+  struct group_t{
+    std::vector<size_t> queries;
+    point_t min;
+    point_t max;
+    std::vector<size_t> offsets;
+    std::vector<E*> ents;
+  };
+
+  // The maximum number of queries in a group.
+  static constexpr size_t max_group_queries = 32;
+
+  /*!
+    Group the queries. key(p) returns the Morton key of point p.
+   */
+  template<
+    typename K
+  >
+  static
+  std::vector<group_t>
+  group(
+    const std::vector<point_t>& centers,
+    const std::vector<T>& radii,
+    K&& key
+  )
+  {
+    assert(centers.size() == radii.size());
+
+    const size_t n = centers.size();
+
+    std::vector<std::pair<decltype(key(centers[0])), size_t>> keys;
+    keys.reserve(n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      keys.emplace_back(key(centers[i]), i);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    // A query starts a new group when the group is full or when its
+    // sphere would grow the bounding box of the group beyond four times
+    // the largest radius in the group, e.g., at a jump in Morton order.
+    std::vector<group_t> groups;
+    T max_radius = 0;
+
+    for(auto& k : keys)
+    {
+      const size_t q = k.second;
+      point_t qmin = centers[q];
+      point_t qmax = centers[q];
+      qmin -= radii[q];
+      qmax += radii[q];
+
+      if(!groups.empty() &&
+         groups.back().queries.size() < max_group_queries)
+      {
+        group_t& g = groups.back();
+        T r = std::max(max_radius, radii[q]);
+        bool fits = true;
+
+        for(size_t d = 0; d < D; ++d)
+        {
+          if(std::max(g.max[d], qmax[d]) - std::min(g.min[d], qmin[d]) >
+             4 * r)
+          {
+            fits = false;
+            break;
+          }
+        }
+
+        if(fits)
+        {
+          for(size_t d = 0; d < D; ++d)
+          {
+            g.min[d] = std::min(g.min[d], qmin[d]);
+            g.max[d] = std::max(g.max[d], qmax[d]);
+          }
+
+          g.queries.push_back(q);
+          max_radius = r;
+          continue;
+        }
+      }
+
+      groups.emplace_back();
+      groups.back().queries.push_back(q);
+      groups.back().min = qmin;
+      groups.back().max = qmax;
+      max_radius = radii[q];
+    }
+
+    return groups;
+  }
+
+  /*!
+    Gather the results of the groups into a neighbor list in query order.
+   */
+  static
+  void
+  gather(
+    const std::vector<group_t>& groups,
+    size_t num_queries,
+    tree_neighbor_list__<E>& nl
+  )
+  {
+    nl.offsets.assign(num_queries + 1, 0);
+
+    for(auto& g : groups)
+    {
+      for(size_t i = 0; i < g.queries.size(); ++i)
+      {
+        nl.offsets[g.queries[i] + 1] = g.offsets[i + 1] - g.offsets[i];
+      }
+    }
+
+    for(size_t i = 0; i < num_queries; ++i)
+    {
+      nl.offsets[i + 1] += nl.offsets[i];
+    }
+
+    nl.entities.resize(nl.offsets[num_queries]);
+
+    for(auto& g : groups)
+    {
+      for(size_t i = 0; i < g.queries.size(); ++i)
+      {
+        std::copy(g.ents.begin() + g.offsets[i],
+                  g.ents.begin() + g.offsets[i + 1],
+                  nl.entities.begin() + nl.offsets[g.queries[i]]);
+      }
+    }
+  }
+};
+
 /*!
   The tree topology is parameterized on a policy P which defines its branch and
-  entity types.
+  entity types, and optionally its storage type S.
+ */
+template<
+  class P,
+  typename S = typename tree_storage__<P>::type
+>
+class tree_topology;
+
+/*!
+  Tree topology with hashed storage.
  */
 template<
   class P
 >
-class tree_topology : public P, public data::data_client_t
+class tree_topology<P, hashed_tree_storage> :
+  public P, public data::data_client_t
 {
 public:
   using Policy = P;
@@ -809,7 +1029,7 @@ public:
 
   using element_t = typename Policy::element_t;
 
-  using point_t = point<element_t, dimension>;
+  using point_t = point__<element_t, dimension>;
 
   using range_t = std::pair<element_t, element_t>;
 
@@ -841,6 +1061,8 @@ public:
 
   using subentity_space_t = index_space<entity_t*, false, true, false>;
 
+  using neighbor_list_t = tree_neighbor_list__<entity_t>;
+
   struct filter_valid{
     bool operator()(entity_t* ent) const{
       return ent->is_valid();
@@ -874,8 +1096,8 @@ public:
     dimension.
    */
   tree_topology(
-    const point<element_t, dimension>& start,
-    const point<element_t, dimension>& end
+    const point__<element_t, dimension>& start,
+    const point__<element_t, dimension>& end
   )
   {
     branch_id_t bid = branch_id_t::root();
@@ -967,33 +1189,39 @@ public:
   }
 
   /*!
-    Effectively re-insert all entities into the tree. Called when all entity
-    coordinates are assumed to have changed.
+    Update the tree after the coordinates of any number of entities have
+    changed. Only the entities that have left their branch are moved, and
+    the refinement and coarsening that the moves request are done in one
+    pass afterwards.
    */
   void
   update_all()
   {
-    root_->template dealloc_<branch_t>();
-    max_depth_ = 0;
-    branch_map_.clear();
-    branch_map_.emplace(root_->id(), root_);
+    update_all_(nullptr);
+  }
 
-    for(auto ent : entities_)
-    {
-      ent->set_branch_id_(branch_id_t::null());
-      insert(ent);
-    }
+  /*!
+    Update the tree after the coordinates of any number of entities have
+    changed. (Concurrent version: the new branch ids of the entities are
+    computed in parallel.)
+   */
+  void
+  update_all(
+    thread_pool& pool
+  )
+  {
+    update_all_(&pool);
   }
 
   /*!
-    Effectively re-insert all entities into the tree. Called when all entity
-    coordinates are assumed to have changed. Additionally expands or contracts
-    the coordinate ranges of each dimension to [start, end].
+    Rebuild the tree. Called when all entity coordinates are assumed to have
+    changed. Additionally expands or contracts the coordinate ranges of each
+    dimension to [start, end].
    */
   void
   update_all(
-    const point<element_t, dimension>& start,
-    const point<element_t, dimension>& end
+    const point__<element_t, dimension>& start,
+    const point__<element_t, dimension>& end
   )
   {
 
@@ -1005,16 +1233,33 @@ public:
       range_[1][d] = end[d];
     }
 
-    root_->template dealloc_<branch_t>();
-    max_depth_ = 0;
-    branch_map_.clear();
-    branch_map_.emplace(root_->id(), root_);
+    rebuild();
+  }
 
-    for(auto ent : entities_)
-    {
-      ent->set_branch_id_(branch_id_t::null());
-      insert(ent);
-    }
+  /*!
+    Rebuild the tree from scratch. The entities are radix sorted by branch
+    id, so that the entities of every branch form a contiguous range, and
+    each branch is built from its range: when inserting the range into a
+    branch requests a refinement, the range is split among its children
+    instead. Each entity is inserted once into its final branch, apart from
+    the few inserted before a refinement is requested.
+   */
+  void
+  rebuild()
+  {
+    rebuild_(nullptr);
+  }
+
+  /*!
+    Rebuild the tree from scratch. (Concurrent version: the branch ids of
+    the entities are computed in parallel.)
+   */
+  void
+  rebuild(
+    thread_pool& pool
+  )
+  {
+    rebuild_(&pool);
   }
 
   /*!
@@ -1114,30 +1359,19 @@ public:
   {
 
     size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
 
     auto ef =
     [&](entity_t* ent, const point_t& center, element_t radius) -> bool{
       return geometry_t::within(ent->coordinates(), center, radius);
     };
 
-    virtual_semaphore sem(1 - int(m));
-    std::mutex mtx;
-
-    subentity_space_t ents;
-    ents.set_master(entities_);
-
     size_t depth;
     element_t size;
     branch_t* b = find_start_(center, radius, depth, size);
     queue_depth += depth;
 
-    find_(pool, sem, mtx, queue_depth, depth, b, size, ents, ef,
-          geometry_t::intersects, center, radius);
-
-    sem.acquire();
-
-    return ents;
+    return find_(pool, queue_depth, depth, b, size, ef,
+                 geometry_t::intersects, center, radius);
   }
 
   /*!
@@ -1191,7 +1425,6 @@ public:
   )
   {
     size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
 
     auto ef =
     [&](entity_t* ent, const point_t& min, const point_t& max) -> bool{
@@ -1214,20 +1447,69 @@ public:
     element_t size;
     branch_t* b = find_start_(center, radius, depth, size);
 
-    subentity_space_t ents;
-    ents.set_master(entities_);
-
     queue_depth += depth;
 
-    virtual_semaphore sem(1 - int(m));
-    std::mutex mtx;
+    return find_(pool, queue_depth, depth, b, size, ef,
+                 geometry_t::intersects_box, min, max);
+  }
 
-    find_(pool, sem, mtx, queue_depth, depth, b, size, ents, ef,
-          geometry_t::intersects_box, min, max);
+  /*!
+    Find the entities within radii[i] of centers[i] for a batch of query
+    points, e.g., one query per particle. The queries are sorted by Morton
+    branch id and split into groups of nearby queries. The tree is walked
+    once per group, and the queries of a group are tested against the
+    leaves that the group reaches.
 
-    sem.acquire();
+    Returns the neighbors of each query, in query order, as a CSR list.
+   */
+  neighbor_list_t
+  find_in_radius(
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    neighbor_list_t nl;
+    auto groups = group_queries_(centers, radii);
 
-    return ents;
+    for(auto& g : groups)
+    {
+      find_group_(g, centers, radii);
+    }
+
+    query_batch_t::gather(groups, centers.size(), nl);
+
+    return nl;
+  }
+
+  /*!
+    Find the entities within radii[i] of centers[i] for a batch of query
+    points. (Concurrent version.)
+   */
+  neighbor_list_t
+  find_in_radius(
+    thread_pool& pool,
+    const std::vector<point_t>& centers,
+    const std::vector<element_t>& radii
+  )
+  {
+    neighbor_list_t nl;
+    auto groups = group_queries_(centers, radii);
+
+    task_group group(pool);
+
+    for(auto& g : groups)
+    {
+      group.run([&]()
+      {
+        find_group_(g, centers, radii);
+      });
+    }
+
+    group.wait();
+
+    query_batch_t::gather(groups, centers.size(), nl);
+
+    return nl;
   }
 
   /*!
@@ -1279,7 +1561,6 @@ public:
   {
 
     size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
 
     auto f = [&](entity_t* ent, const point_t& center, element_t radius)
     {
@@ -1294,12 +1575,12 @@ public:
     branch_t* b = find_start_(center, radius, depth, size);
     queue_depth += depth;
 
-    virtual_semaphore sem(1 - int(m));
+    task_group group(pool);
 
-    apply_(pool, sem, queue_depth, depth, b, size,
+    apply_(group, queue_depth, depth, b, size,
            f, geometry_t::intersects, center, radius);
 
-    sem.acquire();
+    group.wait();
   }
 
   /*!
@@ -1321,7 +1602,6 @@ public:
   {
 
     size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
 
     auto f = [&](entity_t* ent, const point_t& min, const point_t& max)
     {
@@ -1348,12 +1628,12 @@ public:
     branch_t* b = find_start_(center, radius, depth, size);
     queue_depth += depth;
 
-    virtual_semaphore sem(1 - int(m));
+    task_group group(pool);
 
-    apply_(pool, sem, queue_depth, depth, b, size,
+    apply_(group, queue_depth, depth, b, size,
            f, geometry_t::intersects_box, min, max);
 
-    sem.acquire();
+    group.wait();
   }
 
   /*!
@@ -1491,15 +1771,12 @@ public:
     ARGS&&... args
   )
   {
-    size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
+    task_group group(pool);
 
-    virtual_semaphore sem(1 - int(m));
-
-    visit_(pool, sem, b, 0, queue_depth,
+    visit_(group, b, 0, get_queue_depth(pool),
            std::forward<F>(f), std::forward<ARGS>(args)...);
 
-    sem.acquire();
+    group.wait();
   }
 
   /*!
@@ -1548,15 +1825,12 @@ public:
     ARGS&&... args
   )
   {
-    size_t queue_depth = get_queue_depth(pool);
-    size_t m = branch_int_t(1) << queue_depth * P::dimension;
+    task_group group(pool);
 
-    virtual_semaphore sem(1 - int(m));
-
-    visit_children_(pool, sem, 0, queue_depth, b,
+    visit_children_(group, 0, get_queue_depth(pool), b,
                     std::forward<F>(f), std::forward<ARGS>(args)...);
 
-    sem.acquire();
+    group.wait();
   }
 
   /*!
@@ -1769,6 +2043,309 @@ private:
       return find_parent_(pid);
     }
 
+    /*!
+      Call f(first, last) on blocks of [0, n), concurrently if a pool is
+      given.
+     */
+    template<
+      typename F
+    >
+    void
+    for_each_block_(
+      thread_pool* pool,
+      size_t n,
+      F&& f
+    )
+    {
+      if(!pool || pool->num_threads() == 0 || n < 1024)
+      {
+        f(size_t(0), n);
+        return;
+      }
+
+      const size_t num_blocks = pool->num_threads() * 4;
+
+      task_group group(*pool);
+
+      for(size_t k = 0; k < num_blocks; ++k)
+      {
+        size_t first = n * k / num_blocks;
+        size_t last = n * (k + 1) / num_blocks;
+
+        group.run([&f, first, last]()
+        {
+          f(first, last);
+        });
+      }
+
+      group.wait();
+    }
+
+    /*!
+      Return the entities that are inserted in the tree.
+     */
+    entity_vector_t
+    valid_entities_()
+    {
+      entity_vector_t ents;
+      ents.reserve(entities_.size());
+
+      for(auto ent : entities_)
+      {
+        if(ent->is_valid())
+        {
+          ents.push_back(ent);
+        }
+      }
+
+      return ents;
+    }
+
+    void
+    update_all_(
+      thread_pool* pool
+    )
+    {
+      entity_vector_t ents = valid_entities_();
+      const size_t n = ents.size();
+
+      // Compute the new branch id of each entity at the current max depth,
+      // and find the entities that have left their branch.
+      branch_id_vector_t keys(n);
+      std::vector<char> moved(n);
+
+      for_each_block_(pool, n,
+        [&](size_t first, size_t last){
+          for(size_t i = first; i < last; ++i)
+          {
+            branch_id_t bid = ents[i]->get_branch_id();
+            keys[i] = to_branch_id(ents[i]->coordinates(), max_depth_);
+
+            branch_id_t nid = keys[i];
+            nid.truncate(bid.depth());
+            moved[i] = nid != bid;
+          }
+        });
+
+      // Remove the moved entities from their branches.
+      branch_id_vector_t removed_from;
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        if(!moved[i])
+        {
+          continue;
+        }
+
+        branch_id_t bid = ents[i]->get_branch_id();
+        branch_t* b = get(bid);
+
+        b->remove(ents[i]);
+        ents[i]->set_branch_id_(branch_id_t::null());
+
+        if(b->requested_action_() == action::coarsen)
+        {
+          removed_from.push_back(bid);
+        }
+      }
+
+      // Coarsen deepest first, so that a coarsened branch is not visited
+      // after one of its ancestors has been coarsened.
+      std::sort(removed_from.begin(), removed_from.end(),
+        [](const branch_id_t& a, const branch_id_t& b){
+          return b < a;
+        });
+
+      removed_from.erase(
+        std::unique(removed_from.begin(), removed_from.end()),
+        removed_from.end());
+
+      for(auto bid : removed_from)
+      {
+        auto itr = branch_map_.find(bid);
+
+        if(itr == branch_map_.end() ||
+           itr->second->requested_action_() != action::coarsen)
+        {
+          continue;
+        }
+
+        auto p = static_cast<branch_t*>(itr->second->parent());
+
+        if(p && Policy::should_coarsen(p))
+        {
+          coarsen_(p);
+        }
+      }
+
+      // Insert the moved entities into their new branches, and refine the
+      // branches that request it once all of them are inserted.
+      std::vector<branch_t*> refine;
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        if(!moved[i])
+        {
+          continue;
+        }
+
+        branch_t* b = find_parent(keys[i], max_depth_);
+        ents[i]->set_branch_id_(b->id());
+        b->insert(ents[i]);
+
+        if(b->requested_action_() == action::refine)
+        {
+          refine.push_back(b);
+        }
+      }
+
+      std::sort(refine.begin(), refine.end());
+      refine.erase(std::unique(refine.begin(), refine.end()), refine.end());
+
+      for(auto b : refine)
+      {
+        if(b->is_leaf() && b->requested_action_() == action::refine)
+        {
+          refine_(b);
+        }
+      }
+    }
+
+    void
+    rebuild_(
+      thread_pool* pool
+    )
+    {
+      entity_vector_t ents = valid_entities_();
+      const size_t n = ents.size();
+
+      root_->template dealloc_<branch_t>();
+      root_->clear();
+      root_->reset();
+      max_depth_ = 0;
+      branch_map_.clear();
+      branch_map_.emplace(root_->id(), root_);
+
+      std::vector<std::pair<branch_int_t, entity_t*>> sorted(n);
+
+      for_each_block_(pool, n,
+        [&](size_t first, size_t last){
+          for(size_t i = first; i < last; ++i)
+          {
+            sorted[i].first = to_branch_id(ents[i]->coordinates(),
+              branch_id_t::max_depth).value_();
+            sorted[i].second = ents[i];
+          }
+        });
+
+      radix_sort_(sorted);
+
+      build_(root_, sorted.data(), sorted.data() + n);
+    }
+
+    /*!
+      Stable LSD radix sort of (key, entity) pairs by key, eight bits at a
+      time.
+     */
+    static
+    void
+    radix_sort_(
+      std::vector<std::pair<branch_int_t, entity_t*>>& v
+    )
+    {
+      constexpr size_t radix_bits = 8;
+      constexpr size_t radix = size_t(1) << radix_bits;
+      constexpr size_t key_bits =
+        branch_id_t::max_depth * dimension + (branch_id_t::bits - 1) % dimension;
+
+      std::vector<std::pair<branch_int_t, entity_t*>> tmp(v.size());
+      std::array<size_t, radix> offsets;
+
+      for(size_t shift = 0; shift < key_bits; shift += radix_bits)
+      {
+        offsets.fill(0);
+
+        for(auto& p : v)
+        {
+          ++offsets[(p.first >> shift) & (radix - 1)];
+        }
+
+        size_t sum = 0;
+
+        for(auto& o : offsets)
+        {
+          size_t c = o;
+          o = sum;
+          sum += c;
+        }
+
+        for(auto& p : v)
+        {
+          tmp[offsets[(p.first >> shift) & (radix - 1)]++] = p;
+        }
+
+        v.swap(tmp);
+      }
+    }
+
+    /*!
+      Build the subtree of leaf b from the sorted entities [first, last),
+      which all lie within b.
+     */
+    void
+    build_(
+      branch_t* b,
+      std::pair<branch_int_t, entity_t*>* first,
+      std::pair<branch_int_t, entity_t*>* last
+    )
+    {
+      const size_t depth = b->id().depth();
+
+      for(auto itr = first; itr != last; ++itr)
+      {
+        itr->second->set_branch_id_(b->id());
+        b->insert(itr->second);
+
+        if(b->requested_action_() == action::refine &&
+           depth < branch_id_t::max_depth)
+        {
+          // Split the range among the children instead.
+          for(auto e = first; e != itr + 1; ++e)
+          {
+            e->second->set_branch_id_(branch_id_t::null());
+          }
+
+          b->clear();
+          b->reset();
+          b->template into_branch_<branch_t>();
+          max_depth_ = std::max(max_depth_, depth + 1);
+
+          const size_t shift =
+            (branch_id_t::max_depth - depth - 1) * dimension;
+          constexpr branch_int_t mask = branch_t::num_children - 1;
+
+          for(size_t i = 0; i < branch_t::num_children; ++i)
+          {
+            branch_t* ci = b->template child_<branch_t>(i);
+            branch_map_.emplace(ci->id(), ci);
+
+            auto child_last = std::partition_point(first, last,
+              [&](const std::pair<branch_int_t, entity_t*>& p){
+                return ((p.first >> shift) & mask) <= i;
+              });
+
+            build_(ci, first, child_last);
+            first = child_last;
+          }
+
+          return;
+        }
+      }
+
+      // The range fit without a refinement (or may not be refined further).
+      b->reset();
+    }
+
     void
     refine_(
       branch_t* b
@@ -1790,9 +2367,11 @@ private:
 
       max_depth_ = std::max(max_depth_, depth);
 
+      // A child may itself be refined while b's entities are distributed,
+      // so each entity is inserted at the deepest branch that contains it.
       for(auto ent : *b)
       {
-        insert(ent, depth);
+        insert(ent, max_depth_);
       }
 
       b->clear();
@@ -1843,7 +2422,7 @@ private:
       thread_pool& pool
     )
     {
-      size_t n = pool.num_threads();
+      size_t n = std::max(pool.num_threads(), size_t(1));
       constexpr size_t rb = branch_int_t(1) << P::dimension;
       double bn = std::log2(double(rb));
       return std::log2(double(n))/bn + 1;
@@ -1946,8 +2525,7 @@ private:
     >
     void
     apply_(
-      thread_pool& pool,
-      virtual_semaphore& sem,
+      task_group& group,
       size_t queue_depth,
       size_t depth,
       branch_t* b,
@@ -1965,13 +2543,6 @@ private:
           ef(ent, std::forward<ARGS>(args)...);
         }
 
-        size_t m = branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-        for(size_t i = 0; i < m; ++i)
-        {
-          sem.release();
-        }
-
         return;
       }
 
@@ -1987,42 +2558,24 @@ private:
         {
           if(depth == queue_depth)
           {
-
-            auto f = [&, size, ci]()
+            group.run([&, size, ci]()
             {
               apply_(ci, size,
                 std::forward<EF>(ef), std::forward<BF>(bf),
                 std::forward<ARGS>(args)...);
-
-              sem.release();
-            };
-
-            pool.queue(f);
+            });
           }
           else{
-            apply_(pool, sem, queue_depth, depth, ci, size,
+            apply_(group, queue_depth, depth, ci, size,
                    std::forward<EF>(ef), std::forward<BF>(bf),
                    std::forward<ARGS>(args)...);
           }
         }
-        else{
-          if(depth > queue_depth)
-          {
-            continue;
-          }
-
-          size_t m =
-            branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-          for(size_t i = 0; i < m; ++i)
-          {
-            sem.release();
-          }
-        }
       }
     }
 
     template<
+      typename ENTS,
       typename EF,
       typename BF,
       typename... ARGS
@@ -2031,7 +2584,7 @@ private:
     find_(
       branch_t* b,
       element_t size,
-      subentity_space_t& ents,
+      ENTS& ents,
       EF&& ef,
       BF&& bf,
       ARGS&&... args
@@ -2072,16 +2625,59 @@ private:
       typename BF,
       typename... ARGS
     >
-    void
+    subentity_space_t
     find_(
       thread_pool& pool,
-      virtual_semaphore& sem,
-      std::mutex& mtx,
       size_t queue_depth,
       size_t depth,
       branch_t* b,
       element_t size,
-      subentity_space_t& ents,
+      EF&& ef,
+      BF&& bf,
+      ARGS&&... args
+    )
+    {
+      // One result slot per branch at queue_depth. The slots are merged in
+      // branch order, so the result does not depend on the scheduling.
+      std::vector<std::vector<entity_t*>> slots(
+        branch_int_t(1) << (queue_depth - depth) * P::dimension);
+
+      task_group group(pool);
+
+      find_(group, slots, 0, queue_depth, depth, b, size,
+            std::forward<EF>(ef), std::forward<BF>(bf),
+            std::forward<ARGS>(args)...);
+
+      group.wait();
+
+      subentity_space_t ents;
+      ents.set_master(entities_);
+
+      for(auto& slot : slots)
+      {
+        for(auto ent : slot)
+        {
+          ents.push_back(ent);
+        }
+      }
+
+      return ents;
+    }
+
+    template<
+      typename EF,
+      typename BF,
+      typename... ARGS
+    >
+    void
+    find_(
+      task_group& group,
+      std::vector<std::vector<entity_t*>>& slots,
+      size_t slot,
+      size_t queue_depth,
+      size_t depth,
+      branch_t* b,
+      element_t size,
       EF&& ef,
       BF&& bf,
       ARGS&&... args
@@ -2090,7 +2686,8 @@ private:
 
       if(b->is_leaf())
       {
-        mtx.lock();
+        auto& ents = slots[slot << (queue_depth - depth) * P::dimension];
+
         for(auto ent : *b)
         {
           if(ef(ent, std::forward<ARGS>(args)...))
@@ -2098,14 +2695,6 @@ private:
             ents.push_back(ent);
           }
         }
-        mtx.unlock();
-
-        size_t m = branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-        for(size_t i = 0; i < m; ++i)
-        {
-          sem.release();
-        }
 
         return;
       }
@@ -2116,50 +2705,132 @@ private:
       for(size_t i = 0; i < branch_t::num_children; ++i)
       {
         branch_t* ci = b->template child_<branch_t>(i);
+        size_t si = slot * branch_t::num_children + i;
 
         if(bf(ci->coordinates(range_),
               size, scale_, std::forward<ARGS>(args)...))
         {
           if(depth == queue_depth)
           {
-
-            auto f = [&, size, ci]()
+            group.run([&, size, ci, si]()
             {
-              subentity_space_t branch_ents;
-
-              find_(ci, size, branch_ents,
+              find_(ci, size, slots[si],
                 std::forward<EF>(ef), std::forward<BF>(bf),
                 std::forward<ARGS>(args)...);
-
-              mtx.lock();
-              ents.append(branch_ents);
-              mtx.unlock();
-
-              sem.release();
-            };
-
-            pool.queue(f);
+            });
           }
           else{
-            find_(pool, sem, mtx, queue_depth, depth, ci, size, ents,
+            find_(group, slots, si, queue_depth, depth, ci, size,
                   std::forward<EF>(ef), std::forward<BF>(bf),
                   std::forward<ARGS>(args)...);
           }
         }
-        else{
-          if(depth > queue_depth)
+      }
+    }
+
+    using query_batch_t = tree_query_batch__<entity_t, element_t, dimension>;
+
+    using query_group_t = typename query_batch_t::group_t;
+
+    std::vector<query_group_t>
+    group_queries_(
+      const std::vector<point_t>& centers,
+      const std::vector<element_t>& radii
+    )
+    {
+      return query_batch_t::group(centers, radii,
+        [this](const point_t& p){
+          return to_branch_id(p, branch_id_t::max_depth);
+        });
+    }
+
+    void
+    find_group_(
+      query_group_t& g,
+      const std::vector<point_t>& centers,
+      const std::vector<element_t>& radii
+    )
+    {
+      // Collect the leaves that intersect the bounding box of the group,
+      // starting from the smallest branch that contains it.
+      point_t center;
+      element_t radius = 0;
+
+      for(size_t d = 0; d < dimension; ++d)
+      {
+        center[d] = (g.min[d] + g.max[d])/2;
+        radius = std::max(radius, (g.max[d] - g.min[d])/2);
+      }
+
+      size_t depth;
+      element_t size;
+      branch_t* b = find_start_(center, radius, depth, size);
+
+      std::vector<std::pair<branch_t*, element_t>> leaves;
+
+      collect_leaves_(b, size, leaves, geometry_t::intersects_box,
+                      g.min, g.max);
+
+      g.offsets.resize(g.queries.size() + 1);
+      g.offsets[0] = 0;
+
+      for(size_t i = 0; i < g.queries.size(); ++i)
+      {
+        const point_t& c = centers[g.queries[i]];
+        const element_t r = radii[g.queries[i]];
+
+        for(auto& l : leaves)
+        {
+          if(!geometry_t::intersects(l.first->coordinates(range_),
+                                     l.second, scale_, c, r))
           {
             continue;
           }
 
-          size_t m =
-            branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-          for(size_t i = 0; i < m; ++i)
+          for(auto ent : *l.first)
           {
-            sem.release();
+            if(geometry_t::within(ent->coordinates(), c, r))
+            {
+              g.ents.push_back(ent);
+            }
           }
         }
+
+        g.offsets[i + 1] = g.ents.size();
+      }
+    }
+
+    template<
+      typename BF,
+      typename... ARGS
+    >
+    void
+    collect_leaves_(
+      branch_t* b,
+      element_t size,
+      std::vector<std::pair<branch_t*, element_t>>& leaves,
+      BF&& bf,
+      ARGS&&... args
+    )
+    {
+      if(b->is_leaf())
+      {
+        leaves.emplace_back(b, size);
+        return;
+      }
+
+      size /= 2;
+
+      for(size_t i = 0; i < branch_t::num_children; ++i)
+      {
+        branch_t* ci = b->template child_<branch_t>(i);
+
+        if(bf(ci->coordinates(range_),
+              size, scale_, std::forward<ARGS>(args)...))
+        {
+          collect_leaves_(ci, size, leaves, std::forward<BF>(bf),
+                          std::forward<ARGS>(args)...);
+        }
       }
     }
 
@@ -2197,8 +2868,7 @@ private:
     >
     void
     visit_(
-      thread_pool& pool,
-      virtual_semaphore& sem,
+      task_group& group,
       branch_t* b,
       size_t depth,
       size_t queue_depth,
@@ -2209,37 +2879,21 @@ private:
 
       if(depth == queue_depth)
       {
-        auto vf = [&, depth, b]()
+        group.run([&, depth, b]()
         {
           visit_(b, depth, std::forward<F>(f), std::forward<ARGS>(args)...);
-          sem.release();
-        };
+        });
 
-        pool.queue(vf);
         return;
       }
 
       if(f(b, depth, std::forward<ARGS>(args)...))
       {
-        size_t m = branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-        for(size_t i = 0; i < m; ++i)
-        {
-          sem.release();
-        }
-
         return;
       }
 
       if(b->is_leaf())
       {
-        size_t m = branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-        for(size_t i = 0; i < m; ++i)
-        {
-          sem.release();
-        }
-
         return;
       }
 
@@ -2247,7 +2901,7 @@ private:
       {
         branch_t* bi = b->template child_<branch_t>(i);
 
-        visit_(pool, sem, bi, depth + 1, queue_depth,
+        visit_(group, bi, depth + 1, queue_depth,
                std::forward<F>(f), std::forward<ARGS>(args)...);
       }
     }
@@ -2258,8 +2912,7 @@ private:
     >
     void
     visit_children_(
-      thread_pool& pool,
-      virtual_semaphore& sem,
+      task_group& group,
       size_t depth,
       size_t queue_depth,
       branch_t* b,
@@ -2270,13 +2923,11 @@ private:
 
       if(depth == queue_depth)
       {
-        auto vf = [&, b]()
+        group.run([&, b]()
         {
           visit_children(b, std::forward<F>(f), std::forward<ARGS>(args)...);
-          sem.release();
-        };
+        });
 
-        pool.queue(vf);
         return;
       }
 
@@ -2287,20 +2938,13 @@ private:
           f(ent, std::forward<ARGS>(args)...);
         }
 
-        size_t m = branch_int_t(1) << (queue_depth - depth) * P::dimension;
-
-        for(size_t i = 0; i < m; ++i)
-        {
-          sem.release();
-        }
-
         return;
       }
 
       for(size_t i = 0; i < branch_t::num_children; ++i)
       {
         branch_t* bi = b->template child_<branch_t>(i);
-        visit_children_(pool, sem, depth + 1, queue_depth,
+        visit_children_(group, depth + 1, queue_depth,
                         bi, std::forward<F>(f), std::forward<ARGS>(args)...);
       }
     }
@@ -2310,8 +2954,8 @@ private:
   size_t max_depth_;
   branch_t* root_;
   entity_space_t entities_;
-  std::array<point<element_t, dimension>, 2> range_;
-  point<element_t, dimension> scale_;
+  std::array<point__<element_t, dimension>, 2> range_;
+  point__<element_t, dimension> scale_;
   element_t max_scale_;
 };
 
@@ -2361,7 +3005,7 @@ public:
   }
 
 private:
-  template<class P>
+  template<class P, typename S>
   friend class tree_topology;
 
   void
@@ -2459,7 +3103,7 @@ public:
   }
 
 private:
-  template<class P>
+  template<class P, typename S>
   friend class tree_topology;
 
   void
@@ -2557,6 +3201,9 @@ private:
 } // namespace topology
 } // namespace flecsi
 
+// Tree topology with linear storage.
+#include "flecsi/topology/linear_tree_topology.h"
+
 #endif // flecsi_topology_tree_topology_h
 
 /*~-------------------------------------------------------------------------~-*
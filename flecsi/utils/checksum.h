@@ -29,7 +29,9 @@ struct checksum_t {
 }; // struct checksum_t
 
 ///
-/// Compute the checksum of an array.
+/// Compute a cryptographic checksum of an array. For validating large
+/// field data, see tree_hash.h, which is much faster and can run in
+/// parallel.
 ///
 /// \param buffer The data buffer on which to compute the checksum.
 /// \param elements The size of the buffer.
@@ -49,29 +51,29 @@ checksum(
 {
   std::size_t bytes = elements*sizeof(T);
 
-  EVP_MD_CTX ctx;
+  // Add all digests to table once
+  static bool digests_added = (OpenSSL_add_all_digests(), true);
+  (void)digests_added;
 
-  // Add all digests to table
-  OpenSSL_add_all_digests();
-
-  // Initialize context
-  EVP_MD_CTX_init(&ctx);
+  // Initialize context. EVP_MD_CTX is opaque in OpenSSL >= 1.1, so it
+  // cannot live on the stack.
+  EVP_MD_CTX * ctx = EVP_MD_CTX_create();
 
   // Get digest
   const EVP_MD * md = EVP_get_digestbyname(digest);
   clog_assert(md, "invalid digest");
 
   // Initialize digest
-  EVP_DigestInit_ex(&ctx, md, NULL);
+  EVP_DigestInit_ex(ctx, md, NULL);
 
   // Update digest with buffer
-  EVP_DigestUpdate(&ctx, reinterpret_cast<void *>(buffer), bytes);
+  EVP_DigestUpdate(ctx, reinterpret_cast<void *>(buffer), bytes);
 
   // Finalize
-  EVP_DigestFinal_ex(&ctx, sum.value, &sum.length);
+  EVP_DigestFinal_ex(ctx, sum.value, &sum.length);
 
   // Free resources
-  EVP_MD_CTX_cleanup(&ctx);
+  EVP_MD_CTX_destroy(ctx);
 
   char tmp[256];
   strcpy(sum.strvalue, "");
@@ -0,0 +1,365 @@
+/*~--------------------------------------------------------------------------~*
+ *  @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+ * /@@/////  /@@          @@////@@ @@////// /@@
+ * /@@       /@@  @@@@@  @@    // /@@       /@@
+ * /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+ * /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+ * /@@       /@@/@@//// //@@    @@       /@@/@@
+ * /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+ * //       ///  //////   //////  ////////  //
+ *
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_utils_flat_set_h
+#define flecsi_utils_flat_set_h
+
+//!
+//! \file
+//! \brief A set type stored as a sorted, contiguous array.
+//!
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <set>
+#include <vector>
+
+namespace flecsi {
+namespace utils {
+
+//!
+//! \class flat_set__ flat_set.h
+//! \brief flat_set__ provides the interface of std::set on top of a sorted
+//!        std::vector.
+//!
+//! Lookups are O(log n), and because the iterators are random access,
+//! the position of an element, e.g., std::distance(s.begin(), s.find(v)),
+//! is O(1). Insertion in increasing order and bulk construction from an
+//! unsorted range are amortized O(1) per element; random single-element
+//! insertion is O(n).
+//!
+//! \tparam T       The element type.
+//! \tparam COMPARE The strict weak ordering of the elements.
+//!
+template<
+  typename T,
+  typename COMPARE = std::less<T>
+>
+class flat_set__
+{
+public:
+
+  using value_type = T;
+  using key_type = T;
+  using key_compare = COMPARE;
+  using value_compare = COMPARE;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const T &;
+  using const_reference = const T &;
+  using iterator = typename std::vector<T>::const_iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = typename std::vector<T>::const_reverse_iterator;
+  using const_reverse_iterator = reverse_iterator;
+
+  //! Default constructor
+  flat_set__() {}
+
+  //!
+  //! Construct from an unordered range of values. Duplicates are removed.
+  //!
+  template<
+    typename ITERATOR
+  >
+  flat_set__(
+    ITERATOR first,
+    ITERATOR last
+  )
+  : values_(first, last)
+  {
+    sort_unique();
+  } // flat_set__
+
+  //!
+  //! Construct from a list of values. Duplicates are removed.
+  //!
+  flat_set__(
+    std::initializer_list<T> values
+  )
+  : values_(values)
+  {
+    sort_unique();
+  } // flat_set__
+
+  //!
+  //! Bulk construction from an unordered array of values, taking
+  //! ownership of its storage. Duplicates are removed.
+  //!
+  explicit
+  flat_set__(
+    std::vector<T> && values
+  )
+  : values_(std::move(values))
+  {
+    sort_unique();
+  } // flat_set__
+
+  //!
+  //! Construct from a std::set with the same ordering.
+  //!
+  flat_set__(
+    const std::set<T, COMPARE> & values
+  )
+  : values_(values.begin(), values.end())
+  {
+  } // flat_set__
+
+  //--------------------------------------------------------------------------//
+  // Iterators.
+  //--------------------------------------------------------------------------//
+
+  iterator begin() const { return values_.begin(); }
+  iterator end() const { return values_.end(); }
+  iterator cbegin() const { return values_.cbegin(); }
+  iterator cend() const { return values_.cend(); }
+  reverse_iterator rbegin() const { return values_.rbegin(); }
+  reverse_iterator rend() const { return values_.rend(); }
+
+  //--------------------------------------------------------------------------//
+  // Capacity.
+  //--------------------------------------------------------------------------//
+
+  size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+  void reserve(size_t n) { values_.reserve(n); }
+  void shrink_to_fit() { values_.shrink_to_fit(); }
+
+  //--------------------------------------------------------------------------//
+  // Element access.
+  //--------------------------------------------------------------------------//
+
+  //! Return the n-th smallest element.
+  const T & operator [] (size_t n) const { return values_[n]; }
+
+  //! Return the sorted elements as a contiguous array.
+  const T * data() const { return values_.data(); }
+
+  //! Return the sorted elements as a vector.
+  const std::vector<T> & values() const { return values_; }
+
+  //--------------------------------------------------------------------------//
+  // Modifiers.
+  //--------------------------------------------------------------------------//
+
+  //!
+  //! Insert a value. Appending a value larger than the current maximum
+  //! is O(1).
+  //!
+  std::pair<iterator, bool>
+  insert(
+    const T & value
+  )
+  {
+    if(values_.empty() || compare_(values_.back(), value)) {
+      values_.push_back(value);
+      return { values_.end() - 1, true };
+    } // if
+
+    auto itr = std::lower_bound(values_.begin(), values_.end(), value,
+      compare_);
+
+    if(!compare_(value, *itr)) {
+      return { itr, false };
+    } // if
+
+    return { values_.insert(itr, value), true };
+  } // insert
+
+  //!
+  //! Insert a value, ignoring the position hint. This overload allows the
+  //! use of std::inserter.
+  //!
+  iterator
+  insert(
+    iterator,
+    const T & value
+  )
+  {
+    return insert(value).first;
+  } // insert
+
+  //!
+  //! Insert a range of values with a single merge.
+  //!
+  template<
+    typename ITERATOR
+  >
+  void
+  insert(
+    ITERATOR first,
+    ITERATOR last
+  )
+  {
+    const size_t middle = values_.size();
+    values_.insert(values_.end(), first, last);
+
+    if(middle == values_.size()) {
+      return;
+    } // if
+
+    std::stable_sort(values_.begin() + middle, values_.end(), compare_);
+    std::inplace_merge(values_.begin(), values_.begin() + middle,
+      values_.end(), compare_);
+    unique();
+  } // insert
+
+  //!
+  //! Erase a value.
+  //!
+  //! \return The number of erased elements.
+  //!
+  size_t
+  erase(
+    const T & value
+  )
+  {
+    auto itr = find(value);
+
+    if(itr == end()) {
+      return 0;
+    } // if
+
+    values_.erase(values_.begin() + (itr - begin()));
+    return 1;
+  } // erase
+
+  //!
+  //! Erase the element at the given position.
+  //!
+  iterator
+  erase(
+    iterator position
+  )
+  {
+    return values_.erase(values_.begin() + (position - begin()));
+  } // erase
+
+  void clear() { values_.clear(); }
+
+  void swap(flat_set__ & s) { values_.swap(s.values_); }
+
+  //--------------------------------------------------------------------------//
+  // Lookup.
+  //--------------------------------------------------------------------------//
+
+  iterator
+  lower_bound(
+    const T & value
+  ) const
+  {
+    return std::lower_bound(values_.begin(), values_.end(), value, compare_);
+  } // lower_bound
+
+  iterator
+  upper_bound(
+    const T & value
+  ) const
+  {
+    return std::upper_bound(values_.begin(), values_.end(), value, compare_);
+  } // upper_bound
+
+  iterator
+  find(
+    const T & value
+  ) const
+  {
+    auto itr = lower_bound(value);
+    return (itr == end() || compare_(value, *itr)) ? end() : itr;
+  } // find
+
+  size_t
+  count(
+    const T & value
+  ) const
+  {
+    return find(value) == end() ? 0 : 1;
+  } // count
+
+  //!
+  //! Return the position of a value in the sorted order, or size() if the
+  //! value is not in the set.
+  //!
+  size_t
+  offset(
+    const T & value
+  ) const
+  {
+    return find(value) - begin();
+  } // offset
+
+  //--------------------------------------------------------------------------//
+  // Comparison.
+  //--------------------------------------------------------------------------//
+
+  bool
+  operator == (
+    const flat_set__ & s
+  ) const
+  {
+    return values_ == s.values_;
+  } // operator ==
+
+  bool
+  operator != (
+    const flat_set__ & s
+  ) const
+  {
+    return values_ != s.values_;
+  } // operator !=
+
+  bool
+  operator < (
+    const flat_set__ & s
+  ) const
+  {
+    return std::lexicographical_compare(begin(), end(), s.begin(), s.end(),
+      compare_);
+  } // operator <
+
+private:
+
+  void
+  sort_unique()
+  {
+    std::stable_sort(values_.begin(), values_.end(), compare_);
+    unique();
+  } // sort_unique
+
+  void
+  unique()
+  {
+    auto equivalent = [this](const T & a, const T & b) {
+      return !compare_(a, b) && !compare_(b, a);
+    };
+
+    values_.erase(std::unique(values_.begin(), values_.end(), equivalent),
+      values_.end());
+  } // unique
+
+  std::vector<T> values_;
+  COMPARE compare_;
+
+}; // class flat_set__
+
+} // namespace utils
+} // namespace flecsi
+
+#endif // flecsi_utils_flat_set_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
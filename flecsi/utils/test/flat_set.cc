@@ -0,0 +1,113 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Security, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+
+// includes: flecsi
+#include "flecsi/utils/flat_set.h"
+
+// includes: other
+#include <cinchtest.h>
+#include <iterator>
+
+using flat_set_t = flecsi::utils::flat_set__<int>;
+
+// =============================================================================
+// Test flecsi::utils::flat_set__ construction
+// =============================================================================
+
+// TEST
+TEST(flat_set, construct)
+{
+   flat_set_t a = { 7, 3, 5, 3, 1, 7 };
+   std::vector<int> expected = { 1, 3, 5, 7 };
+
+   EXPECT_EQ(a.size(), 4);
+   EXPECT_EQ(a.values(), expected);
+
+   flat_set_t b(std::vector<int>{ 5, 1, 7, 3, 1 });
+   EXPECT_EQ(a, b);
+
+   std::set<int> s = { 1, 3, 5, 7 };
+   flat_set_t c(s);
+   EXPECT_EQ(a, c);
+
+   flat_set_t d(s.rbegin(), s.rend());
+   EXPECT_EQ(a, d);
+
+   flat_set_t e;
+   EXPECT_TRUE(e.empty());
+   EXPECT_TRUE(e != a);
+   EXPECT_TRUE(e < a);
+
+} // TEST
+
+// =============================================================================
+// Test flecsi::utils::flat_set__ modifiers
+// =============================================================================
+
+// TEST
+TEST(flat_set, insert_erase)
+{
+   flat_set_t a;
+
+   // Appending in order.
+   EXPECT_TRUE(a.insert(2).second);
+   EXPECT_TRUE(a.insert(4).second);
+   EXPECT_TRUE(a.insert(8).second);
+
+   // Out of order and duplicate values.
+   EXPECT_TRUE(a.insert(6).second);
+   EXPECT_FALSE(a.insert(4).second);
+   EXPECT_EQ(*a.insert(0).first, 0);
+
+   EXPECT_EQ(a, flat_set_t({ 0, 2, 4, 6, 8 }));
+
+   // Range insertion merges and removes duplicates.
+   std::vector<int> more = { 9, 1, 4, 9, 3 };
+   a.insert(more.begin(), more.end());
+   EXPECT_EQ(a, flat_set_t({ 0, 1, 2, 3, 4, 6, 8, 9 }));
+
+   // Insertion through std::inserter.
+   std::vector<int> other = { 5, 7 };
+   std::copy(other.begin(), other.end(), std::inserter(a, a.end()));
+   EXPECT_EQ(a.size(), 10);
+
+   EXPECT_EQ(a.erase(3), 1);
+   EXPECT_EQ(a.erase(3), 0);
+   a.erase(a.begin());
+   EXPECT_EQ(a, flat_set_t({ 1, 2, 4, 5, 6, 7, 8, 9 }));
+
+   a.clear();
+   EXPECT_TRUE(a.empty());
+
+} // TEST
+
+// =============================================================================
+// Test flecsi::utils::flat_set__ lookup
+// =============================================================================
+
+// TEST
+TEST(flat_set, lookup)
+{
+   flat_set_t a = { 10, 20, 30, 40 };
+
+   EXPECT_EQ(a.count(20), 1);
+   EXPECT_EQ(a.count(25), 0);
+   EXPECT_TRUE(a.find(25) == a.end());
+   EXPECT_EQ(*a.find(30), 30);
+
+   EXPECT_EQ(*a.lower_bound(25), 30);
+   EXPECT_EQ(*a.upper_bound(30), 40);
+
+   EXPECT_EQ(a.offset(10), 0);
+   EXPECT_EQ(a.offset(40), 3);
+   EXPECT_EQ(a.offset(45), a.size());
+   EXPECT_EQ(a[2], 30);
+
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -0,0 +1,125 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <vector>
+
+#include <flecsi.h>
+
+#include "flecsi/runtime/types.h"
+#include "flecsi/utils/tree_hash.h"
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_legion
+  #include "flecsi/data/legion/dense.h"
+#elif FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+  #include "flecsi/data/mpi/dense.h"
+#elif FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_serial
+  #include "flecsi/data/serial/dense.h"
+#endif
+
+using flecsi::utils::tree_hash_t;
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_legion
+using handle_t = flecsi::data::legion::dense_handle_t<double, 0, 0, 0>;
+#elif FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+using handle_t = flecsi::data::mpi::dense_handle_t<double, 0, 0, 0>;
+#elif FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_serial
+using handle_t = flecsi::data::serial::dense_handle_t<double, 0, 0, 0>;
+#endif
+
+namespace {
+
+std::vector<double> make_data(size_t n) {
+  std::vector<double> data(n);
+  for(size_t i(0); i<n; ++i) {
+    data[i] = 0.5 * double(i) - 1.0;
+  } // for
+  return data;
+} // make_data
+
+uint64_t hash_all(const std::vector<double> & data, size_t threads) {
+  tree_hash_t hash(threads);
+  hash.update(data.data(), data.size());
+  return hash.digest();
+} // hash_all
+
+} // namespace
+
+TEST(tree_hash, segments) {
+  // Span several chunks with a partial last chunk.
+  auto data = make_data(3 * tree_hash_t::chunk_bytes / sizeof(double) + 77);
+  const uint64_t reference = hash_all(data, 1);
+
+  for(size_t split : {size_t(0), size_t(1), size_t(1000), size_t(8192),
+    data.size() - 3, data.size()}) {
+    tree_hash_t hash;
+    hash.update(data.data(), split);
+    hash.update(data.data() + split, data.size() - split);
+    ASSERT_EQ(hash.digest(), reference);
+  } // for
+
+  // Many small segments.
+  tree_hash_t hash;
+  for(size_t i(0); i<data.size(); i += 13) {
+    hash.update(data.data() + i, std::min(size_t(13), data.size() - i));
+  } // for
+  ASSERT_EQ(hash.digest(), reference);
+} // TEST
+
+TEST(tree_hash, threads) {
+  auto data = make_data(17 * tree_hash_t::chunk_bytes / sizeof(double) + 5);
+  const uint64_t reference = hash_all(data, 1);
+
+  for(size_t threads : {2, 3, 8, 64}) {
+    ASSERT_EQ(hash_all(data, threads), reference);
+  } // for
+} // TEST
+
+TEST(tree_hash, sensitivity) {
+  auto data = make_data(2 * tree_hash_t::chunk_bytes / sizeof(double));
+  const uint64_t reference = hash_all(data, 1);
+
+  // A single flipped bit anywhere changes the digest.
+  for(size_t i : {size_t(0), data.size() / 2, data.size() - 1}) {
+    auto copy = data;
+    reinterpret_cast<unsigned char *>(&copy[i])[3] ^= 0x10;
+    ASSERT_NE(hash_all(copy, 1), reference);
+  } // for
+
+  // So does the length, even for zero bytes.
+  std::vector<double> zeros(10, 0.0);
+  ASSERT_NE(hash_all(zeros, 1),
+    hash_all(std::vector<double>(11, 0.0), 1));
+
+  // Combining is order dependent.
+  ASSERT_NE(tree_hash_t::combine({1, 2, 3}), tree_hash_t::combine({3, 2, 1}));
+} // TEST
+
+TEST(tree_hash, field) {
+  auto data = make_data(1000);
+
+  // The sizes are hidden by the accessor methods of the handle, so the
+  // handle is bound through its base.
+  handle_t h;
+  flecsi::data_handle__<double, 0, 0, 0> & b = h;
+  b.exclusive_data = data.data();
+  b.exclusive_size = 600;
+  b.shared_data = data.data() + 600;
+  b.shared_size = 300;
+  b.ghost_data = data.data() + 900;
+  b.ghost_size = 100;
+
+  tree_hash_t owned;
+  owned.update(data.data(), 900);
+
+  ASSERT_EQ(flecsi::utils::field_checksum(h), owned.digest());
+  ASSERT_EQ(flecsi::utils::field_checksum(h, true), hash_all(data, 1));
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,407 @@
+/*~--------------------------------------------------------------------------~*
+ *  @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+ * /@@/////  /@@          @@////@@ @@////// /@@
+ * /@@       /@@  @@@@@  @@    // /@@       /@@
+ * /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+ * /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+ * /@@       /@@/@@//// //@@    @@       /@@/@@
+ * /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+ * //       ///  //////   //////  ////////  //
+ *
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_utils_tree_hash_h
+#define flecsi_utils_tree_hash_h
+
+//!
+//! \file
+//! \brief Fast, parallel, streaming checksums of field data.
+//!
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(ENABLE_MPI)
+  #include <mpi.h>
+#endif
+
+#include "flecsi/concurrency/parallel_for.h"
+
+namespace flecsi {
+namespace utils {
+
+namespace tree_hash_detail {
+
+constexpr uint64_t prime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t prime3 = 0x165667b19e3779f9ULL;
+constexpr uint64_t prime4 = 0x85ebca77c2b2ae63ULL;
+constexpr uint64_t prime5 = 0x27d4eb2f165667c5ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline
+uint64_t
+read64(
+  const unsigned char * p
+)
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+} // read64
+
+inline
+uint64_t
+round(
+  uint64_t acc,
+  uint64_t input
+)
+{
+  acc += input * prime2;
+  return rotl(acc, 31) * prime1;
+} // round
+
+inline
+uint64_t
+avalanche(
+  uint64_t h
+)
+{
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+} // avalanche
+
+//!
+//! \brief Non-cryptographic 64-bit hash of a byte range, in the style of
+//!        xxHash64: four independent multiply-rotate lanes for throughput,
+//!        followed by a tail and an avalanche step.
+//!
+inline
+uint64_t
+hash64(
+  const unsigned char * p,
+  size_t bytes,
+  uint64_t seed
+)
+{
+  const unsigned char * end = p + bytes;
+  uint64_t h;
+
+  if(bytes >= 32) {
+    uint64_t v1 = seed + prime1 + prime2;
+    uint64_t v2 = seed + prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - prime1;
+
+    for(; p + 32 <= end; p += 32) {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+    } // for
+
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+
+    for(uint64_t v : {v1, v2, v3, v4}) {
+      h ^= round(0, v);
+      h = h * prime1 + prime4;
+    } // for
+  }
+  else {
+    h = seed + prime5;
+  } // if
+
+  h += bytes;
+
+  for(; p + 8 <= end; p += 8) {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * prime1 + prime4;
+  } // for
+
+  for(; p < end; ++p) {
+    h ^= (*p) * prime5;
+    h = rotl(h, 11) * prime1;
+  } // for
+
+  return avalanche(h);
+} // hash64
+
+//!
+//! \brief Combine two child hashes into their parent.
+//!
+inline
+uint64_t
+combine(
+  uint64_t left,
+  uint64_t right
+)
+{
+  return avalanche(round(left ^ prime3, right) + prime4);
+} // combine
+
+//!
+//! \brief Reduce a list of hashes with a balanced binary tree. The shape of
+//!        the tree only depends on the number of hashes.
+//!
+inline
+uint64_t
+reduce(
+  std::vector<uint64_t> level
+)
+{
+  if(level.empty()) {
+    return prime5;
+  } // if
+
+  while(level.size() > 1) {
+    size_t n = 0;
+
+    for(size_t i = 0; i + 1 < level.size(); i += 2) {
+      level[n++] = combine(level[i], level[i + 1]);
+    } // for
+
+    if(level.size() % 2) {
+      level[n++] = level.back();
+    } // if
+
+    level.resize(n);
+  } // while
+
+  return level[0];
+} // reduce
+
+} // namespace tree_hash_detail
+
+//!
+//! \brief tree_hash_t computes a fast, non-cryptographic checksum of a byte
+//!        stream that can be fed in several segments, e.g., the exclusive,
+//!        shared and ghost parts of a field, without copying them into one
+//!        buffer.
+//!
+//! The stream is cut into fixed-size chunks at absolute stream offsets,
+//! each chunk is hashed independently, and the chunk hashes are reduced
+//! with a balanced binary tree. The digest therefore only depends on the
+//! bytes of the stream, not on how it was segmented or on the number of
+//! threads used to hash it.
+//!
+class tree_hash_t
+{
+public:
+
+  //! Chunk size in bytes.
+  static constexpr size_t chunk_bytes = size_t(1) << 16;
+
+  //!
+  //! \param num_threads The number of tasks used to hash full chunks.
+  //!                    They run on the shared parallel_for_pool().
+  //!
+  tree_hash_t(
+    size_t num_threads = 1
+  )
+  : num_threads_(num_threads ? num_threads : 1)
+  {
+    pending_.reserve(chunk_bytes);
+  } // tree_hash_t
+
+  //!
+  //! \brief Append a segment to the stream.
+  //!
+  //! \param data  The segment data.
+  //! \param bytes The size of the segment in bytes.
+  //!
+  void
+  update(
+    const void * data,
+    size_t bytes
+  )
+  {
+    auto p = static_cast<const unsigned char *>(data);
+
+    bytes_ += bytes;
+
+    // Complete a chunk that was started by a previous segment.
+    if(!pending_.empty()) {
+      const size_t n = std::min(bytes, chunk_bytes - pending_.size());
+      pending_.insert(pending_.end(), p, p + n);
+      p += n;
+      bytes -= n;
+
+      if(pending_.size() < chunk_bytes) {
+        return;
+      } // if
+
+      add_chunks(pending_.data(), 1);
+      pending_.clear();
+    } // if
+
+    const size_t chunks = bytes / chunk_bytes;
+    add_chunks(p, chunks);
+    p += chunks * chunk_bytes;
+
+    pending_.assign(p, p + (bytes - chunks * chunk_bytes));
+  } // update
+
+  //!
+  //! \brief Append an array of values to the stream.
+  //!
+  template<typename T>
+  void
+  update(
+    const T * data,
+    size_t elements
+  )
+  {
+    update(static_cast<const void *>(data), elements * sizeof(T));
+  } // update
+
+  //!
+  //! \brief Return the digest of everything appended so far. The stream can
+  //!        be extended after this call.
+  //!
+  uint64_t
+  digest()
+  const
+  {
+    std::vector<uint64_t> leaves(leaves_);
+
+    if(!pending_.empty()) {
+      leaves.push_back(tree_hash_detail::hash64(pending_.data(),
+        pending_.size(), leaves.size()));
+    } // if
+
+    return tree_hash_detail::combine(tree_hash_detail::reduce(leaves),
+      bytes_);
+  } // digest
+
+  //!
+  //! \brief Combine the digests of several ranks or fields. The result
+  //!        depends on their order, which must therefore be deterministic,
+  //!        e.g., rank order.
+  //!
+  static
+  uint64_t
+  combine(
+    const std::vector<uint64_t> & digests
+  )
+  {
+    return tree_hash_detail::reduce(digests);
+  } // combine
+
+private:
+
+  void
+  add_chunks(
+    const unsigned char * p,
+    size_t chunks
+  )
+  {
+    const size_t first = leaves_.size();
+    leaves_.resize(first + chunks);
+
+    auto work = [&](size_t begin, size_t end) {
+      for(size_t c = begin; c < end; ++c) {
+        leaves_[first + c] = tree_hash_detail::hash64(p + c * chunk_bytes,
+          chunk_bytes, first + c);
+      } // for
+    };
+
+    const size_t threads = std::min(num_threads_, chunks);
+
+    if(threads < 2) {
+      work(0, chunks);
+      return;
+    } // if
+
+    task_group group(parallel_for_pool());
+
+    for(size_t t = 1; t < threads; ++t) {
+      group.run([&work, begin = chunks * t / threads,
+        end = chunks * (t + 1) / threads]() { work(begin, end); });
+    } // for
+
+    work(0, chunks / threads);
+
+    group.wait();
+  } // add_chunks
+
+  size_t num_threads_;
+  size_t bytes_ = 0;
+  std::vector<uint64_t> leaves_;
+  std::vector<unsigned char> pending_;
+
+}; // class tree_hash_t
+
+//!
+//! \brief Checksum the owned (exclusive and shared) entries of a field
+//!        through its data handle, and optionally its ghosts, streaming
+//!        over the segments in place.
+//!
+//! \param handle        A data handle with exclusive, shared and ghost
+//!                      segments.
+//! \param include_ghost Also hash the ghost segment.
+//! \param num_threads   The number of tasks used for hashing.
+//!
+template<typename HANDLE>
+uint64_t
+field_checksum(
+  const HANDLE & handle,
+  bool include_ghost = false,
+  size_t num_threads = 1
+)
+{
+  tree_hash_t hash(num_threads);
+
+  hash.update(handle.exclusive_data, handle.exclusive_size());
+  hash.update(handle.shared_data, handle.shared_size());
+
+  if(include_ghost) {
+    hash.update(handle.ghost_data, handle.ghost_size());
+  } // if
+
+  return hash.digest();
+} // field_checksum
+
+#if defined(ENABLE_MPI)
+
+//!
+//! \brief Combine per-rank digests in rank order so that every rank gets
+//!        the same global checksum.
+//!
+inline
+uint64_t
+global_checksum(
+  uint64_t local,
+  MPI_Comm comm = MPI_COMM_WORLD
+)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<uint64_t> digests(size);
+  unsigned long long value = local;
+  MPI_Allgather(&value, 1, MPI_UNSIGNED_LONG_LONG, digests.data(), 1,
+    MPI_UNSIGNED_LONG_LONG, comm);
+
+  return tree_hash_t::combine(digests);
+} // global_checksum
+
+#endif // ENABLE_MPI
+
+} // namespace utils
+} // namespace flecsi
+
+#endif // flecsi_utils_tree_hash_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/